@@ -0,0 +1,51 @@
+#!/usr/bin/python
+# -*- coding: utf-8 -*-
+"""
+Compare electrode hits from full and fast charge transport, written by
+fast_validation.mac.  Reports the number of collected carriers and the
+mean and RMS of drift time and lateral displacement, for each carrier.
+
+Usage:  python compare_fast.py full_transport.txt fast_transport.txt
+"""
+import sys
+import csv
+import math
+
+if len(sys.argv) < 3:
+    print("Usage: %s full_hits.txt fast_hits.txt" % sys.argv[0])
+    exit(1)
+
+def moments(values):
+    n = len(values)
+    if n == 0:
+        return 0.0, 0.0
+    mean = sum(values)/n
+    return mean, math.sqrt(sum((v-mean)**2 for v in values)/n)
+
+def summarize(filename):
+    """Drift times [ns] and lateral displacements [mm] by particle"""
+    times = {}
+    shifts = {}
+    with open(filename) as text:
+        for line in csv.DictReader(text):
+            name = line["Particle Name"]
+            dt = float(line["Final Time [ns]"]) - float(line["Start Time [ns]"])
+            dx = float(line["End X [m]"]) - float(line["Start X [m]"])
+            dy = float(line["End Y [m]"]) - float(line["Start Y [m]"])
+            times.setdefault(name, []).append(dt)
+            shifts.setdefault(name, []).append(math.hypot(dx, dy)*1e3)
+    return times, shifts
+
+full = summarize(sys.argv[1])
+fast = summarize(sys.argv[2])
+
+print("%-20s %6s %21s %21s" % ("", "hits", "time [ns] mean/rms",
+                               "lateral [mm] mean/rms"))
+for name in sorted(set(full[0]) | set(fast[0])):
+    for label, (times, shifts) in (("full", full), ("fast", fast)):
+        t = times.get(name, [])
+        s = shifts.get(name, [])
+        print("%-14s %-5s %6d %10.2f %10.2f %10.3f %10.3f" %
+              ((name, label, len(t)) + moments(t) + moments(s)))
+
+exit(0)
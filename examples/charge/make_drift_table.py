@@ -0,0 +1,69 @@
+#!/usr/bin/python
+# -*- coding: utf-8 -*-
+"""
+Build a G4CMPDriftTable file (lattice keyword "driftTable") from the
+hits files written by drift_curve.mac.  For each voltage, the mean drift
+speed and the longitudinal diffusion coefficient, D = v^2 var(t) / (2 <t>),
+are computed for electrons and holes from their arrival times.
+
+Usage:  G4CMP_HIT_SUFFIX=<suffix> python make_drift_table.py [output]
+"""
+import os
+import sys
+import glob
+import csv
+
+try:
+    suffix = os.environ['G4CMP_HIT_SUFFIX']
+except KeyError:
+        print("Need to set G4CMP_HIT_SUFFIX env variable to match "
+              "the drift_curve macro")
+        exit(1)
+
+outname = sys.argv[1] if len(sys.argv) > 1 else 'DriftTable.txt'
+
+# iZip is 2.54 cm thick and each track begins in the middle of the zip:
+dx = 1.27  # cm
+
+def speed_and_diffusion(times):
+    """Mean speed [km/s] and diffusion [cm2/s] from drift times [s]"""
+    n = len(times)
+    if n < 2:
+        return 0.0, 0.0
+    mean = sum(times)/n
+    var = sum((t-mean)**2 for t in times)/(n-1)
+    speed = dx/mean                     # cm/s
+    return speed/1e5, speed*speed*var/(2.0*mean)
+
+rows = []
+tail = ''.join(('v-', suffix, '.txt'))
+for file in glob.glob(''.join(('epos_*', suffix, '.txt'))):
+    field = float(file[5:file.find(tail)])/(2.0*dx)  # convert to volt/cm
+
+    t_e = []
+    t_h = []
+    with open(file) as text:
+        reader = csv.DictReader(text)
+        for line in reader:
+            dt = (float(line["Final Time [ns]"]) -
+                  float(line["Start Time [ns]"])) * 1e-9
+            if line["Particle Name"] == "G4CMPDriftHole":
+                t_h.append(dt)
+            elif line["Particle Name"] == "G4CMPDriftElectron":
+                t_e.append(dt)
+
+    if len(t_e) < 2 or len(t_h) < 2:
+        print("Skipping %s: too few carriers collected" % file)
+        continue
+
+    rows.append((field,) + speed_and_diffusion(t_e) + speed_and_diffusion(t_h))
+
+rows.sort()
+with open(outname, 'w') as out:
+    out.write("# Drift table from drift_curve.mac, suffix %s\n" % suffix)
+    out.write("# field[V/cm] vE[km/s] DE[cm2/s] vH[km/s] DH[cm2/s]\n")
+    for row in rows:
+        out.write("%g %g %g %g %g\n" % row)
+
+print("Wrote %d points to %s" % (len(rows), outname))
+exit(0)
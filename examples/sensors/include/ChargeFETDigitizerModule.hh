@@ -8,6 +8,8 @@
 
 #include "G4VDigitizerModule.hh"
 #include <fstream>
+#include <utility>
+#include <vector>
 
 class ChargeFETDigitizerMessenger;
 class G4CMPMeshElectricField;
@@ -65,6 +67,10 @@ class ChargeFETDigitizerModule : public G4VDigitizerModule
     void BuildFETTemplates();
     vector<vector<G4double> > CalculateTraces(const vector<G4double>& scaleFactors);
     void BuildRamoFields();
+    // Subtract charge-weighted Ramo potentials at hit positions (3 per hit)
+    void AccumulateRamo(const vector<G4double>& positions,
+                        const vector<G4double>& charges,
+                        vector<G4double>& scaleFactors) const;
     void WriteFETTraces(const vector<vector<G4double> >& FETTraces,
                         G4int RunID, G4int EventID);
 
@@ -91,7 +97,10 @@ class ChargeFETDigitizerModule : public G4VDigitizerModule
     G4String ramoFileDir;
     // FETSim Quantities
     vector<vector<vector<G4double> > > FETTemplates; //4x4x4096 = 4 channels w/ cross-talk terms
+    // Channels whose Ramo files share a mesh are loaded into one field
     vector<G4CMPMeshElectricField> RamoFields;
+    vector<std::pair<size_t,G4int> > RamoIndex; // (field, potential) per channel
+    mutable vector<G4double> ramoBuffer;        // Potentials from one batch
 };
 
 #endif // CHARGEFETDIGITIZERMODULE_HH
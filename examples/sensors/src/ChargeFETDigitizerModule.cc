@@ -14,7 +14,9 @@
 #include "G4SDManager.hh"
 #include "G4Run.hh"
 #include "G4Event.hh"
+#include <array>
 #include <sstream>
+#include <vector>
 
 ChargeFETDigitizerModule::ChargeFETDigitizerModule(G4String modName) :
   G4VDigitizerModule(modName), messenger(new ChargeFETDigitizerMessenger(this)),
@@ -74,24 +76,30 @@ void ChargeFETDigitizerModule::Digitize()
   vector<G4CMPElectrodeHit*>* hitVec = hitCol->GetVector();
 
   vector<G4double> scaleFactors(numChannels,0);
-  G4double position[4] = {0.,0.,0.,0.};
+  vector<G4double> positions;
+  vector<G4double> charges;
+  positions.reserve(3*hitVec->size());
+  charges.reserve(hitVec->size());
   G4ThreeVector vecPosition;
-  for(size_t chan = 0; chan < numChannels; ++chan) {
-    for(size_t hitIdx=0; hitIdx < hitVec->size(); ++hitIdx) {
-      if(hitVec->at(hitIdx)->GetParticleName()=="G4CMPDriftElectron" ||
-         hitVec->at(hitIdx)->GetParticleName()=="G4CMPDriftHole") {
-        vecPosition = hitVec->at(hitIdx)->GetFinalPosition();
-        position[0] = vecPosition.getX();
-        position[1] = vecPosition.getY();
-        position[2] = vecPosition.getZ();
-        if(hitVec->at(hitIdx)->GetParticleName()=="G4CMPDriftElectron")
-          scaleFactors[chan] -= -1 * RamoFields[chan].GetPotential(position);
-        else
-          scaleFactors[chan] -= 1 * RamoFields[chan].GetPotential(position);
-      }
-    }
+  G4double charge;
+  for(size_t hitIdx=0; hitIdx < hitVec->size(); ++hitIdx) {
+    if(hitVec->at(hitIdx)->GetParticleName()=="G4CMPDriftElectron")
+      charge = -1;
+    else if(hitVec->at(hitIdx)->GetParticleName()=="G4CMPDriftHole")
+      charge = 1;
+    else
+      continue;
+
+    vecPosition = hitVec->at(hitIdx)->GetFinalPosition();
+    positions.push_back(vecPosition.getX());
+    positions.push_back(vecPosition.getY());
+    positions.push_back(vecPosition.getZ());
+    charges.push_back(charge);
   }
 
+  // All hits and channels are evaluated together, one batch per mesh
+  AccumulateRamo(positions, charges, scaleFactors);
+
   vector<vector<G4double> > FETTraces(CalculateTraces(scaleFactors));
   G4int runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
   G4int eventID = G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID();
@@ -113,6 +121,8 @@ void ChargeFETDigitizerModule::PostProcess(const G4String& fileName)
   G4double charge;
   G4int RunID, EventID;
   vector<G4double> scaleFactors(numChannels,0);
+  vector<G4double> positions;
+  vector<G4double> charges;
 
   G4String line;
   G4String entry;
@@ -153,11 +163,12 @@ void ChargeFETDigitizerModule::PostProcess(const G4String& fileName)
     } else {
       continue;
     }
-    for(size_t chan = 0; chan < numChannels; ++chan) {
-      scaleFactors[chan] -= charge*RamoFields[chan].GetPotential(position);
-    }
+    positions.insert(positions.end(), position, position+3);
+    charges.push_back(charge);
   }
 
+  AccumulateRamo(positions, charges, scaleFactors);
+
   vector<vector<G4double> > FETTraces(CalculateTraces(scaleFactors));
   WriteFETTraces(FETTraces, RunID, EventID);
 }
@@ -276,6 +287,8 @@ void ChargeFETDigitizerModule::BuildFETTemplates()
 void ChargeFETDigitizerModule::BuildRamoFields()
 {
   if (RamoFields.size()) RamoFields.clear();
+  // Channels with missing files match no field, and get zero potential
+  RamoIndex.assign(numChannels, std::make_pair(size_t(-1), 0));
 
   for(size_t i=0; i < numChannels; ++i) {
     std::stringstream name;
@@ -283,7 +296,23 @@ void ChargeFETDigitizerModule::BuildRamoFields()
     std::ifstream ramoFile(name.str().c_str());
     if(ramoFile.good()) {
       ramoFile.close();
-      RamoFields.emplace_back(name.str());
+      // Reuse triangulation from any earlier channel with the same mesh;
+      // file is read once, and probing fields issues no warnings
+      std::vector<std::array<G4double,3> > X;
+      std::vector<G4double> V;
+      G4CMPMeshElectricField::ReadPotential(name.str(), 1., X, V);
+
+      size_t iField = 0;
+      while (iField < RamoFields.size() &&
+             !RamoFields[iField].SameMeshPoints(X)) ++iField;
+
+      if (iField < RamoFields.size()) {
+        RamoIndex[i] = std::make_pair(iField,
+                                      RamoFields[iField].AddPotential(X, V));
+      } else {
+        RamoFields.emplace_back(name.str());
+        RamoIndex[i] = std::make_pair(RamoFields.size()-1, 0);
+      }
     } else {
       ramoFile.close();
       G4cerr << "ChargeFETDigitizerModule::BuildRamoFields(): ERROR: Could"
@@ -293,6 +322,28 @@ void ChargeFETDigitizerModule::BuildRamoFields()
   rebuildRamoFields = false;
 }
 
+void ChargeFETDigitizerModule::AccumulateRamo(
+  const vector<G4double>& positions, const vector<G4double>& charges,
+  vector<G4double>& scaleFactors) const
+{
+  const size_t numHits = charges.size();
+  if (numHits == 0) return;
+
+  for (size_t iField=0; iField < RamoFields.size(); ++iField) {
+    const size_t numPot = RamoFields[iField].GetNumberOfPotentials();
+    ramoBuffer.resize(numHits*numPot);
+    RamoFields[iField].EvaluateBatch(numHits, positions.data(), nullptr,
+                                     ramoBuffer.data());
+
+    for (size_t chan=0; chan < RamoIndex.size(); ++chan) {
+      if (RamoIndex[chan].first != iField) continue;
+      for (size_t hit=0; hit < numHits; ++hit)
+        scaleFactors[chan] -=
+          charges[hit] * ramoBuffer[hit*numPot + RamoIndex[chan].second];
+    }
+  }
+}
+
 void ChargeFETDigitizerModule::WriteFETTraces(
   const vector<vector<G4double> >& traces, G4int RunID, G4int EventID)
 {
@@ -0,0 +1,63 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+#ifndef G4CMPAlignedAllocator_hh
+#define G4CMPAlignedAllocator_hh 1
+
+// $Id$
+// File: G4CMPAlignedAllocator.hh
+//
+// Description: Minimal STL allocator returning storage aligned to a fixed
+//	boundary (default 64 bytes, one cache line).  Before C++17, standard
+//	containers ignore alignas() on their element type; this allocator is
+//	used by the mesh interpolators to keep per-tetrahedron records packed
+//	onto cache lines.
+//
+// 20261016  Allocator for cache-line aligned mesh interpolator tables.
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+
+template <typename T, std::size_t Align=64>
+class G4CMPAlignedAllocator {
+public:
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = G4CMPAlignedAllocator<U,Align>;
+  };
+
+  G4CMPAlignedAllocator() = default;
+
+  template <typename U>
+  G4CMPAlignedAllocator(const G4CMPAlignedAllocator<U,Align>&) {;}
+
+  // Over-allocate, and store true start of block just before aligned data
+  T* allocate(std::size_t n) {
+    char* raw = static_cast<char*>(::operator new(n*sizeof(T) + Align
+						  + sizeof(void*)));
+    std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw+sizeof(void*));
+    std::uintptr_t aligned = (start + Align-1) & ~std::uintptr_t(Align-1);
+
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<T*>(aligned);
+  }
+
+  void deallocate(T* p, std::size_t) {
+    if (p) ::operator delete(reinterpret_cast<void**>(p)[-1]);
+  }
+};
+
+template <typename T, typename U, std::size_t Align>
+inline bool operator==(const G4CMPAlignedAllocator<T,Align>&,
+		       const G4CMPAlignedAllocator<U,Align>&) { return true; }
+
+template <typename T, typename U, std::size_t Align>
+inline bool operator!=(const G4CMPAlignedAllocator<T,Align>&,
+		       const G4CMPAlignedAllocator<U,Align>&) { return false; }
+
+#endif	/* G4CMPAlignedAllocator_hh */
@@ -1,12 +1,15 @@
 /* Header File for AnharmonicDecay utility class */
 
 // 20221103  Drop G4CMP_DEBUG protection here, to avoid client rebuilding
+// 20261016  Apply phonon weight window to daughters; report decay success.
+// 20261016  Record weighted roulette energy change for debugging check.
 
 #ifndef G4CMPAnharmonicDecay_h
 #define G4CMPAnharmonicDecay_h
 
 #include "G4CMPProcessUtils.hh"
 #include <iosfwd>
+#include <vector>
 
 class G4ParticleChange;
 class G4Step;
@@ -30,14 +33,21 @@ private:
   G4double MakeTTDeviation(G4double, G4double) const;
   G4double MakeTDeviation(G4double, G4double) const;
 
-  void MakeTTSecondaries(const G4Track&, G4ParticleChange&);
-  void MakeLTSecondaries(const G4Track&, G4ParticleChange&);
+  // Return false if daughters could not be created
+  G4bool MakeTTSecondaries(const G4Track&, G4ParticleChange&);
+  G4bool MakeLTSecondaries(const G4Track&, G4ParticleChange&);
+
+  // Add daughters to ParticleChange, with splitting or roulette if enabled
+  void AddSecondaries(const G4Track&, G4Track* sec1, G4Track* sec2,
+		      G4ParticleChange&);
 
   G4int verboseLevel;			// For diagnostic output
   G4String procName;			// Process name for diagnostics
 
   G4double fBeta, fGamma, fLambda, fMu; // Local buffers for decay parameters
   G4double fvLvT; 			// Ratio of sound speeds
+  std::vector<G4Track*> windowTracks;	// Buffer for weight-window output
+  G4double rouletteEnergy;		// Weighted energy change from roulette
 
   std::ofstream output;			// Only used for G4CMP_DEBUG debugging
 };
@@ -14,14 +14,24 @@
 // 20200908  Replace four-arg ctor and UseMesh() with copy constructor.
 // 20200914  Include gradient precalculation in BuildTInverse action.
 // 20240921  Move FirstInteriorTetra() virtual for use with Initialize()
+// 20261016  Move mesh tables to shared, read-only block; Clone() no longer
+//		duplicates tables for each worker thread.
+// 20261016  Add uniform grid index to seed FindTetrahedron() searches.
+// 20261016  Pack per-triangle search data into aligned TetraRecord, drop
+//		TExtend table; renumber triangles along Z-order curve.
+// 20261016  Add GetValues(), GetGradValues() for multiple value sets.
+// 20261016  Add EvaluateBatch() for arrays of points.
+// 20261016  Drop Tetra01..Tetra12 tables, FindNeighbor(), FindTetraID().
 
 #ifndef G4CMPBiLinearInterp_h 
 #define G4CMPBiLinearInterp_h 
 
 #include "G4CMPVMeshInterpolator.hh"
+#include "G4CMPAlignedAllocator.hh"
 #include "G4ThreeVector.hh"
 #include <vector>
 #include <map>
+#include <memory>
 #include <array>
 
 // Convenient abbreviations, available to subclasses and client code
@@ -62,6 +72,16 @@ public:
   G4double GetValue(const G4double pos[], G4bool quiet=false) const;
   G4ThreeVector GetGrad(const G4double pos[], G4bool quiet=false) const;
 
+  // Evaluate all value sets (see AddValues()) with one search
+  void GetValues(const G4double pos[], G4double values[],
+		 G4bool quiet=false) const;
+  G4ThreeVector GetGradValues(const G4double pos[], G4double values[],
+			      G4bool quiet=false) const;
+
+  // Evaluate array of points, see G4CMPVMeshInterpolator for layout
+  void EvaluateBatch(size_t npts, const G4double pos[], G4double values[],
+		     G4ThreeVector grads[], G4bool quiet=false) const;
+
   void SavePoints(const G4String& fname) const;
   void SaveTetra(const G4String& fname) const;
 
@@ -72,36 +92,58 @@ protected:
   virtual G4int FirstInteriorTetra() const;
 
 private:
-  std::vector<point2d> X;
-  std::vector<tetra2d> Tetrahedra;	// For 2D, these are triangles!
-  std::vector<tetra2d> Neighbors;
-  std::vector<mat2x2> TInverse;		// Matrix for barycenter calculation
-  std::vector<mat3x2> TExtend;		// Matrix for gradient calculation
-  std::vector<G4bool> TInvGood;		// Flags for noninvertible matrix
-
-  std::vector<tetra2d> Tetra01;		// Duplicate tetrahedra lists
-  std::vector<tetra2d> Tetra02;		// Sorted on vertex triplets
-  std::vector<tetra2d> Tetra12;
-
-  void FillNeighbors();		// Generate Neighbors table from tetrahedra
-  void FillTInverse();		// Compute inverse matrices for Cart2Bary()
-
-  void Compress3DPoints(const std::vector<point3d>& xyz);
-  void Compress3DTetras(const std::vector<tetra3d>& tetra);
-
-  // Function pointer for comparison operator to use search for facets
-  using TetraComp = G4bool(*)(const tetra2d&, const tetra2d&);
-
-  G4int FindNeighbor(const std::array<G4int,2>& edge, G4int skip) const;
-  G4int FindTetraID(const std::vector<tetra2d>& tetras,
-		    const tetra2d& wildTetra, G4int skip,
-		    TetraComp tLess) const;
+  // Everything needed for one step of FindTetrahedron(), packed together
+  // to fill exactly one cache line per triangle
+  struct alignas(64) TetraRecord {
+    mat2x2 invT;			// Matrix for barycenter calculation
+    point2d X2;				// Reference vertex (tetra[2]) for invT
+    tetra2d neighbors;			// Triangles opposite each vertex
+    G4bool good;			// Flag for noninvertible matrix
+  };
+
+  using RecordTable = std::vector<TetraRecord,
+				  G4CMPAlignedAllocator<TetraRecord> >;
+
+  // Mesh coordinates and derived tables are filled once, then shared
+  // read-only by all clones (e.g., per-thread copies of field).
+  struct MeshTables {
+    std::vector<point2d> X;
+    std::vector<tetra2d> Tetrahedra;	// For 2D, these are triangles!
+    RecordTable Records;		// Search data for each triangle
+
+    // Uniform grid over mesh bounding box, used to seed triangle search
+    point2d GridMin{{0.,0.}};		// Lower corner of grid
+    point2d GridStep{{1.,1.}};		// Cell dimensions
+    std::array<G4int,2> GridN{{0,0}};	// Number of cells along each axis
+    std::vector<G4int> GridSeed;	// Triangle in cell, -1 if outside
+  };
+
+  std::shared_ptr<const MeshTables> Mesh;
+
+  // Table construction, operating on new (not yet shared) mesh block
+  // Neighbors table is only used during construction, then in Records
+  void FillNeighbors(MeshTables& mesh,		// Generate Neighbors table
+		     std::vector<tetra2d>& neighbors) const;
+  void SortTetrahedra(MeshTables& mesh,		// Put neighbors close together
+		      std::vector<tetra2d>& neighbors) const;
+  void FillRecords(MeshTables& mesh,		// Inverse matrices for Cart2Bary
+		   const std::vector<tetra2d>& neighbors) const;
+  void FillSeedGrid(MeshTables& mesh) const;	// Spatial index for searches
+
+  void Compress3DPoints(MeshTables& mesh,
+			const std::vector<point3d>& xyz) const;
+  void Compress3DTetras(MeshTables& mesh,
+			const std::vector<tetra3d>& tetra) const;
 
   void FindTetrahedron(const G4double point[2], G4double bary[3],
 		       G4bool quiet=false) const;
+  G4int FindSeedTetra(const G4double point[2]) const;	// -1 if outside hull
+
+  // Interpolate all value sets in current TetraIdx(), or zero if none
+  void FillValues(const G4double bary[3], G4double values[]) const;
 
   G4bool Cart2Bary(const G4double point[2], G4double bary[3]) const;
-  G4bool BuildT3x2(size_t itet, mat3x2& ET) const;
+  void BuildT3x2(const mat2x2& invT, mat3x2& ET) const;
 
   G4bool MatInv(const mat2x2& matrix, mat2x2& result, G4bool quiet=false) const;
   G4double BaryNorm(G4double bary[3]) const;
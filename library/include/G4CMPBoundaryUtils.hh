@@ -20,17 +20,18 @@
 // 20171215  Change 'CheckStepStatus()' to 'IsBoundaryStep()', add function
 //	     to validate step trajectory to boundary.
 // 20250927  Add overloadable function to kill track when max-reflections.
+// 20261016  Use flat BoundaryParams record from surface instead of matTable.
 
 #ifndef G4CMPBoundaryUtils_hh
 #define G4CMPBoundaryUtils_hh 1
 
 #include "globals.hh"
 #include "G4ThreeVector.hh"
+#include "G4CMPSurfaceProperty.hh"
 #include <map>
 #include <utility>
 
 class G4CMPProcessUtils;
-class G4CMPSurfaceProperty;
 class G4CMPVElectrodePattern;
 class G4MaterialPropertiesTable;
 class G4ParticleChange;
@@ -91,7 +92,8 @@ protected:
   G4bool GetBoundingVolumes(const G4Step& aStep);
   G4bool GetSurfaceProperty(const G4Step& aStep);
 
-  // Does const-casting of matTable for access
+  // Does const-casting of matTable for access; NOTE: string lookup is
+  // slow, so use surfParams for standard parameters
   G4double GetMaterialProperty(const G4String& key) const;
 
 private:
@@ -108,6 +110,9 @@ protected:
   G4MaterialPropertiesTable* matTable;	// Phonon- or charge-specific parameters
   G4CMPVElectrodePattern* electrode;	// Patterned electrode for absorption
 
+  // Phonon- or charge-specific parameters, copied from matTable
+  const G4CMPSurfaceProperty::BoundaryParams* surfParams;
+
   // Flag whether a given PV pair has a defined surface property or not
   typedef std::pair<G4VPhysicalVolume*,G4VPhysicalVolume*> BoundaryPV;
   std::map<BoundaryPV, G4bool> hasSurface;
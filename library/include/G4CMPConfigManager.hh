@@ -49,11 +49,20 @@
 // 20250209  G4CMP-457: Add short names for Lindhard empirical ionization model.
 // 20250325  G4CMP-463:  Add parameter for phonon surface step size & limit.
 // 20250502  G4CMP-358: Limit number of steps for charged tracks in E-field.
+// 20261016  Add flag and directory for binary mesh field cache files.
+// 20261016  Add number of threads for building mesh field tables.
+// 20261016  Add step size and tolerance for regular-grid field cache.
+// 20261016  Add tolerance for tabulated scattering rates.
+// 20261016  Add parameters for multi-emission Luke macro-steps.
+// 20261016  Add flag, step length and signal binning for fast charge mode.
+// 20261016  Add importance file for phonon weight windows.
 
 #include "globals.hh"
 #include <iosfwd>
+#include <memory>
 
 class G4CMPConfigMessenger;
+class G4CMPPhononWeightWindow;
 class G4VNIELPartition;
 
 
@@ -78,11 +87,16 @@ public:
   static G4int GetMaxChargeSteps()       { return Instance()->ehMaxSteps; }
   static G4int GetMaxLukePhonons()       { return Instance()->maxLukePhonons; }
   static G4int GetPhononSurfStepLimit()  { return Instance()->pSurfStepLimit; }
+  static G4int GetMeshThreads()          { return Instance()->meshThreads; }
+  static G4int GetLukeMacroSteps()       { return Instance()->lukeMacroSteps; }
+  static G4int GetLukeMacroPhonons()     { return Instance()->lukeMacroPhonons; }
   static G4bool UseKVSolver()            { return Instance()->useKVsolver; }
   static G4bool FanoStatisticsEnabled()  { return Instance()->fanoEnabled; }
   static G4bool KeepKaplanPhonons()      { return Instance()->kaplanKeepPh; }
   static G4bool CreateChargeCloud()      { return Instance()->chargeCloud; }
   static G4bool RecordMinETracks()       { return Instance()->recordMinE; }
+  static G4bool UseMeshCache()           { return Instance()->useMeshCache; }
+  static G4bool UseFastCharges()         { return Instance()->fastCharges; }
   static G4double GetSurfaceClearance()  { return Instance()->clearance; }
   static G4double GetMinStepScale()      { return Instance()->stepScale; }
   static G4double GetMinPhononEnergy()   { return Instance()->EminPhonons; }
@@ -100,6 +114,11 @@ public:
   static G4double GetHATrapIonMFP()      { return Instance()->hATrapIonMFP; }
   static G4double GetTemperature()       { return Instance()->temperature; }
   static G4double GetPhononSurfStepSize()  { return Instance()->pSurfStepSize; }
+  static G4double GetFieldGridStep()     { return Instance()->fieldGridStep; }
+  static G4double GetFieldGridTolerance() { return Instance()->fieldGridTol; }
+  static G4double GetRateTableTolerance() { return Instance()->rateTableTol; }
+  static G4double GetFastChargeStep()    { return Instance()->fastChargeStep; }
+  static G4double GetRamoBinWidth()      { return Instance()->ramoBinWidth; }
   static G4double GetEmpklow()      { return Instance()->Empklow; }
   static G4double GetEmpkhigh()     { return Instance()->Empkhigh; }
   static G4double GetEmpElow()      { return Instance()->EmpElow; }
@@ -111,9 +130,14 @@ public:
   static const G4String& GetLatticeDir() { return Instance()->LatticeDir; }
   static const G4String& GetIVRateModel() { return Instance()->IVRateModel; }
   static const G4String& GetLukeDebugFile() { return Instance()->lukeFilename; }
+  static const G4String& GetMeshCacheDir() { return Instance()->meshCacheDir; }
+  static const G4String& GetPhononWindowFile() { return Instance()->phononWindowFile; }
 
   static const G4VNIELPartition* GetNIELPartition() { return Instance()->nielPartition; }
 
+  // Null unless phonon weight-window file has been loaded
+  static const G4CMPPhononWeightWindow* GetPhononWeightWindow() { return Instance()->phononWindow.get(); }
+
   // Change values (e.g., via Messenger) -- pass strings by value for toLower()
   static void SetVerboseLevel(G4int value) { Instance()->verbose = value; }
   static void SetMaxChargeBounces(G4int value) { Instance()->ehBounces = value; }
@@ -122,6 +146,9 @@ public:
   static void SetPhononSurfStepLimit(G4int value) { Instance()->pSurfStepLimit = value; }
   static void SetMaxChargeSteps(G4int value) { Instance()->ehMaxSteps = value; }
   static void SetMaxLukePhonons(G4int value) { Instance()->maxLukePhonons = value; }
+  static void SetMeshThreads(G4int value) { Instance()->meshThreads = value; }
+  static void SetLukeMacroSteps(G4int value) { Instance()->lukeMacroSteps = value; }
+  static void SetLukeMacroPhonons(G4int value) { Instance()->lukeMacroPhonons = value; }
   static void SetSurfaceClearance(G4double value) { Instance()->clearance = value; }
   static void SetMinStepScale(G4double value) { Instance()->stepScale = value; }
   static void SetMinPhononEnergy(G4double value) { Instance()->EminPhonons = value; }
@@ -137,6 +164,14 @@ public:
   static void KeepKaplanPhonons(G4bool value) { Instance()->kaplanKeepPh = value; }
   static void SetIVRateModel(G4String value) { Instance()->IVRateModel = value; }
   static void CreateChargeCloud(G4bool value) { Instance()->chargeCloud = value; }
+  static void UseMeshCache(G4bool value) { Instance()->useMeshCache = value; }
+  static void SetMeshCacheDir(const G4String& value) { Instance()->meshCacheDir = value; }
+  static void SetFieldGridStep(G4double value) { Instance()->fieldGridStep = value; }
+  static void SetFieldGridTolerance(G4double value) { Instance()->fieldGridTol = value; }
+  static void SetRateTableTolerance(G4double value) { Instance()->rateTableTol = value; }
+  static void UseFastCharges(G4bool value) { Instance()->fastCharges = value; }
+  static void SetFastChargeStep(G4double value) { Instance()->fastChargeStep = value; }
+  static void SetRamoBinWidth(G4double value) { Instance()->ramoBinWidth = value; }
 
   static void SetETrappingMFP(G4double value) { Instance()->eTrapMFP = value; }
   static void SetHTrappingMFP(G4double value) { Instance()->hTrapMFP = value; }
@@ -147,6 +182,7 @@ public:
   static void SetTemperature(G4double value)  { Instance()->temperature = value; }
 
   static void SetLukeDebugFile(const G4String& value) { Instance()->lukeFilename = value; }
+  static void SetPhononWindowFile(const G4String& value) { Instance()->setPhononWindow(value); }
 
   static void SetNIELPartition(const G4String& value) { Instance()->setNIEL(value); }
   static void SetNIELPartition(G4VNIELPartition* niel) { Instance()->setNIEL(niel); }
@@ -185,6 +221,9 @@ private:
   void setNIEL(G4String value);
   void setNIEL(G4VNIELPartition* niel);
 
+  // Load importance tables for phonon weight windows; empty name disables
+  void setPhononWindow(const G4String& filename);
+
 private:
   G4int verbose;	 // Global verbosity (all processes, lattices)
   G4int fPhysicsModelID; // ID key to get aux. track info.
@@ -193,10 +232,15 @@ private:
   G4int ehMaxSteps;      // Maximum steps for charges ($G$CMP_EH_MAX_STEPS)
   G4int maxLukePhonons;  // Approx. Luke phonon limit ($G4MP_MAX_LUKE)
   G4int pSurfStepLimit;  // Phonon surface displacement step limit ($G4CMP_PHON_SURFLIMIT).
+  G4int meshThreads;     // Threads to build mesh tables, 0 for all cores ($G4CMP_MESH_THREADS)
+  G4int lukeMacroSteps;  // Luke emissions per charge step, 0 for single ($G4CMP_LUKE_MACRO_STEPS)
+  G4int lukeMacroPhonons; // Phonon tracks per Luke macro-step ($G4CMP_LUKE_MACRO_PHONONS)
   G4String version;	 // Version name string extracted from .g4cmp-version
   G4String LatticeDir;	 // Lattice data directory ($G4LATTICEDATA)
   G4String IVRateModel;	 // Model for IV rate ($G4CMP_IV_RATE_MODEL)
   G4String lukeFilename; // Filename for LukeScattering debugging output
+  G4String meshCacheDir; // Directory for mesh cache files ($G4CMP_MESH_CACHE_DIR)
+  G4String phononWindowFile; // Importance file for phonon weight windows ($G4CMP_PHONON_WINDOW)
   G4double eTrapMFP;	 // Mean free path for electron trapping
   G4double hTrapMFP;	 // Mean free path for hole trapping
   G4double eDTrapIonMFP; // Mean free path for e- on e-trap ionization ($G4CMP_EETRAPION_MFP)
@@ -214,12 +258,20 @@ private:
   G4double EminPhonons;	 // Minimum energy to track phonons ($G4CMP_EMIN_PHONONS)
   G4double EminCharges;	 // Minimum energy to track e/h ($G4CMP_EMIN_CHARGES)
   G4double pSurfStepSize;  // Phonon surface displacement step size ($G4CMP_PHON_SURFSTEP).
+  G4double fieldGridStep;  // Regular grid spacing for mesh field, 0 to disable ($G4CMP_FIELD_GRID_STEP)
+  G4double fieldGridTol;   // Relative field variation to use mesh in grid cell ($G4CMP_FIELD_GRID_TOL)
+  G4double rateTableTol;   // Accuracy of tabulated rates, 0 to disable ($G4CMP_RATE_TABLE_TOL)
+  G4double fastChargeStep; // Step length for fast charge transport ($G4CMP_FAST_CHARGE_STEP)
+  G4double ramoBinWidth;   // Time bin for induced current, 0 to disable ($G4CMP_RAMO_BIN_WIDTH)
   G4bool useKVsolver;	 // Use K-Vg eigensolver ($G4CMP_USE_KVSOLVER)
   G4bool fanoEnabled;	 // Apply Fano statistics to ionization energy deposits ($G4CMP_FANO_ENABLED)
   G4bool kaplanKeepPh;   // Emit or iterate over all phonons in KaplanQP ($G4CMP_KAPLAN_KEEP)
   G4bool chargeCloud;    // Produce e/h pairs around position ($G4CMP_CHARGE_CLOUD) 
   G4bool recordMinE;     // Store below-minimum track energy as NIEL when killed
+  G4bool useMeshCache;   // Read/write binary mesh field tables ($G4CMP_MESH_CACHE)
+  G4bool fastCharges;    // Tabulated drift instead of charge tracking ($G4CMP_FAST_CHARGES)
   G4VNIELPartition* nielPartition; // Function class to compute non-ionizing ($G4CMP_NIEL_FUNCTION)
+  std::shared_ptr<const G4CMPPhononWeightWindow> phononWindow; // Shared with worker threads
   // Empirical Lindhard Model Parameters
     // Model fit parameters
   G4double Empklow;  
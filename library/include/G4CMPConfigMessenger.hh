@@ -47,6 +47,12 @@
 // 20250213  G4CMP-457: Add empirical Lindhard NIEL parameters.
 // 20250325  G4CMP-463:  Add parameter for phonon surface step size & limit.
 // 20250502  G4CMP-358: Add macro command for maximum steps (stuck tracks).
+// 20261016  Add macro commands to control binary mesh field cache.
+// 20261016  Add macro commands for fast charge transport mode.
+// 20261016  Add macro commands for regular-grid field cache.
+// 20261016  Add macro command for tabulated scattering rate tolerance.
+// 20261016  Add macro commands for multi-emission Luke macro-steps.
+// 20261016  Add macro command for phonon weight-window file.
 
 
 #include "G4UImessenger.hh"
@@ -78,7 +84,10 @@ private:
   G4UIcmdWithAnInteger* pBounceCmd;
   G4UIcmdWithAnInteger* maxStepsCmd;
   G4UIcmdWithAnInteger* maxLukeCmd;
+  G4UIcmdWithAnInteger* lukeMacroCmd;
+  G4UIcmdWithAnInteger* lukeMacroPhCmd;
   G4UIcmdWithAnInteger* pSurfStepLimitCmd;
+  G4UIcmdWithAnInteger* meshThreadsCmd;
   G4UIcmdWithADoubleAndUnit* clearCmd;
   G4UIcmdWithADoubleAndUnit* minEPhononCmd;
   G4UIcmdWithADoubleAndUnit* minEChargeCmd;
@@ -92,19 +101,28 @@ private:
   G4UIcmdWithADoubleAndUnit* hATrapIonMFPCmd;
   G4UIcmdWithADoubleAndUnit* tempCmd;
   G4UIcmdWithADoubleAndUnit* pSurfStepSizeCmd;
+  G4UIcmdWithADoubleAndUnit* fieldGridStepCmd;
+  G4UIcmdWithADoubleAndUnit* fastStepCmd;
+  G4UIcmdWithADoubleAndUnit* ramoBinCmd;
   G4UIcmdWithADouble* minstepCmd;
   G4UIcmdWithADouble* makePhononCmd;
   G4UIcmdWithADouble* makeChargeCmd;
   G4UIcmdWithADouble* lukePhononCmd;
+  G4UIcmdWithADouble* fieldGridTolCmd;
+  G4UIcmdWithADouble* rateTableTolCmd;
   G4UIcmdWithAString* dirCmd;
   G4UIcmdWithAString* lukeFileCmd;
   G4UIcmdWithAString* ivRateModelCmd;
   G4UIcmdWithAString* nielPartitionCmd;
+  G4UIcmdWithAString* meshCacheDirCmd;
+  G4UIcmdWithAString* phononWindowCmd;
   G4UIcmdWithABool*   kvmapCmd;
   G4UIcmdWithABool*   fanoStatsCmd;
   G4UIcmdWithABool*   kaplanKeepCmd;
   G4UIcmdWithABool*   ehCloudCmd;
   G4UIcmdWithABool*   recordMinECmd;
+  G4UIcmdWithABool*   meshCacheCmd;
+  G4UIcmdWithABool*   fastChargeCmd;
 
   // Empirical Lindhard Model Macro Commands
   G4UIcmdWithABool* EmpEDepKCmd;
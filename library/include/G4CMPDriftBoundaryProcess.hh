@@ -28,6 +28,7 @@
 // 20250927  Add override version of new DoFinalReflection(), to support
 //           proper recombination.
 // 20251013  Add functions for specular and diffuse electron reflection.
+// 20261016  Add BuildPhysicsTable() to fill surface parameter records.
 
 #ifndef G4CMPDriftBoundaryProcess_h
 #define G4CMPDriftBoundaryProcess_h 1
@@ -44,6 +45,9 @@ public:
   G4CMPDriftBoundaryProcess(const G4String& name = "G4CMPChargeBoundary");
   virtual ~G4CMPDriftBoundaryProcess();
 
+  // Fill surface parameter records from property tables at start of run
+  virtual void BuildPhysicsTable(const G4ParticleDefinition&);
+
   virtual G4double PostStepGetPhysicalInteractionLength(const G4Track& track,
                                                    G4double previousStepSize,
                                                    G4ForceCondition* condition);
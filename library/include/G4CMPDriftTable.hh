@@ -0,0 +1,66 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPDriftTable.hh
+/// \brief Definition of the G4CMPDriftTable class.  This class holds
+///	   the mean drift speed and diffusion coefficient of electrons
+///	   and holes vs. electric field magnitude, for one lattice.  The
+///	   table is produced from full G4CMP transport (see, e.g.,
+///	   examples/charge/drift_curve.mac), and used by fast charge
+///	   transport in place of stepping through the drift processes.
+///
+///	   The input file format is fixed:  each line consists of five
+///	   floating-point values, field in V/cm, electron speed in km/s,
+///	   electron diffusion in cm2/s, hole speed in km/s, and hole
+///	   diffusion in cm2/s.  Text following '#' is ignored.
+//
+// $Id$
+//
+// 20261016  New class for tabulated drift speed and diffusion.
+
+#ifndef G4CMPDriftTable_hh
+#define G4CMPDriftTable_hh 1
+
+#include "globals.hh"
+#include <vector>
+
+
+class G4CMPDriftTable {
+public:
+  G4CMPDriftTable() {;}
+  virtual ~G4CMPDriftTable() {;}
+
+  // Read table from file; returns false if file is missing or invalid
+  G4bool Load(const G4String& filename);
+
+  // Add one point (in Geant4 units); points may be added in any order
+  void AddPoint(G4double field, G4double vElectron, G4double dElectron,
+		G4double vHole, G4double dHole);
+
+  void Clear();
+
+  G4bool IsFilled() const { return !fField.empty(); }
+  size_t GetNumberOfPoints() const { return fField.size(); }
+
+  // Speed and diffusion for field magnitude.  Speed is proportional to
+  // field below first point (constant mobility), and saturates above
+  // the last point; diffusion is constant outside the table.
+  G4double GetVelocity(G4bool isHole, G4double field) const;
+  G4double GetDiffusion(G4bool isHole, G4double field) const;
+
+  G4double GetMinField() const { return IsFilled() ? fField.front() : 0.; }
+  G4double GetMaxField() const { return IsFilled() ? fField.back() : 0.; }
+
+private:
+  // Interpolation is linear in log(field), which is spaced roughly
+  // logarithmically in drift-curve studies
+  G4double Interpolate(const std::vector<G4double>& y, G4double field) const;
+
+  std::vector<G4double> fField;		// Field magnitude, increasing
+  std::vector<G4double> fVel[2];	// Drift speed, electron and hole
+  std::vector<G4double> fDiff[2];	// Diffusion, electron and hole
+};
+
+#endif	/* G4CMPDriftTable_hh */
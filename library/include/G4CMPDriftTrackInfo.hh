@@ -12,11 +12,13 @@
 // $Id$
 //
 // 20161111 Initial commit - R. Agnese
+// 20261016  Add per-step cache of electric field and potential at track.
 
 #ifndef G4CMPDriftTrackInfo_hh
 #define G4CMPDriftTrackInfo_hh 1
 
 #include "G4CMPVTrackInfo.hh"
+#include "G4ThreeVector.hh"
 /*
 #include "G4Allocator.hh"
 
@@ -42,10 +44,30 @@ public:
   G4int ValleyIndex() const                                { return valleyIdx; }
   void SetValleyIndex(G4int valIdx);
 
+  // Field and potential evaluated at track position during step; used by
+  // G4CMPFieldUtils so that each step queries the field only once
+  G4bool GetCachedField(G4int step, const G4ThreeVector& pos,
+			G4ThreeVector& field) const;
+  void SetCachedField(G4int step, const G4ThreeVector& pos,
+		      const G4ThreeVector& field);
+
+  G4bool GetCachedPotential(G4int step, const G4ThreeVector& pos,
+			    G4double& potential) const;
+  void SetCachedPotential(G4int step, const G4ThreeVector& pos,
+			  G4double potential);
+
   virtual void Print() const override;
 
 private:
   G4int valleyIdx;
+
+  G4int fieldStep = -1;			// Step number and position of field
+  G4ThreeVector fieldPos;
+  G4ThreeVector fieldValue;
+
+  G4int potentialStep = -1;		// Step number and position of potential
+  G4ThreeVector potentialPos;
+  G4double potentialValue = 0.;
 };
 
 #endif
@@ -22,6 +22,10 @@ public:
   G4CMPElectrodeSensitivity& operator=(G4CMPElectrodeSensitivity&&);
 
   virtual void Initialize(G4HCofThisEvent*) override;
+
+  // Record hit made without tracking (e.g., G4CMPFastChargeTransport)
+  // Takes ownership of hit
+  void InsertHit(G4CMPElectrodeHit* hit);
   
 protected:
   virtual G4bool ProcessHits(G4Step*, G4TouchableHistory*) override;
@@ -18,6 +18,8 @@
 // 20140404  Drop unnecessary data members, using functions in G4LatticePhysical
 // 20170525  Add default "rule of five" copy/move operators
 // 20210920  Add verbosity with access to be used by G4CMPFieldManager
+// 20261016  Precompose force and band-energy matrices for each valley
+// 20261016  Expose band energy vs. momentum for analytic stepper
 
 #ifndef G4CMPEqEMField_hh
 #define G4CMPEqEMField_hh
@@ -25,7 +27,9 @@
 #include "G4EqMagElectricField.hh"
 #include "G4AffineTransform.hh"
 #include "G4LatticePhysical.hh"
+#include "G4RotationMatrix.hh"
 #include "G4ThreeVector.hh"
+#include <vector>
 
 class G4ElectroMagneticField;
 
@@ -66,8 +70,16 @@ public:
 			 G4double dydx[]) const;
   // Given the value of the electromagnetic field, this function 
   // calculates the value of the derivative dydx.
+
+  // Total energy (Ekin + mc^2) of charge with global momentum, in current
+  // valley; velocity is p*c/E for both electrons and holes
+  G4double TotalEnergy(const G4ThreeVector& p) const;
   
 private:
+  // Collapse transforms between global and valley frames into single
+  // matrices, rebuilt when lattice or local coordinates change
+  void FillValleyTransforms();
+
   const G4LatticePhysical* theLattice;
   G4int verboseLevel;			// For diagnostic messages
 
@@ -78,10 +90,13 @@ private:
   G4AffineTransform fLocalToGlobal;	// Local vs. global coordinates
   G4AffineTransform fGlobalToLocal;
 
+  std::vector<G4RotationMatrix> valleyForce;	// Global E to global m0M^-1*E
+  std::vector<G4RotationMatrix> valleyBand;	// Global p to <p|M|p>/m0
+  G4double mc2sq;				// (m0 c^2)^2 for band energy
+
   mutable G4ThreeVector pos;		// Buffers to reduce memory churn
   mutable G4ThreeVector mom;
   mutable G4ThreeVector momdir;
-  mutable G4ThreeVector vel;
   mutable G4ThreeVector Efield;		// True field as three vector
   mutable G4ThreeVector force;		// force = qE/beta in H-V coordinates
 };
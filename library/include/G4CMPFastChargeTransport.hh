@@ -0,0 +1,115 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPFastChargeTransport.hh
+/// \brief Definition of the G4CMPFastChargeTransport class.  This class
+///	   moves a charge carrier from its starting point to the surface
+///	   of its volume using the lattice drift table (G4CMPDriftTable),
+///	   instead of tracking it through the G4CMP drift processes.  The
+///	   carrier follows the field direction at the tabulated drift speed,
+///	   with Gaussian diffusion added at each step.
+///
+///	   If the volume has a G4CMPMeshElectricField with weighting
+///	   potentials added (AddPotential()), the Shockley-Ramo induced
+///	   charge on each of those channels is accumulated, along with the
+///	   induced current binned in time if G4CMPConfigManager::
+///	   GetRamoBinWidth() is set.  The induced charge for a carrier of
+///	   charge q moving from x0 to x1 is q*(V(x1)-V(x0)), so a carrier
+///	   collected on a channel's electrode contributes q.
+///
+///	   Luke phonons are not produced, and electrons follow the field
+///	   instead of their valley axis; the drift table carries the effect
+///	   of both on the mean drift speed.
+//
+// $Id$
+//
+// 20261016  New class for tabulated drift and Shockley-Ramo signals.
+// 20261016  Document that callers must handle uncollected carriers.
+
+#ifndef G4CMPFastChargeTransport_hh
+#define G4CMPFastChargeTransport_hh 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class G4CMPDriftTable;
+class G4CMPMeshElectricField;
+class G4ElectroMagneticField;
+class G4LogicalVolume;
+
+
+class G4CMPFastChargeTransport {
+public:
+  G4CMPFastChargeTransport(G4int verbose=0);
+  virtual ~G4CMPFastChargeTransport() {;}
+
+  void SetVerboseLevel(G4int vb) { verboseLevel = vb; }
+  G4int GetVerboseLevel() const { return verboseLevel; }
+
+  // Drift carrier with charge (in units of e+) from pos, in coordinates
+  // local to volume, until it leaves the volume.  Volume field must be
+  // in local coordinates (G4CMPFieldManager or bare mesh field).  On
+  // return, pos and time are the exit point and arrival time, or where
+  // the carrier stopped if WasCollected() is false; callers must handle
+  // such carriers.  Returns false, with pos and time unchanged, if
+  // carrier can't be transported.
+  G4bool Drift(const G4LogicalVolume* vol, const G4CMPDriftTable* table,
+	       G4double charge, G4ThreeVector& pos, G4double& time);
+
+  // Carrier reached the surface in last Drift(), rather than stalling
+  // (zero field and diffusion, or G4CMPConfigManager::GetMaxChargeSteps())
+  G4bool WasCollected() const { return collected; }
+
+  // Number of steps taken by last Drift(), for diagnostics
+  G4int GetNumberOfSteps() const { return nSteps; }
+
+  // Shockley-Ramo signals, summed over carriers since ClearSignals()
+  // Channel i is weighting potential i+1 of the mesh field.  Bin width
+  // is taken from G4CMPConfigManager when signals are cleared.
+  void ClearSignals();
+
+  G4int GetNumberOfChannels() const { return (G4int)inducedQ.size(); }
+  G4double GetInducedCharge(G4int ich) const;
+
+  // Induced current in time bins of GetSignalBinWidth(), from time zero
+  const std::vector<G4double>& GetInducedCurrent(G4int ich) const;
+  G4double GetSignalBinWidth() const { return binWidth; }
+
+private:
+  // Drift speed, direction and diffusion for carrier at local point
+  G4double DriftVelocity(const G4ThreeVector& pos, G4ThreeVector& vdir,
+			 G4double& diffusion) const;
+
+  // Weighting potentials at local point, V[0] is the bias potential
+  void GetPotentials(const G4ThreeVector& pos, std::vector<G4double>& V) const;
+
+  // Add change in weighting potentials over step to signals
+  void AddSignal(const std::vector<G4double>& V0,
+		 const std::vector<G4double>& V1, G4double tmid);
+
+  G4int verboseLevel;
+  G4int nSteps;
+  G4bool collected;
+
+  // Configuration for current Drift() call
+  const G4ElectroMagneticField* field;
+  const G4CMPMeshElectricField* mesh;
+  const G4CMPDriftTable* drift;
+  G4bool isHole;
+  G4double charge;
+
+  // Accumulated signals
+  G4double binWidth;
+  std::vector<G4double> inducedQ;
+  std::vector<std::vector<G4double> > inducedI;
+
+  // Buffers for field and potentials, reused between steps
+  std::vector<G4double> Vstart, Vend;
+  mutable G4double point[4];
+  mutable G4double fieldBuf[6];
+};
+
+#endif	/* G4CMPFastChargeTransport_hh */
@@ -13,6 +13,7 @@
 //
 // 20180622  Michael Kelsey
 // 20211005  Add position-only utility (get touchable from position)
+// 20261016  Track-based queries use per-step cache in G4CMPDriftTrackInfo
 
 #include "G4ThreeVector.hh"
 
@@ -27,6 +28,7 @@ class G4VTouchable;
 
 namespace G4CMP {
   // Get field at _global_ coordinate of track/step
+  // NOTE:  Charge tracks reuse the value already found in the same step
   G4ThreeVector GetFieldAtPosition(const G4Track& track);
   G4ThreeVector GetFieldAtPosition(const G4Step& step);
   G4ThreeVector GetFieldAtPosition(const G4ThreeVector& pos);
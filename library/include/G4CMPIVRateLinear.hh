@@ -12,6 +12,7 @@
 // 20170815  Move G4CMPProcessUtils inheritance to base class
 // 20240823  Change name to plain "Linear", to match UseRateModel()
 // 20250515  Apply IV energy thresholds to reduce zero-voltage scatters
+// 20261016  Tabulate rate vs. HV field magnitude in LoadDataForTrack
 
 #ifndef G4CMPIVRateLinear_hh
 #define G4CMPIVRateLinear_hh 1
@@ -21,11 +22,20 @@
 
 class G4CMPIVRateLinear : public G4CMPVScatteringRate {
 public:
-  G4CMPIVRateLinear() : G4CMPVScatteringRate("Linear") {;}
+  G4CMPIVRateLinear() : G4CMPVScatteringRate("Linear"), rateTable(nullptr) {;}
   virtual ~G4CMPIVRateLinear() {;}
 
   virtual G4double Rate(const G4Track& aTrack) const;
   virtual G4double Threshold(G4double Eabove=0.) const;
+
+  // Fill rate table for current lattice
+  virtual void LoadDataForTrack(const G4Track* track);
+
+protected:
+  G4double FieldRate(G4double Efield) const;	// Field magnitude in V/cm
+
+private:
+  const G4CMPRateTable* rateTable;	// Rate vs. field (V/cm), if available
 };
 
 #endif	/* G4CMPIVRateLinear_hh */
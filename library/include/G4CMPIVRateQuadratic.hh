@@ -12,6 +12,7 @@
 // 20170815  Move G4CMPProcessUtils inheritance to base class
 // 20240823  Change name to plain "Quadratic", to match UseRateModel()
 // 20250515  Apply IV energy thresholds to reduce zero-voltage scatters
+// 20261016  Tabulate rate vs. HV field magnitude in LoadDataForTrack
 
 #ifndef G4CMPIVRateQuadratic_hh
 #define G4CMPIVRateQuadratic_hh 1
@@ -21,11 +22,20 @@
 
 class G4CMPIVRateQuadratic : public G4CMPVScatteringRate {
 public:
-  G4CMPIVRateQuadratic() : G4CMPVScatteringRate("Quadratic") {;}
+  G4CMPIVRateQuadratic() : G4CMPVScatteringRate("Quadratic"), rateTable(nullptr) {;}
   virtual ~G4CMPIVRateQuadratic() {;}
 
   virtual G4double Rate(const G4Track& aTrack) const;
   virtual G4double Threshold(G4double Eabove=0.) const;
+
+  // Fill rate table for current lattice
+  virtual void LoadDataForTrack(const G4Track* track);
+
+protected:
+  G4double FieldRate(G4double Efield) const;	// Field magnitude in V/m
+
+private:
+  const G4CMPRateTable* rateTable;	// Rate vs. field (V/m), if available
 };
 
 #endif	/* G4CMPIVRateQuadratic_hh */
@@ -9,6 +9,7 @@
 // $Id$
 //
 // 20170919  Add interface for threshold identification
+// 20261016  Pass energy to component rates; use table from LoadDataForTrack
 
 #ifndef G4CMPInterValleyRate_hh
 #define G4CMPInterValleyRate_hh 1
@@ -22,8 +23,8 @@ public:
     : G4CMPVScatteringRate("InterValley"),
       hbar_sq(CLHEP::hbar_Planck*CLHEP::hbar_Planck), hbar_4th(hbar_sq*hbar_sq),
       m_electron(CLHEP::electron_mass_c2/CLHEP::c_squared),
-      eTrk(0.), density(0.), kT(0.), uSound(0.), alpha(0.), nValley(0),
-      m_DOS(0.), m_DOS3half(0.) {;}
+      density(0.), kT(0.), uSound(0.), alpha(0.), nValley(0),
+      m_DOS(0.), m_DOS3half(0.), rateTable(nullptr) {;}
 
   virtual ~G4CMPInterValleyRate() {;}
 
@@ -35,9 +36,9 @@ public:
   virtual void LoadDataForTrack(const G4Track* track);
 
 protected:
-  G4double acousticRate() const;	// Acoustic intravalley rate
-  G4double opticalRate() const;		// Optical intervalley D0, D1 rate
-  G4double scatterRate() const;		// Neutral impurity scattering
+  G4double acousticRate(G4double E) const;	// Acoustic intravalley rate
+  G4double opticalRate(G4double E) const;	// Optical intervalley D0, D1 rate
+  G4double scatterRate(G4double E) const;	// Neutral impurity scattering
 
   G4double energyFunc(G4double E) const {	// Energy dependence of rates
     return sqrt(E*(1+alpha*E))*(1+2*alpha*E);
@@ -49,9 +50,6 @@ private:
   const G4double hbar_4th;
   const G4double m_electron;
 
-  // Kinematic parameters set by Rate()
-  mutable G4double eTrk;	// Track kinetic energy
-
   G4double density;		// Crystal density (from G4Material)
   G4double kT;			// Crystal temperature * k_B
   G4double uSound;		// Average sound speed for acoustic rate
@@ -59,6 +57,8 @@ private:
   G4int    nValley;		// Number of final-state valleys (2N-1)
   G4double m_DOS;		// Electron "density of states" average mass
   G4double m_DOS3half;		// m_DOS ^ (3/2)
+
+  const G4CMPRateTable* rateTable;	// Total rate vs. energy, if available
 };
 
 #endif	/* G4CMPInterValleyRate_hh */
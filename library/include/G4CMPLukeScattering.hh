@@ -13,6 +13,7 @@
 // 20170805  Remove GetMeanFreePath() function to scattering-rate model
 // 20190816  Add flag to track secondary phonons immediately (c.f. G4Cerenkov)
 // 20201109  Drop G4CMP_DEBUG protection here, to avoid client rebuilding
+// 20261016  Add optional macro-steps with many emissions per step
 
 #ifndef G4CMPLukeScattering_h
 #define G4CMPLukeScattering_h 1
@@ -21,6 +22,7 @@
 #include "G4CMPVDriftProcess.hh"
 #include "G4ThreeVector.hh"
 #include <iostream>
+#include <vector>
 
 class G4CMPTrackInformation;
 class G4VProcess;
@@ -38,7 +40,26 @@ public:
   void SetTrackSecondariesFirst(const G4bool val) { secondariesFirst = val; }
   G4bool GetTrackSecondariesFirst() const { return secondariesFirst; }
 
+protected:
+  // With macro-steps enabled, process is forced to collect emissions on
+  // every step, and step length is scaled up by number of emissions
+  virtual G4double GetMeanFreePath(const G4Track& aTrack, G4double prevStep,
+				   G4ForceCondition* condition);
+
 private:
+  // Generate all emissions expected over step, returning a few weighted
+  // phonons which carry the total emitted energy
+  G4VParticleChange* MacroStepDoIt(const G4Track& aTrack, const G4Step& aStep);
+
+  // Carrier wavevector in spherical (isotropic mass) frame
+  G4ThreeVector GetSphericalK(G4int iValley, const G4ThreeVector& ptrk) const;
+
+  // Single emission from local carrier momentum and kinetic energy, which
+  // are replaced by the recoil values.  Returns false if below sound speed.
+  G4bool MakeEmission(G4int iValley, G4double kSound, G4double massc2,
+		      G4ThreeVector& ptrk, G4double& Etrk,
+		      G4ThreeVector& qvec, G4double& Ephonon) const;
+
   // hide assignment operator as private
   G4CMPLukeScattering(G4CMPLukeScattering&);
   G4CMPLukeScattering& operator=(const G4CMPLukeScattering& right);
@@ -47,6 +68,11 @@ private:
   G4bool secondariesFirst;
 
   std::ofstream output;		// Only used for G4CMP_DEBUG debugging
+
+  std::vector<G4ThreeVector> keptQ;	// Phonons kept from macro-step
+  std::vector<G4double> keptE;
+  std::vector<G4double> keptT;		// Emission time from start of step
+  std::vector<G4ThreeVector> keptX;	// Recoil offset of emission point
 };
 
 #endif	/* G4CMPLukeScattering */
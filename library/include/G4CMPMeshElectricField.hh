@@ -20,6 +20,14 @@
 // 20190612  Mesh pointer ctor should set axes to kUndefined
 // 20200520  For thread-safety, move reusable "pos" buffer here
 // 20240921  G4CMP-244: Add non-const access to meshing object.
+// 20261016  Copies share read-only mesh tables, only search state is local.
+// 20261016  Load tables from binary cache when EPot file is unchanged.
+// 20261016  Add potentials from other files on same mesh (e.g., Ramo
+//		weighting potentials), evaluated with a single mesh search.
+// 20261016  Add EvaluateBatch() for arrays of points.
+// 20261016  Add optional regular-grid cache of field for GetFieldValue().
+// 20261016  Build field grid on first use, shared with copies.
+// 20261016  Add ReadPotential(), SameMeshPoints() for quiet mesh matching.
 
 #ifndef G4CMPMeshElectricField_h 
 #define G4CMPMeshElectricField_h 1
@@ -27,7 +35,11 @@
 #include "geomdefs.hh"
 #include "G4ElectricField.hh"
 #include "G4ThreeVector.hh"
+#include "G4Threading.hh"
 #include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 class G4CMPBiLinearInterp;
@@ -60,7 +72,7 @@ public:
   G4CMPMeshElectricField(const G4CMPVMeshInterpolator* mesh,
 			 EAxis xdim=kUndefined, EAxis ydim=kUndefined);
 
-  // Copy constructor and assignment operator
+  // Copy constructor and assignment operator; mesh tables are shared
   G4CMPMeshElectricField(const G4CMPMeshElectricField &p);
   G4CMPMeshElectricField& operator=(const G4CMPMeshElectricField &p);
 
@@ -72,6 +84,47 @@ public:
   // Call through to interpolator (e.g., for use with FET code)
   virtual G4double GetPotential(const G4double Point[3]) const;
 
+  // Load another potential defined on the same mesh points (e.g., Ramo
+  // potential for a channel), without triangulating again.  Returns index
+  // for GetPotentials(), or -1 (with a warning) if mesh points don't match
+  // this field.  Second form takes points and values from ReadPotential().
+  G4int AddPotential(const G4String& EPotFileName, G4double Vscale=1.);
+  G4int AddPotential(const std::vector<std::array<G4double,3> >& xyz,
+		     const std::vector<G4double>& v);
+
+  // Read EPot file into sorted mesh points and values, without building
+  // a mesh, so that one file can be checked against several fields
+  static G4bool ReadPotential(const G4String& EPotFileName, G4double Vscale,
+			      std::vector<std::array<G4double,3> >& xyz,
+			      std::vector<G4double>& v);
+
+  // True if points (from ReadPotential()) match this field's 3D mesh;
+  // no warning is issued, so callers may probe several fields
+  G4bool SameMeshPoints(const std::vector<std::array<G4double,3> >& xyz) const;
+
+  // Number of potentials, including the one used for GetFieldValue()
+  G4int GetNumberOfPotentials() const;
+
+  // Evaluate all potentials at location, V[0] is from constructor
+  void GetPotentials(const G4double Point[3], G4double V[]) const;
+
+  // Field vector(s) as above, plus all potentials, from one mesh search
+  void GetFieldAndPotentials(const G4double Point[3], G4double *Efield,
+			     G4double V[]) const;
+
+  // Evaluate many points at once, Points[3*npts].  Either output may be
+  // null: Efield[3*npts] is the electric field only (no magnetic part),
+  // V[npts*GetNumberOfPotentials()] holds all potentials for each point.
+  void EvaluateBatch(size_t npts, const G4double Points[], G4double Efield[],
+		     G4double V[]) const;
+
+  // Resample field onto regular grid (G4CMPConfigManager::GetFieldGridStep),
+  // used by GetFieldValue() where the field is smooth.  The grid is built
+  // on the first call to GetFieldValue(), and shared by copies; call this
+  // to rebuild it now (e.g., after changing values via GetInterpolator()).
+  // NOTE: Only 3D meshes are gridded; step of zero removes existing grid
+  void BuildFieldGrid();
+
   // Get access to mesh interpolator for client access or copying
         G4CMPVMeshInterpolator* GetInterpolator()       { return Interp; }
   const G4CMPVMeshInterpolator* GetInterpolator() const { return Interp; }
@@ -86,6 +139,43 @@ private:
 
   void BuildInterp(const G4String& EPotFileName, G4double Vscale=1.);
 
+  // Field sampled at nodes of regular grid, shared read-only by copies
+  struct FieldGrid {
+    std::array<G4double,3> Min{{0.,0.,0.}};	// Lower corner of grid
+    std::array<G4double,3> Step{{1.,1.,1.}};	// Cell dimensions
+    std::array<G4int,3> N{{0,0,0}};		// Number of cells along axes
+    std::vector<G4double> E;		// Field at nodes, (Ex,Ey,Ez) each
+    std::vector<char> UseMesh;		// Cell is outside hull or not smooth
+  };
+
+  // Grid is filled on first use, once for this field and all its copies
+  struct GridState {
+    G4Mutex mutex;
+    std::atomic<G4bool> ready{false};
+    std::shared_ptr<const FieldGrid> grid;	// Null if grid is not used
+  };
+
+  std::shared_ptr<GridState> Grid = std::make_shared<GridState>();
+
+  // Get grid, building it if needed; null if GetFieldValue() uses mesh
+  const FieldGrid* GetFieldGrid() const;
+  std::shared_ptr<const FieldGrid> MakeFieldGrid() const;
+
+  // Interpolate grid at point; false if point needs full mesh search
+  G4bool GridFieldValue(const FieldGrid& grid, const G4double Point[3],
+			G4double Efield[3]) const;
+
+  // Read text file into buffer, and parse into sorted points and values
+  static std::string ReadEPotFile(const G4String& EPotFileName);
+  static void ParseEPot(const std::string& contents, G4double Vscale,
+			std::vector<std::array<G4double,3> >& xyz,
+			std::vector<G4double>& v);
+
+  // Binary cache of tetrahedral mesh built from EPot file; name is empty
+  // if caching is disabled or no cache directory is configured
+  G4String MeshCacheName(const G4String& EPotFileName) const;
+  std::uint64_t MeshCacheKey(const std::string& contents, G4double Vscale) const;
+
   // Construct 3D mesh interpolator
   void BuildInterp(const std::vector<std::array<G4double,3> >& xyz,
 		   const std::vector<G4double>& v,
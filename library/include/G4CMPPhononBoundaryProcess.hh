@@ -20,6 +20,7 @@
 // 20250423  G4CMP-468 -- Move GetLambertianVector to G4CMPUtils.
 // 20250424  G4CMP-465 -- Add G4CMPSolidUtils object for custom solid functions.
 // 20250505  G4CMP-458 -- Rename GetReflectedVector to GetSpecularVector.
+// 20261016  Add BuildPhysicsTable() to fill surface parameter records.
 
 #ifndef G4CMPPhononBoundaryProcess_h
 #define G4CMPPhononBoundaryProcess_h 1
@@ -41,6 +42,9 @@ public:
   // Configure for current track including AnharmonicDecay utility
   virtual void LoadDataForTrack(const G4Track* track);
 
+  // Fill surface parameter records from property tables at start of run
+  virtual void BuildPhysicsTable(const G4ParticleDefinition&);
+
   virtual G4double PostStepGetPhysicalInteractionLength(const G4Track& track,
                                                 G4double previousStepSize,
                                                 G4ForceCondition* condition);
@@ -34,6 +34,7 @@
 /// directly absorb phonons below 2*bandgap.
 // 
 // 20221006  M. Kelsey -- Adapted from SuperCDMS simulation version
+// 20261016  Cache filmAbsorption from table on first use.
 
 #ifndef G4CMPPhononElectrode_hh
 #define G4CMPPhononElectrode_hh 1
@@ -80,6 +81,7 @@ protected:
   // NOTE: "Mutable" because AbsorbAtElectrode() function is const
   mutable G4CMPKaplanQP* kaplanQP;	// Create instance of QET simulator
   mutable std::vector<G4double> phononEnergies;		// Reusable buffer
+  mutable G4double filmAbsorption;	// Cached from table on first use
 };
 
 #endif
@@ -5,16 +5,13 @@
 //  Created by Daniel Palken in 2014 for G4CMP
 //
 //  20170525  Drop unnecessary empty destructor ("rule of five" semantics)
+//  20261016  Replace NR eigensolver with closed-form 3x3 solver, and
+//		precompute elasticity contraction; add thread-safe interface
 
-#include "G4CMPEigenSolver.hh" // Numerical Recipes III code
-#include "G4CMPMatrix.hh"
 #include "G4PhononPolarization.hh"
 #include "G4ThreeVector.hh"
 #include <string>
-#include <vector>
 using std::string;
-using std::vector;
-using G4CMP::matrix;
 
 class G4LatticeLogical;
 
@@ -23,11 +20,21 @@ class G4CMPPhononKinematics {
 public:
   G4CMPPhononKinematics(G4LatticeLogical *lat);
 
+  // Reload elasticity tensor and density after lattice has been changed
+  void updateElasticity();
+
   // Direct calculations
   void computeKinematics(const G4ThreeVector& n_dir);
-  void fillChristoffelMatrix(const G4ThreeVector& n_dir);
-  void computeGroupVelocity(int mode, size_t idx, const matrix<double>& epol,
-			    const G4ThreeVector& slow);
+  void fillChristoffelMatrix(const G4ThreeVector& n_dir,
+			     double dil[3][3]) const;
+  G4ThreeVector computeGroupVelocity(const G4ThreeVector& epol,
+				     const G4ThreeVector& slow) const;
+
+  // Thread-safe calculation, using only local buffers (no caching)
+  G4ThreeVector computeGroupVelocity(int mode,
+				     const G4ThreeVector& n_dir) const;
+
+  // Buffered calculations, reused for repeated calls with same direction
   const G4ThreeVector& getGroupVelocity(int mode, const G4ThreeVector& n_dir);
   const G4ThreeVector& getPolarization(int mode, const G4ThreeVector& n_dir);
   const G4ThreeVector& getSlowness(int mode, const G4ThreeVector& n_dir);
@@ -36,13 +43,26 @@ public:
 public:
   const G4String& getLatticeName() const;	// For use with lookup table
 
+private:
+  // Fill phase speed, slowness, polarization and (if vg not null) group
+  // velocity of all modes
+  void solveModes(const G4ThreeVector& n_dir, double vp[],
+		  G4ThreeVector slow[], G4ThreeVector epol[],
+		  G4ThreeVector vg[]) const;
+
+  // Eigensystem of symmetric 3x3 matrix, eigenvalues sorted in descending
+  // order, and corresponding eigenvectors in columns
+  static void solveEigenSystem(const double a[3][3], double eval[3],
+			       double evec[3][3]);
+
 private:
   G4LatticeLogical* lattice;
 
+  // C_ijlm/density, with (i,l) packed as Voigt index (xx,yy,zz,yz,xz,xy)
+  double cijlm[6][3][3];
+
   // Data buffers to compute kinematics for all modes in specified direction
   G4ThreeVector last_ndir;		// Buffer to handle caching results
-  G4CMPEigenSolver eigenSys;
-  matrix<double> christoffel;
   double vphase[G4PhononPolarization::NUM_MODES];
   G4ThreeVector slowness[G4PhononPolarization::NUM_MODES];
   G4ThreeVector vgroup[G4PhononPolarization::NUM_MODES];
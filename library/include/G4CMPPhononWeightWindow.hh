@@ -0,0 +1,117 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPPhononWeightWindow.hh
+/// \brief Definition of the G4CMPPhononWeightWindow class.  This class
+///	   applies weight-window variance reduction to phonon tracks:
+///	   tracks with weight below the window are subject to Russian
+///	   roulette, and tracks above the window are split into copies.
+///	   The expected total weight (and so the expected energy reaching
+///	   sensors) is unchanged.
+///
+///	   The window is centered on W0/I, where W0 is the reference
+///	   weight and the importance I is the product of tabulated
+///	   functions of phonon energy, global time, and position along
+///	   each axis of the volume's local coordinates.  Tabulated
+///	   functions are interpolated linearly, and are constant beyond
+///	   their end points; an empty table has importance one.
+///
+///	   The input file consists of one entry per line; text following
+///	   '#' is ignored.
+///
+///	   energy <E> <unit> <importance>	Importance vs. phonon energy
+///	   time <t> <unit> <importance>		Importance vs. global time
+///	   x|y|z <pos> <unit> <importance>	Importance vs. local position
+///	   weight <W0>				Weight at importance one (1)
+///	   ratio <R>				Upper/lower window bound (4)
+///	   maxSplit <N>				Maximum copies per split (10)
+//
+// $Id$
+//
+// 20261016  New class for phonon splitting and Russian roulette.
+// 20261016  Split copies of current track use proposed time and position.
+
+#ifndef G4CMPPhononWeightWindow_hh
+#define G4CMPPhononWeightWindow_hh 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class G4ParticleChange;
+class G4Track;
+
+
+class G4CMPPhononWeightWindow {
+public:
+  G4CMPPhononWeightWindow() : refWeight(1.), ratio(4.), maxSplit(10) {;}
+  virtual ~G4CMPPhononWeightWindow() {;}
+
+  // Read importance tables and parameters; returns false if invalid
+  G4bool Load(const G4String& filename);
+
+  // Configure window directly (values in Geant4 units)
+  void AddEnergyPoint(G4double energy, G4double importance);
+  void AddTimePoint(G4double time, G4double importance);
+  void AddPositionPoint(G4int axis, G4double pos, G4double importance);
+  void SetReferenceWeight(G4double wt) { refWeight = wt; }
+  void SetWindowRatio(G4double r) { ratio = r; }
+  void SetMaxSplit(G4int n) { maxSplit = n; }
+  void Clear();
+
+  G4double GetReferenceWeight() const { return refWeight; }
+  G4double GetWindowRatio() const { return ratio; }
+  G4int GetMaxSplit() const { return maxSplit; }
+
+  // Importance of phonon; position must be in volume's local coordinates
+  G4double GetImportance(G4double energy, G4double time,
+			 const G4ThreeVector& localPos) const;
+
+  // Weight at center of window for given importance
+  G4double GetTargetWeight(G4double importance) const;
+
+  // Russian roulette for weight below window:  returns false if track
+  // should be killed, otherwise updates weight of survivor
+  G4bool Roulette(G4double& weight, G4double importance) const;
+
+  // Number of tracks for weight above window (one if within window),
+  // and updates weight to be given to each track
+  G4int Split(G4double& weight, G4double importance) const;
+
+  // Apply window to new secondary with given weight: either deletes the
+  // track, or appends it (and any copies) to list with weights assigned.
+  // Returns total weight of appended tracks (zero if track was deleted).
+  G4double ApplyToSecondary(G4Track* sec, G4double weight, G4double importance,
+			    std::vector<G4Track*>& tracks) const;
+
+  // Apply window to current track after ParticleChange has been filled:
+  // kills the track, changes its weight, or adds copies as secondaries.
+  // Copies take proposed time, position and direction from ParticleChange.
+  void ApplyToTrack(const G4Track& track, G4double importance,
+		    G4ParticleChange& particleChange) const;
+
+  // Copy of phonon track with its wavevector and kinematics, optionally
+  // at a different time and position (e.g., proposed by a process)
+  static G4Track* CopyPhonon(const G4Track& track);
+  static G4Track* CopyPhonon(const G4Track& track, G4double time,
+			     const G4ThreeVector& pos);
+
+private:
+  struct Table {
+    std::vector<G4double> x, y;
+    void Add(G4double xval, G4double yval);
+    G4double Interpolate(G4double xval) const;
+  };
+
+  Table energyImp;
+  Table timeImp;
+  Table posImp[3];
+
+  G4double refWeight;		// Weight at importance one
+  G4double ratio;		// Ratio of upper to lower bounds of window
+  G4int maxSplit;		// Limit on copies to bound track count
+};
+
+#endif	/* G4CMPPhononWeightWindow_hh */
@@ -0,0 +1,70 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPRateTable.hh
+/// \brief Definition of the G4CMPRateTable class.  This class holds a
+///	   lookup table of scattering rate vs. a single non-negative
+///	   variable (kinetic energy, field magnitude, etc.), filled from a
+///	   rate function to a specified relative interpolation accuracy.
+///	   Used by G4CMPVScatteringRate subclasses to avoid repeating
+///	   expensive rate calculations on every step.
+//
+// $Id$
+//
+// 20261016  New class for tabulated scattering rates.
+
+#ifndef G4CMPRateTable_hh
+#define G4CMPRateTable_hh 1
+
+#include "globals.hh"
+#include <functional>
+#include <vector>
+
+
+class G4CMPRateTable {
+public:
+  G4CMPRateTable() : xmax(0.), maxError(0.) {;}
+  virtual ~G4CMPRateTable() {;}
+
+  // Tabulate f(x) for 0 <= x <= xmax.  Function may turn on as sqrt(x-edge)
+  // at the listed edges (energy thresholds); between edges the grid is
+  // uniform in sqrt(x-edge), so that f is smooth in the table variable.
+  // Grid is refined until linear interpolation matches f at every interval
+  // midpoint to relative accuracy tol.  Returns false if that can't be done.
+  G4bool Fill(const std::function<G4double(G4double)>& f, G4double xmax,
+	      G4double tol,
+	      const std::vector<G4double>& edges=std::vector<G4double>());
+
+  void Clear();
+
+  G4bool IsFilled() const { return !segments.empty(); }
+  G4bool InRange(G4double x) const {
+    return (IsFilled() && x >= 0. && x <= xmax);
+  }
+
+  // Interpolated value; x must be InRange()
+  G4double Value(G4double x) const;
+
+  G4double GetMaxX() const { return xmax; }
+  G4double GetMaxError() const { return maxError; }	// Found in Fill()
+  size_t GetNumberOfPoints() const;
+
+private:
+  // Grid of values between edges, uniform in sqrt(x-x0)
+  struct Segment {
+    G4double x0;		// Start of segment
+    G4double invDu;		// Inverse grid spacing in sqrt(x-x0)
+    std::vector<G4double> y;	// Values at grid points
+  };
+
+  G4bool FillSegment(Segment& seg, const std::function<G4double(G4double)>& f,
+		     G4double x0, G4double x1, G4double tol);
+
+  std::vector<Segment> segments;
+  G4double xmax;
+  G4double maxError;		// Largest relative error at midpoints
+};
+
+#endif	/* G4CMPRateTable_hh */
@@ -23,6 +23,8 @@
 // 20250424  G4CMP-465 -- Create G4CMPSolidUtils class.
 // 20250429  G4CMP-461 -- Add function for skipping detector flats.
 // 20250430  N. Tenpas -- Add function for getting distance to bounding box.
+// 20261016  Move surface displacement walk here; add analytic Box/Tubs walk.
+// 20261016  Remove TubsCapWalk(); end caps use generic SurfaceWalk().
 
 #ifndef G4CMPSolidUtils_hh
 #define G4CMPSolidUtils_hh 1
@@ -31,6 +33,7 @@
 #include "G4AffineTransform.hh"
 #include "G4RotationMatrix.hh"
 #include "G4ThreeVector.hh"
+#include <functional>
 
 class G4VSolid;
 class G4VTouchable;
@@ -156,6 +159,30 @@ class G4CMPSolidUtils {
     G4double GetDistToBB(const G4ThreeVector pos,
                          const G4ThreeVector vTan) const;
 
+    // Acceptance test to end surface displacement: wavevector, surface
+    // normal and surface position, all in the local frame of the solid
+    typedef std::function<G4bool(const G4ThreeVector& k,
+                                 const G4ThreeVector& norm,
+                                 const G4ThreeVector& pos)> SurfaceTest;
+
+    // Displace k along the surface, keeping its normal component fixed,
+    // until test() passes or nStepLimit steps have been taken.  Modifies
+    // pos, surfNorm and k in place; returns number of steps taken.
+    // pos, surfNorm and k must be in the global coordinate system
+    G4int SurfaceWalk(G4ThreeVector& pos, G4ThreeVector& surfNorm,
+                      G4ThreeVector& k, G4double stepSize, G4int nStepLimit,
+                      const SurfaceTest& test);
+
+    // Same displacement computed in closed form on the faces of a G4Box,
+    // or on the side of a solid G4Tubs (no inner radius or phi segment).
+    // Returns false, leaving arguments unchanged, if the solid or start
+    // point isn't handled (including G4Tubs end caps)
+    // pos, surfNorm and k must be in the global coordinate system
+    G4bool AnalyticSurfaceWalk(G4ThreeVector& pos, G4ThreeVector& surfNorm,
+                               G4ThreeVector& k, G4double stepSize,
+                               G4int nStepLimit, const SurfaceTest& test,
+                               G4int& nSteps) const;
+
     // Internal transformations
     void TransformLocalToGlobal(G4ThreeVector& point, G4ThreeVector& dir) const;
     void TransformGlobalToLocal(G4ThreeVector& point, G4ThreeVector& dir) const;
@@ -188,6 +215,16 @@ class G4CMPSolidUtils {
       return globalDir;
     }
 
+  private:
+    // Closed form walks for AnalyticSurfaceWalk(), all in local frame
+    G4bool BoxSurfaceWalk(G4ThreeVector& pos, G4ThreeVector& surfNorm,
+                          G4ThreeVector& k, G4double stepSize, G4int nStepLimit,
+                          const SurfaceTest& test, G4int& nSteps) const;
+
+    G4bool TubsSideWalk(G4ThreeVector& pos, G4ThreeVector& surfNorm,
+                        G4ThreeVector& k, G4double stepSize, G4int nStepLimit,
+                        const SurfaceTest& test, G4int& nSteps) const;
+
   private:
     const G4VSolid* theSolid;
     G4AffineTransform theTransform;
@@ -11,6 +11,9 @@
 // 20170525  M. Kelsey -- Add default "rule of five" copy/move operators
 // 20211001  M. Kelsey -- Remove electron energy adjustment; set mass instead.
 //		Assign electron valley nearest to momentum direction.
+// 20261016  Add fast charge transport, replacing tracking of charges.
+// 20261016  Add Russian roulette for phonons with weight window.
+// 20261016  Track fast charges normally if they stall before the surface.
 
 #ifndef G4CMPStackingAction_h
 #define G4CMPStackingAction_h 1
@@ -18,7 +21,9 @@
 #include "globals.hh"
 #include "G4UserStackingAction.hh"
 #include "G4CMPProcessUtils.hh"
+#include <memory>
 
+class G4CMPFastChargeTransport;
 class G4Track;
 
 class G4CMPStackingAction
@@ -29,12 +34,31 @@ public:
 
 public:
   virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* aTrack);
+  virtual void PrepareNewEvent();
+
+  // Induced signals from charges in fast mode (null if not used)
+  const G4CMPFastChargeTransport* GetFastChargeTransport() const {
+    return fastCharges.get();
+  }
 
 protected:
   void SetPhononVelocity(const G4Track* theTrack) const;
   void AssignNearestValley(const G4Track* aTrack) const;
   void SetChargeCarrierMass(const G4Track* theTrack) const;
 
+  // Apply roulette from G4CMPConfigManager::GetPhononWeightWindow();
+  // returns false if phonon should be killed
+  G4bool RoulettePhonon(const G4Track* aTrack) const;
+
+  // Drift charge to surface and record electrode hit; returns false
+  // if the charge must be tracked normally (e.g., no drift table).  A
+  // charge which stalls before the surface is moved to where it stopped,
+  // and returns false to be tracked from there.
+  G4bool TransportFastCharge(const G4Track* aTrack);
+
+  std::shared_ptr<G4CMPFastChargeTransport> fastCharges;
+  G4bool stallWarned;		// Report only first stalled fast charge
+
 public:
   G4CMPStackingAction(const G4CMPStackingAction&) = default;
   G4CMPStackingAction(G4CMPStackingAction&&) = default;
@@ -11,6 +11,8 @@
 // 20190806  M. Kelsey -- Add local data for frequency-dependent scattering
 //		probabilities, and computation functions.
 // 20200601  G4CMP-206: Need thread-local copies of electrode pointers
+// 20261016  Copy table entries into flat records for boundary processes;
+//		add ReflectionProbs() to evaluate all polynomials at once.
 
 #ifndef G4CMPSurfaceProperty_h
 #define G4CMPSurfaceProperty_h 1
@@ -26,6 +28,17 @@ class G4CMPVElectrodePattern;
 
 class G4CMPSurfaceProperty : public G4SurfaceProperty {
 public:
+  // Boundary parameters copied from property tables, for use at each step
+  struct BoundaryParams {
+    G4bool valid;		// All required entries were found in table
+    G4double absProb;		// Probability to absorb
+    G4double reflProb;		// If not absorbed, probability to reflect
+    G4double specProb;		// Phonons: probability of specular reflection
+    G4double absMinK;		// Phonons: minimum wave number to absorb
+    G4double minKElec;		// Charges: minimum wave number to absorb e-
+    G4double minKHole;		// Charges: minimum wave number to absorb h+
+  };
+
   // Empty constructor. Users must call at least one of the FillPropertiesTable
   // member functions. But, really, you shouldn't use this. It's dangerous and
   // I don't know why I put it here at all.
@@ -71,6 +84,17 @@ public:
   G4MaterialPropertiesTable
   GetPhononMaterialPropertiesTable() const { return thePhononMatPropTable; }
 
+  // Boundary parameters without string lookups; see UpdateParameters()
+  const BoundaryParams& GetChargeParameters() const { return chargeParams; }
+  const BoundaryParams& GetPhononParameters() const { return phononParams; }
+
+  // Copy table entries into BoundaryParams.  Called by Set/Fill functions
+  // below, and for all surfaces at start of run (UpdateAllParameters).
+  // NOTE:  Must be called again if tables are modified through pointers
+  //        after the run has started.
+  void UpdateParameters();
+  static void UpdateAllParameters();
+
   // Accessors to fill charge-pair and phonon boundary parameters
   void SetChargeMaterialPropertiesTable(G4MaterialPropertiesTable *mpt);
   void SetPhononMaterialPropertiesTable(G4MaterialPropertiesTable *mpt);
@@ -108,6 +132,11 @@ public:
   G4double DiffuseReflProb(G4double freq) const;
   G4double SpecularReflProb(G4double freq) const;
 
+  // Compute all three reflection probabilities, evaluating each polynomial
+  // once; same results as individual functions above
+  void ReflectionProbs(G4double freq, G4double& specProb,
+		       G4double& diffuseProb, G4double& anharmonicProb) const;
+
   // Complex electrode geometries
   void SetChargeElectrode(G4CMPVElectrodePattern* cel);
   void SetPhononElectrode(G4CMPVElectrodePattern* pel);
@@ -134,10 +163,17 @@ protected:
 
   G4double ExpandCoeffsPoly(G4double freq, const std::vector<G4double>& coeff) const;
 
+  // Look up property, returning false (and leaving value unset) if missing
+  G4bool CopyProperty(G4MaterialPropertiesTable& propTab, const char* key,
+		      G4double& value) const;
+
 protected:
   G4MaterialPropertiesTable theChargeMatPropTable;
   G4MaterialPropertiesTable thePhononMatPropTable;
 
+  BoundaryParams chargeParams;		// Filled from tables above
+  BoundaryParams phononParams;
+
   G4CMPVElectrodePattern* theChargeElectrode;
   G4CMPVElectrodePattern* thePhononElectrode;
 
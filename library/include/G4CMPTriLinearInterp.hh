@@ -20,15 +20,29 @@
 // 20200908  Replace four-arg ctor and UseMesh() with copy constructor.
 // 20200914  Include gradient precalculation in BuildTInverse action.
 // 20240921  Make FirstInteriorTetra() virtual for use with Initialize()
+// 20261016  Move mesh tables to shared, read-only block; Clone() no longer
+//		duplicates tables for each worker thread.
+// 20261016  Add uniform grid index to seed FindTetrahedron() searches.
+// 20261016  Pack per-tetrahedron search data into aligned TetraRecord, drop
+//		TExtend table; renumber tetrahedra along Z-order curve.
+// 20261016  Add binary cache of mesh tables, to skip Qhull on reloading.
+// 20261016  Add GetValues(), GetGradValues() for multiple value sets.
+// 20261016  Add EvaluateBatch() for arrays of points.
+// 20261016  Drop Tetra012..Tetra123 tables, FindNeighbor(), FindTetraID().
+// 20261016  Add GetMeshBounds(), IsInside() for regular-grid field cache.
+// 20261016  Store TetraRecord::good as a byte, read directly from cache.
 
 #ifndef G4CMPTriLinearInterp_h 
 #define G4CMPTriLinearInterp_h 
 
 #include "G4CMPVMeshInterpolator.hh"
+#include "G4CMPAlignedAllocator.hh"
 #include "G4ThreeVector.hh"
 #include <vector>
 #include <map>
+#include <memory>
 #include <array>
+#include <cstdint>
 
 // Convenient abbreviations, available to subclasses and client code
 using mat3x3 = std::array<std::array<G4double,3>,3>;
@@ -65,9 +79,34 @@ public:
   G4double GetValue(const G4double pos[], G4bool quiet=false) const;
   G4ThreeVector GetGrad(const G4double pos[], G4bool quiet=false) const;
 
+  // Evaluate all value sets (see AddValues()) with one search
+  void GetValues(const G4double pos[], G4double values[],
+		 G4bool quiet=false) const;
+  G4ThreeVector GetGradValues(const G4double pos[], G4double values[],
+			      G4bool quiet=false) const;
+
+  // Evaluate array of points, see G4CMPVMeshInterpolator for layout
+  void EvaluateBatch(size_t npts, const G4double pos[], G4double values[],
+		     G4ThreeVector grads[], G4bool quiet=false) const;
+
   void SavePoints(const G4String& fname) const;
   void SaveTetra(const G4String& fname) const;
 
+  // Check whether coordinates are identical (e.g., for AddValues())
+  G4bool SameMeshPoints(const std::vector<point3d>& xyz) const;
+
+  // Bounding box of mesh points, for resampling onto another grid
+  void GetMeshBounds(G4double xmin[3], G4double xmax[3]) const;
+
+  // Test for point inside hull; leaves TetraIdx() ready for GetGrad()
+  G4bool IsInside(const G4double pos[3]) const;
+
+  // Binary copy of all tables, to reload without triangulation; "key"
+  // identifies source of mesh (e.g., file hash), and must match on load
+  // NOTE: Only primary value set is saved, not AddValues() sets
+  G4bool SaveMeshCache(const G4String& fname, std::uint64_t key) const;
+  G4bool LoadMeshCache(const G4String& fname, std::uint64_t key);
+
 protected:
   void FillGradients();		// Compute gradient (field) at each tetrahedron
 
@@ -75,39 +114,59 @@ protected:
   virtual G4int FirstInteriorTetra() const;
 
 private:
-  std::vector<point3d> X;
-  std::vector<tetra3d> Tetrahedra;
-  std::vector<tetra3d> Neighbors;
-  std::vector<mat3x3> TInverse;		// Matrix for barycenter calculation
-  std::vector<mat4x3> TExtend;		// Matrix for gradient calculation
-  std::vector<G4bool> TInvGood;		// Flags for noninvertible matrix
+  // Everything needed for one step of FindTetrahedron(), packed together
+  // so that each step touches only the two cache lines of one record
+  struct alignas(64) TetraRecord {
+    mat3x3 invT;			// Matrix for barycenter calculation
+    point3d X3;				// Reference vertex (tetra[3]) for invT
+    tetra3d neighbors;			// Tetrahedra opposite each vertex
+    std::uint8_t good;			// Flag for noninvertible matrix (0 or 1)
+  };
+
+  using RecordTable = std::vector<TetraRecord,
+				  G4CMPAlignedAllocator<TetraRecord> >;
+
+  // Mesh coordinates and derived tables are filled once, then shared
+  // read-only by all clones (e.g., per-thread copies of field).
+  struct MeshTables {
+    std::vector<point3d> X;
+    std::vector<tetra3d> Tetrahedra;	// Vertex indices, for values
+    RecordTable Records;		// Search data for each tetrahedron
+
+    // Uniform grid over mesh bounding box, used to seed tetrahedral search
+    point3d GridMin{{0.,0.,0.}};	// Lower corner of grid
+    point3d GridStep{{1.,1.,1.}};	// Cell dimensions
+    std::array<G4int,3> GridN{{0,0,0}};	// Number of cells along each axis
+    std::vector<G4int> GridSeed;	// Tetrahedron in cell, -1 if outside
+  };
+
+  std::shared_ptr<const MeshTables> Mesh;
 
   mutable std::map<G4int,G4int> qhull2x;	// Used by QHull for meshing
 
-  // Lists of tetrahedra with shared vertices, for generating neighbors table
-  std::vector<tetra3d> Tetra012;	// Duplicate tetrahedra lists
-  std::vector<tetra3d> Tetra013;	// Sorted on vertex triplets
-  std::vector<tetra3d> Tetra023;
-  std::vector<tetra3d> Tetra123;
-
-  void BuildTetraMesh();	// Builds mesh from pre-initialized 'X' array
-  void FillNeighbors();		// Generate Neighbors table from tetrahedra
-  void FillTInverse();		// Compute inverse matrices for Cart2Bary()
-
-  // Function pointer for comparison operator to use search for facets
-  using TetraComp = G4bool(*)(const tetra3d&, const tetra3d&);
-
-  G4int FindNeighbor(const std::array<G4int,3>& facet, G4int skip) const;
-  G4int FindTetraID(const std::vector<tetra3d>& tetras,
-		    const tetra3d& wildTetra, G4int skip,
-		    TetraComp tLess) const;
+  // Table construction, operating on new (not yet shared) mesh block
+  // Neighbors table is only used during construction, then in Records
+  void BuildTetraMesh(MeshTables& mesh,		// Needs pre-initialized 'X'
+		      std::vector<tetra3d>& neighbors) const;
+  void FillNeighbors(MeshTables& mesh,		// Generate Neighbors table
+		     std::vector<tetra3d>& neighbors) const;
+  void SortTetrahedra(MeshTables& mesh,		// Put neighbors close together
+		      std::vector<tetra3d>& neighbors) const;
+  void FillRecords(MeshTables& mesh,		// Inverse matrices for Cart2Bary
+		   const std::vector<tetra3d>& neighbors) const;
+  void FillSeedGrid(MeshTables& mesh) const;	// Spatial index for searches
 
   void FindTetrahedron(const G4double point[3], G4double bary[4],
 		       G4bool quiet=false) const;
-  G4int FindPointID(const std::vector<G4double>& point, const G4int id) const;
+  G4int FindSeedTetra(const G4double point[3]) const;	// -1 if outside hull
+  G4int FindPointID(const std::vector<point3d>& X,
+		    const std::vector<G4double>& point, const G4int id) const;
+
+  // Interpolate all value sets in current TetraIdx(), or zero if none
+  void FillValues(const G4double bary[4], G4double values[]) const;
 
   G4bool Cart2Bary(const G4double point[3], G4double bary[4]) const;
-  G4bool BuildT4x3(size_t itet, mat4x3& ET) const;
+  void BuildT4x3(const mat3x3& invT, mat4x3& ET) const;
 
   G4bool MatInv(const mat3x3& matrix, mat3x3& result, G4bool quiet=false) const;
   G4double BaryNorm(G4double bary[4]) const;
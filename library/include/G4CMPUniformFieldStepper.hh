@@ -0,0 +1,66 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// $Id$
+//
+// Analytic stepper for charge carriers in a uniform electric field.  With
+// G4CMPEqEMField the rate of change of momentum with time is constant, for
+// both electrons (Herring-Vogt force in a fixed valley) and holes, so the
+// momentum at time t is p0 + F*t.  Position and path length are integrals
+// of the velocity in t, done by Gauss-Legendre quadrature on segments where
+// the integrands are smooth; the time to travel the requested path length
+// is found by Newton iteration.  No error estimate is needed, so the driver
+// takes each step in one go.
+//
+// 20261016  New class, selected by G4CMPFieldManager for uniform fields
+
+#ifndef G4CMPUniformFieldStepper_hh
+#define G4CMPUniformFieldStepper_hh 1
+
+#include "G4MagIntegratorStepper.hh"
+#include "G4ThreeVector.hh"
+
+class G4CMPEqEMField;
+
+
+class G4CMPUniformFieldStepper : public G4MagIntegratorStepper {
+public:
+  G4CMPUniformFieldStepper(G4CMPEqEMField* eqMotion, G4int nvar=8);
+  virtual ~G4CMPUniformFieldStepper() {;}
+
+  // Advance position, momentum and time by path length h
+  virtual void Stepper(const G4double y[], const G4double dydx[],
+		       G4double h, G4double yout[], G4double yerr[]);
+
+  // Distance between chord and trajectory at middle of last step
+  virtual G4double DistChord() const;
+
+  virtual G4int IntegratorOrder() const { return 4; }
+
+protected:
+  // Displacement and path length after time t from current start point
+  void Advance(G4double t, G4ThreeVector& dx, G4double& length) const;
+
+  // Pieces of the integral in Advance()
+  void IntegrateGraded(G4double tturn, G4double xlo, G4double xhi,
+		       G4double delta, G4double side, G4ThreeVector& dx,
+		       G4double& length) const;
+  void Integrate(G4double t0, G4double t1, G4ThreeVector& dx,
+		 G4double& length) const;
+
+  // Velocity at time t after start point
+  G4ThreeVector Velocity(G4double t) const;
+
+private:
+  const G4CMPEqEMField* theEquation;
+
+  G4ThreeVector x0;		// Start of most recent step
+  G4ThreeVector p0;
+  G4ThreeVector force;		// Constant dp/dt
+  G4double tstep;		// Duration of most recent step
+  G4ThreeVector xend;		// End of most recent step
+};
+
+#endif	/* G4CMPUniformFieldStepper_hh */
@@ -21,6 +21,7 @@
 // 20250422  G4CMP-468 -- Add position argument to PhononVelocityIsInward
 // 20250423  G4CMP-468 -- Add function to get diffuse reflection vector
 // 20250510  G4CMP-483 -- Ensure backwards compatibility for vector utilities.
+// 20261016  Add LambertReflection() with random values supplied by caller
 
 #ifndef G4CMPUtils_hh
 #define G4CMPUtils_hh 1
@@ -93,6 +94,10 @@ namespace G4CMP {
                                     const G4ThreeVector& surfPoint);
   G4ThreeVector LambertReflection(const G4ThreeVector& surfNorm);
 
+  // Diffuse reflection for given uniform random values u1 (phi), u2 (theta)
+  G4ThreeVector LambertReflection(const G4ThreeVector& surfNorm,
+                                  G4double u1, G4double u2);
+
   // Test that a phonon's wave vector relates to an inward velocity.
   // waveVector, surfNorm, and surfacePos need to be in global coordinates
   G4bool PhononVelocityIsInward(const G4LatticePhysical* lattice, G4int mode,
@@ -17,6 +17,10 @@
 // 20240920  Replace TetraIdx data member with function to reference cache.
 // 20240921  Add new Initialize() function to ensure that per-thread TetraIdx
 //		is set properly.
+// 20261016  Values and gradients held via shared_ptr, shared between clones.
+// 20261016  Support additional value sets on one mesh, evaluated together.
+// 20261016  Add EvaluateBatch() for arrays of points, visited in Z-order.
+// 20261016  Add ParallelFor() to split table construction across threads.
 
 #ifndef G4CMPVMeshInterpolator_h 
 #define G4CMPVMeshInterpolator_h 
@@ -25,6 +29,9 @@
 #include "G4Cache.hh"
 #include "G4ThreeVector.hh"
 #include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 
 // Convenient abbreviations, available to subclasses and client code
@@ -38,7 +45,7 @@ class G4CMPVMeshInterpolator {
 protected:
   // This class CANNOT be instantiated directly!
   G4CMPVMeshInterpolator(const G4String& prefix)
-    : TetraStart(-1), savePrefix(prefix) {;}
+    : NExtra(0), TetraStart(-1), savePrefix(prefix) {;}
 
 public:
   virtual ~G4CMPVMeshInterpolator() {;}
@@ -50,6 +57,13 @@ public:
   // Replace values at mesh points without rebuilding tables
   void UseValues(const std::vector<G4double>& v);
 
+  // Add another set of values on the same mesh (e.g., weighting potentials)
+  // Returns index of new set for GetValues(), or -1 if size doesn't match
+  G4int AddValues(const std::vector<G4double>& v);
+
+  // Number of value sets, including primary (UseMesh, UseValues) set
+  G4int GetNumberOfValueSets() const { return V ? 1+NExtra : 0; }
+
   // Subclasses MUST implement these functions for their dimensionality
 
   // Replace existing mesh vectors and tetrahedra table
@@ -69,6 +83,24 @@ public:
   virtual G4double GetValue(const G4double pos[], G4bool quiet=false) const = 0;
   virtual G4ThreeVector GetGrad(const G4double pos[], G4bool quiet=false) const = 0;
 
+  // Evaluate all value sets with a single search; values[0] is primary set,
+  // and values[] must have GetNumberOfValueSets() entries
+  virtual void GetValues(const G4double pos[], G4double values[],
+			 G4bool quiet=false) const = 0;
+
+  // Gradient of primary set, and all value sets, with a single search
+  virtual G4ThreeVector GetGradValues(const G4double pos[], G4double values[],
+				      G4bool quiet=false) const = 0;
+
+  // Evaluate many points with one call; pos[] holds npts points of 3 (Tri)
+  // or 2 (Bi) coordinates.  Either output may be null.  values[] must have
+  // npts*GetNumberOfValueSets() entries, ordered by point; grads[] has the
+  // gradient of the primary set at each point.  Large batches spread over
+  // the mesh are searched in Z-order, to reuse cached parts of the mesh.
+  virtual void EvaluateBatch(size_t npts, const G4double pos[],
+			     G4double values[], G4ThreeVector grads[],
+			     G4bool quiet=false) const = 0;
+
   // Write out mesh coordinates and tetrahedra table to text files
   virtual void SavePoints(const G4String& fname) const = 0;
   virtual void SaveTetra(const G4String& fname) const = 0;
@@ -79,9 +111,38 @@ protected:
   // For initialization, find lowest tetra index with all facets shared
   virtual G4int FirstInteriorTetra() const = 0;	// Subclasses MUST implement
 
+  // Z-order (Morton) index of point scaled to unit square or cube (ndim)
+  static std::uint64_t MortonKey(const G4double u[], G4int ndim);
+
+  // Fill order[] with indices of pos[] (npts, ndim coords), grouped along
+  // Z-order curve if batch is large and sparse compared to mesh (nelem
+  // elements in box meshMin..meshMax); otherwise order is left unchanged.
+  static void SortPoints(size_t npts, const G4double pos[], G4int ndim,
+			 const G4double meshMin[], const G4double meshMax[],
+			 size_t nelem, std::vector<size_t>& order);
+
+  // Call body(begin,end) on contiguous chunks of [0,n), each at least
+  // "grain" long, from separate threads (G4CMPConfigManager::MeshThreads)
+  // NOTE: body must only write to its own range, and must not throw
+  static void ParallelFor(size_t n,
+			  const std::function<void(size_t,size_t)>& body,
+			  size_t grain=4096);
+
 protected:		// Data members available to subclasses directly
-  std::vector<G4double> V;		// Values at mesh points
-  std::vector<G4ThreeVector> Grad;	// Gradients across tetrahedra
+  // NOTE: Tables are read-only once filled, and are shared between clones.
+  //       Replacing values (UseValues) creates new tables for this instance.
+  using ValueTable = std::vector<G4double>;
+  using GradTable  = std::vector<G4ThreeVector>;
+
+  std::shared_ptr<const ValueTable> V;		// Values at mesh points
+  std::shared_ptr<const GradTable>  Grad;	// Gradients across tetrahedra
+
+  // Additional value sets are interleaved, VExtra[ipt*NExtra + iset], so
+  // all values at one mesh point are read together
+  std::shared_ptr<const ValueTable> VExtra;
+  G4int NExtra;
+
+  void ClearExtraValues() { VExtra.reset(); NExtra = 0; }
   // NOTE: Subclasses must define dimensional mesh coords and tetrahera
 
   G4int TetraStart;			// Start of tetrahedral searches
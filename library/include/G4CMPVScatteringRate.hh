@@ -14,6 +14,7 @@
 //
 // 20170815  Inherit from G4CMPProcessUtils here, instead of in subclasses
 // 20170919  Add "threshold finder" interface, for use with IV and Luke
+// 20261016  Add per-lattice rate tables for subclasses to use
 
 #ifndef G4CMPVScatteringRate_hh
 #define G4CMPVScatteringRate_hh 1
@@ -21,7 +22,13 @@
 #include "globals.hh"
 #include "G4CMPConfigManager.hh"
 #include "G4CMPProcessUtils.hh"
+#include "G4CMPRateTable.hh"
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
 
+class G4LatticeLogical;
 class G4Track;
 
 
@@ -53,10 +60,25 @@ public:
 
   const G4String& GetName() const { return name; }
 
+protected:
+  // Subclasses may tabulate a rate which depends on a single variable
+  // (energy, field magnitude) for 0 <= x <= xmax; see G4CMPRateTable.
+  // Table is filled once for the current lattice and RateTableTolerance,
+  // and reused afterward.
+  // Returns null if tabulation is disabled (RateTableTolerance is zero), or
+  // if the requested accuracy can't be reached.
+  const G4CMPRateTable*
+  TabulateRate(const std::function<G4double(G4double)>& rate, G4double xmax,
+	       const std::vector<G4double>& edges=std::vector<G4double>());
+
 protected:
   G4int verboseLevel;		// Accessible for use by subclasses
   G4String name;		// For diagnostic output if desired
   G4bool isForced;		// Flag 'true' if process should be forced
+
+private:
+  typedef std::pair<const G4LatticeLogical*, G4double> TableKey;
+  std::map<TableKey, G4CMPRateTable> rateTables;
 };
 
 #endif	/* G4CMPVScatteringRate_hh */
@@ -42,6 +42,10 @@
 //		(p_Q) and expectation value of momentum (p).
 // 20231017  E. Michaud -- Add 'AddValley(const G4ThreeVector&)' 
 // 20240510  E. Michhaud -- Add function to compute L0 from other parameters
+// 20261016  Fill K-Vg lookup table by theta rows on first use, not eagerly
+// 20261016  Restrict K-Vg lookup table to wedge allowed by crystal symmetry
+// 20261016  Add equal-area (Lambert) grid option for K-Vg lookup table
+// 20261016  Add optional charge drift table for fast charge transport
 
 #ifndef G4LatticeLogical_h
 #define G4LatticeLogical_h
@@ -51,9 +55,12 @@
 #include "G4ThreeVector.hh"
 #include "G4RotationMatrix.hh"
 #include "G4PhononPolarization.hh"
+#include <atomic>
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
+class G4CMPDriftTable;
 class G4CMPPhononKinematics;
 class G4CMPPhononKinTable;
 
@@ -86,6 +93,16 @@ public:
   // Dump structure in format compatible with reading back
   void Dump(std::ostream& os) const;
 
+  // Grid for K-Vg lookup table, "thetaPhi" (default) or "equalArea"
+  // Returns false if name is not recognized; must be set before Initialize()
+  G4bool SetKVGrid(const G4String& name);
+  G4String GetKVGrid() const;
+
+  // Drift speed and diffusion vs. field, for fast charge transport
+  // Returns false if file can't be read; table is shared by copies
+  G4bool SetDriftTable(const G4String& filename);
+  const G4CMPDriftTable* GetDriftTable() const { return fDriftTable.get(); }
+
   // Get group velocity magnitude, direction for input polarization and wavevector
   // NOTE:  Wavevector must be in lattice symmetry frame (X == symmetry axis)
   virtual G4ThreeVector MapKtoVg(G4int mode, const G4ThreeVector& k) const;
@@ -286,16 +303,29 @@ public:
 private:
   void CheckBasis();	// Initialize or complete (via cross) basis vectors
   void FillElasticity();	// Unpack reduced Cij into full Cijlk
-  void FillMaps();	// Populate lookup tables using kinematics calculator
+  void ClearMaps();	// Discard lookup tables, to be refilled on first use
+  void FillKVSymmetry();	// Choose lookup table wedge from elasticity tensor
   void FillMassInfo();	// Called from SetMassTensor() to compute derived forms
 
-  // Get theta, phi bins and offsets for interpolation
-  G4bool FindLookupBins(const G4ThreeVector& k, G4int& iTheta, G4int& iPhi,
-			G4double& dTheta, G4double& dPhi) const;
+  // Get row (theta or X), column (phi or Y) bins and offsets for interpolation
+  G4bool FindLookupBins(const G4ThreeVector& k, G4int& iRow, G4int& iCol,
+			G4double& dRow, G4double& dCol) const;
+
+  // Get unit wavevector at lookup table grid point
+  G4ThreeVector KVGridDirection(G4int iRow, G4int iCol) const;
 
   // Use lookup table to get group velocity for phonons
   G4ThreeVector LookupKtoVg(G4int mode, const G4ThreeVector& k) const;
 
+  // Map direction into lookup table wedge, kw[n] = sign[axis[n]]*k[axis[n]]
+  G4ThreeVector MapToKVWedge(const G4ThreeVector& k, G4int axis[3],
+			     G4double sign[3]) const;
+
+  // Get lookup table row, populating it if not yet filled
+  struct KVRow;
+  const KVRow& GetKVRow(G4int iRow) const;
+  void FillKVRow(G4int iRow, KVRow& row) const;
+
   // Use direct calculation to get group velocity for phonons
   G4ThreeVector ComputeKtoVg(G4int mode, const G4ThreeVector& k) const;
 
@@ -321,9 +351,21 @@ private:
   G4CMPPhononKinematics* fpPhononKin;	    // Kinematics calculator with tensor
   G4CMPPhononKinTable* fpPhononTable;	    // Kinematics interpolator
 
-  // map for group velocity vectors
+  // map for group velocity vectors, filled one row at a time when first
+  // needed; filled rows are read-only and shared by all threads.
+  // Table only covers wedge of directions not related by crystal symmetry.
+  // Rows and columns are either theta and phi, or X and Y of the Lambert
+  // equal-area projection (all bins subtend the same solid angle).
   enum { KVBINS=315 };			    // K-Vg lookup table binning
-  G4ThreeVector fKVMap[G4PhononPolarization::NUM_MODES][KVBINS][KVBINS];
+  enum KVSymmetry { KVInversion, KVOrthorhombic, KVTetragonal, KVCubic };
+  enum KVGrid { KVThetaPhi, KVEqualArea };
+  KVSymmetry fKVSymmetry;		    // Operations mapping k to wedge
+  KVGrid fKVGrid;			    // Coordinates for rows, columns
+  G4double fKVMin[2], fKVStep[2];	    // Range of wedge (row, column)
+  struct KVRow {
+    G4ThreeVector vg[G4PhononPolarization::NUM_MODES][KVBINS];
+  };
+  mutable std::atomic<KVRow*> fKVRows[KVBINS];
 
   G4double fA;       // Scaling constant for Anh.Dec. mean free path
   G4double fB;       // Scaling constant for Iso.Scat. mean free path
@@ -369,6 +411,9 @@ private:
   G4double fIVLinRate1;		 // Linear rate for linear scaled IV scat.
 
   G4String fIVModel;		 // Name of IV rate function to be used
+
+  G4String fDriftFile;		 // Drift table for fast charge transport
+  std::shared_ptr<const G4CMPDriftTable> fDriftTable;
 };
 
 // Write lattice structure to output stream
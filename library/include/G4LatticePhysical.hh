@@ -36,6 +36,7 @@
 // 20210919  M. Kelsey -- Allow SetVerboseLevel() from const instances.
 // 20220921  G4CMP-319 -- Add utilities for thermal (Maxwellian) distributions
 //		Also, add long missing accessors for Miller orientation
+// 20261016  Pass through drift table for fast charge transport
 
 #ifndef G4LatticePhysical_h
 #define G4LatticePhysical_h 1
@@ -166,6 +167,11 @@ public:
   // Parameters for electron intervalley scattering (Edelweiss, linear, matrix)
   const G4String& GetIVModel() const { return fLattice->GetIVModel(); }
 
+  // Drift speed and diffusion vs. field, for fast charge transport
+  const G4CMPDriftTable* GetDriftTable() const {
+    return fLattice->GetDriftTable();
+  }
+
   G4double GetIVQuadField() const    { return fLattice->GetIVQuadField(); }
   G4double GetIVQuadRate() const     { return fLattice->GetIVQuadRate(); }
   G4double GetIVQuadExponent() const { return fLattice->GetIVQuadExponent(); }
@@ -23,6 +23,7 @@
 // 20170810  Add utility function to process list of values with unit.
 // 20190704  Add utility function to process string/name argument
 // 20231102  Add ProcessValleyDirection()
+// 20261016  Add 'driftTable' file, found next to configuration file
 
 #ifndef G4LatticeReader_h
 #define G4LatticeReader_h 1
@@ -73,6 +74,9 @@ protected:
   G4bool ProcessThresholds();			// IV energy thresholds
   G4bool SkipComments();			// Everything after '#'
 
+  // Data file named in configuration, in same directory as configuration
+  G4String DataFilePath(const G4String& filename) const;
+
   // Read expected dimensions for value from file, return scale factor
   // NOTE: String from file may have leading "/" for inverse units
   // Input argument "unitcat" may be comma-delimited list of categories
@@ -95,6 +99,7 @@ private:
   G4String fUnitCat;		// ... G4UnitsCategory of dimensions
 
   G4String fDataDir;		// Directory path ($G4LATTICEDATA)
+  G4String fFilePath;		// Configuration file found by OpenFile()
   G4double mElectron;		// Electron mass in kilograms
 };
 
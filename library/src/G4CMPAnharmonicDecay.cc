@@ -9,9 +9,15 @@
 // 20220914  G4CMP-322 -- Address compiler warnings for unused arguments.
 // 20250101  G4CMP-440 -- Create separate debugging file per worker thread;
 //		add EventID column to debugging output.
+// 20261016  Apply phonon weight window to daughters; kill parent whenever
+//		decay happens, even if roulette keeps no daughters.
+// 20261016  Debugging energy check compares weighted energies, allowing
+//		for roulette, instead of being skipped with a weight window.
 
 #include "G4CMPAnharmonicDecay.hh"
+#include "G4CMPConfigManager.hh"
 #include "G4CMPPhononTrackInfo.hh"
+#include "G4CMPPhononWeightWindow.hh"
 #include "G4CMPSecondaryUtils.hh"
 #include "G4CMPTrackUtils.hh"
 #include "G4CMPUtils.hh"
@@ -34,7 +40,8 @@
 G4CMPAnharmonicDecay::G4CMPAnharmonicDecay(const G4VProcess* theProcess)
   : verboseLevel(theProcess?theProcess->GetVerboseLevel():0),
     procName(theProcess?theProcess->GetProcessName():"G4CMPAnharmonicDecay"),
-    fBeta(0.), fGamma(0.), fLambda(0.), fMu(0.), fvLvT(1.) {;}
+    fBeta(0.), fGamma(0.), fLambda(0.), fMu(0.), fvLvT(1.),
+    rouletteEnergy(0.) {;}
 
 void G4CMPAnharmonicDecay::DoDecay(const G4Track& aTrack, const G4Step&,
 				   G4ParticleChange& aParticleChange) {
@@ -65,8 +72,11 @@ void G4CMPAnharmonicDecay::DoDecay(const G4Track& aTrack, const G4Step&,
   //74% chance that daughter phonons are both transverse
   //26% Transverse and Longitudinal
   const G4double fracTT = theLattice->GetAnhTTFrac();
-  if (G4UniformRand() <= fracTT) MakeTTSecondaries(aTrack, aParticleChange);
-  else MakeLTSecondaries(aTrack, aParticleChange);
+  G4bool decayed = false;
+  if (G4UniformRand() <= fracTT)
+    decayed = MakeTTSecondaries(aTrack, aParticleChange);
+  else
+    decayed = MakeLTSecondaries(aTrack, aParticleChange);
 
 #ifdef G4CMP_DEBUG
   if (output.good()) {
@@ -77,18 +87,23 @@ void G4CMPAnharmonicDecay::DoDecay(const G4Track& aTrack, const G4Step&,
 #endif
 
   // Only kill the track if downconversion actually happened
-  if (aParticleChange.GetNumberOfSecondaries() > 0) {
+  if (decayed) {
     aParticleChange.ProposeEnergy(0.);
     aParticleChange.ProposeTrackStatus(fStopAndKill);
 
 #ifdef G4CMP_DEBUG
-    // Sanity check for energy conservation
-    G4double Edecay = (aParticleChange.GetSecondary(0)->GetKineticEnergy() +
-		       aParticleChange.GetSecondary(1)->GetKineticEnergy());
-    if (fabs(Edecay-aTrack.GetKineticEnergy()) > 1e-9) {
+    // Sanity check for energy conservation, weighted to include roulette
+    G4double Edecay = -rouletteEnergy;
+    for (G4int i=0; i<aParticleChange.GetNumberOfSecondaries(); i++) {
+      const G4Track* sec = aParticleChange.GetSecondary(i);
+      Edecay += sec->GetWeight() * sec->GetKineticEnergy();
+    }
+
+    G4double Etrack = aTrack.GetWeight() * aTrack.GetKineticEnergy();
+    if (fabs(Edecay-Etrack) > 1e-9*aTrack.GetWeight()) {
       G4ExceptionDescription msg;
-      msg << "Energy non-conservation: track " << aTrack.GetKineticEnergy()/eV
-	  << " eV, decay products " << Edecay/eV << " eV";
+      msg << "Energy non-conservation: track " << Etrack/eV
+	  << " eV, decay products " << Edecay/eV << " eV (weighted)";
 
       G4Exception(procName.c_str(), "Downconv001", JustWarning, msg);
     }
@@ -150,7 +165,7 @@ G4double G4CMPAnharmonicDecay::MakeTTDeviation(G4double d, G4double x) const {
 
 //Generate daughter phonons from L->T+T process
 
-void G4CMPAnharmonicDecay::
+G4bool G4CMPAnharmonicDecay::
 MakeTTSecondaries(const G4Track& aTrack, G4ParticleChange& aParticleChange) {
   G4double upperBound=(1+(1/fvLvT))/2;
   G4double lowerBound=(1-(1/fvLvT))/2;
@@ -218,7 +233,7 @@ MakeTTSecondaries(const G4Track& aTrack, G4ParticleChange& aParticleChange) {
   if (!sec1 || !sec2) {
     G4Exception("G4CMPAnharmonicDecay::MakeTTSecondaries", "Downconv002",
 		JustWarning, "Error creating secondaries");
-    return;
+    return false;
   }
 
   // Pick which secondary gets the weight randomly
@@ -230,16 +245,15 @@ MakeTTSecondaries(const G4Track& aTrack, G4ParticleChange& aParticleChange) {
   }
 #endif
 
-  aParticleChange.SetNumberOfSecondaries(2);
-  aParticleChange.AddSecondary(sec2);
-  aParticleChange.AddSecondary(sec1);
+  AddSecondaries(aTrack, sec1, sec2, aParticleChange);
+  return true;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
 //Generate daughter phonons from L->L'+T process
 
-void G4CMPAnharmonicDecay::
+G4bool G4CMPAnharmonicDecay::
 MakeLTSecondaries(const G4Track& aTrack, G4ParticleChange& aParticleChange) {
   G4double upperBound=1;
   G4double lowerBound=(fvLvT-1)/(fvLvT+1);
@@ -291,7 +305,7 @@ MakeLTSecondaries(const G4Track& aTrack, G4ParticleChange& aParticleChange) {
   if (!sec1 || !sec2) {
     G4Exception("G4CMPAnharmonicDecay::MakeLTSecondaries", "Downconv003",
 		JustWarning, "Error creating secondaries");
-    return;
+    return false;
   }
 
 #ifdef G4CMP_DEBUG
@@ -301,9 +315,47 @@ MakeLTSecondaries(const G4Track& aTrack, G4ParticleChange& aParticleChange) {
   }
 #endif
 
-  aParticleChange.SetNumberOfSecondaries(2);
-  aParticleChange.AddSecondary(sec2);
-  aParticleChange.AddSecondary(sec1);
+  AddSecondaries(aTrack, sec1, sec2, aParticleChange);
+  return true;
 }
 
-//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo...
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+// Daughters are rouletted or split individually, using their own energy
+
+void G4CMPAnharmonicDecay::AddSecondaries(const G4Track& aTrack,
+					  G4Track* sec1, G4Track* sec2,
+					  G4ParticleChange& aParticleChange) {
+  const G4CMPPhononWeightWindow* window =
+    G4CMPConfigManager::GetPhononWeightWindow();
+
+  rouletteEnergy = 0.;
+
+  if (!window) {			// Daughters take parent's weight
+    aParticleChange.SetSecondaryWeightByProcess(false);
+    aParticleChange.SetNumberOfSecondaries(2);
+    aParticleChange.AddSecondary(sec2);
+    aParticleChange.AddSecondary(sec1);
+    return;
+  }
+
+  G4ThreeVector pos = GetLocalPosition(aTrack.GetPosition());
+  G4double time = aTrack.GetGlobalTime();
+  G4double weight = aTrack.GetWeight();
+
+  G4double E1 = sec1->GetKineticEnergy();
+  G4double E2 = sec2->GetKineticEnergy();
+  G4double imp1 = window->GetImportance(E1, time, pos);
+  G4double imp2 = window->GetImportance(E2, time, pos);
+
+  windowTracks.clear();
+  G4double wt2 = window->ApplyToSecondary(sec2, weight, imp2, windowTracks);
+  G4double wt1 = window->ApplyToSecondary(sec1, weight, imp1, windowTracks);
+
+  // Weighted energy gained or lost by roulette, for debugging check
+  rouletteEnergy = (wt1-weight)*E1 + (wt2-weight)*E2;
+
+  aParticleChange.SetSecondaryWeightByProcess(true);
+  aParticleChange.SetNumberOfSecondaries(windowTracks.size());
+  for (G4Track* sec: windowTracks) aParticleChange.AddSecondary(sec);
+}
@@ -17,10 +17,26 @@
 // 20200914  Include TExtend precalculation in FillTInverse action.
 // 20201002  Report tetrahedra errors during FillTInverse() initialization.
 // 20240920  G4CMP-244: Replace TetraIdx with function to access G4Cache.
+// 20261016  Build mesh tables into a new shared block, which is then used
+//		read-only; copy constructor shares tables instead of copying.
+// 20261016  Add uniform grid of seed triangles, to jump directly to the
+//		neighborhood of a new point, or to reject it as outside hull.
+// 20261016  Replace TInverse, TInvGood, Neighbors with aligned TetraRecord
+//		table; drop TExtend (only needed for gradients).  Renumber
+//		triangles along Z-order curve so neighbors share cache lines.
+// 20261016  Add GetValues(), GetGradValues() to interpolate all value
+//		sets with a single search.
+// 20261016  Add EvaluateBatch() to search array of points in Z-order;
+//		SortTetrahedra() uses Morton key from base class.
+// 20261016  Split FillNeighbors(), FillRecords(), FillGradients() loops
+//		across threads with ParallelFor().
+// 20261016  FillNeighbors() matches edges in per-vertex lists, replacing
+//		sorted Tetra01..Tetra12 tables, FindNeighbor(), FindTetraID().
 
 #include "G4CMPBiLinearInterp.hh"
 #include "G4CMPConfigManager.hh"
 #include <algorithm>
+#include <cstdint>
 #include <ctime>
 #include <fstream>
 #include <iostream>
@@ -43,22 +59,15 @@ G4CMPBiLinearInterp(const vector<point3d>& xyz, const vector<G4double>& v,
 		    const vector<tetra3d>& tetra)
   : G4CMPBiLinearInterp() { UseMesh(xyz, v, tetra); }
 
-// Copy constructor used by Clone() function
+// Copy constructor used by Clone() function; tables are shared, not copied
 
 G4CMPBiLinearInterp::G4CMPBiLinearInterp(const G4CMPBiLinearInterp& rhs)
   : G4CMPBiLinearInterp() {
-  X = rhs.X;
+  Mesh = rhs.Mesh;
   V = rhs.V;
   Grad = rhs.Grad;
-  Tetrahedra = rhs.Tetrahedra;
-  Neighbors = rhs.Neighbors;
-  TInverse = rhs.TInverse;
-  TInvGood = rhs.TInvGood;
-  TExtend  = rhs.TExtend;
-
-  Tetra01 = rhs.Tetra01;	// Not really needed, but for completeness
-  Tetra02 = rhs.Tetra02;
-  Tetra12 = rhs.Tetra12;
+  VExtra = rhs.VExtra;
+  NExtra = rhs.NExtra;
 
   TetraIdx() = -1;
   TetraStart = rhs.TetraStart;
@@ -70,12 +79,23 @@ G4CMPBiLinearInterp::G4CMPBiLinearInterp(const G4CMPBiLinearInterp& rhs)
 void G4CMPBiLinearInterp::UseMesh(const vector<point2d>& xy,
 				  const vector<G4double>& v,
 				  const vector<tetra2d>& tetra) {
-  X = xy;
-  V = v;
-  Tetrahedra = tetra;
-  FillNeighbors();
-  FillTInverse();
+  // Existing tables may be shared with clones; always build new ones
+  auto mesh = std::make_shared<MeshTables>();
+  mesh->X = xy;
+  mesh->Tetrahedra = tetra;
+
+  vector<tetra2d> neighbors;		// Only needed to fill Records
+  FillNeighbors(*mesh, neighbors);
+  SortTetrahedra(*mesh, neighbors);
+  FillRecords(*mesh, neighbors);
+  FillSeedGrid(*mesh);
+  Mesh = mesh;
+
+  V = std::make_shared<ValueTable>(v);
+  ClearExtraValues();
   FillGradients();
+
+  TetraStart = -1;
   Initialize();
 
 #ifdef G4CMPTLI_DEBUG
@@ -90,12 +110,23 @@ void G4CMPBiLinearInterp::UseMesh(const vector<point2d>& xy,
 void G4CMPBiLinearInterp::UseMesh(const vector<point3d>& xyz,
 				  const vector<G4double>& v,
 				  const vector<tetra3d>& tetra) {
-  Compress3DPoints(xyz);
-  Compress3DTetras(tetra);
-  V = v;
-  FillNeighbors();
-  FillTInverse();
+  // Existing tables may be shared with clones; always build new ones
+  auto mesh = std::make_shared<MeshTables>();
+  Compress3DPoints(*mesh, xyz);
+  Compress3DTetras(*mesh, tetra);
+
+  vector<tetra2d> neighbors;		// Only needed to fill Records
+  FillNeighbors(*mesh, neighbors);
+  SortTetrahedra(*mesh, neighbors);
+  FillRecords(*mesh, neighbors);
+  FillSeedGrid(*mesh);
+  Mesh = mesh;
+
+  V = std::make_shared<ValueTable>(v);
+  ClearExtraValues();
   FillGradients();
+
+  TetraStart = -1;
   Initialize();
 
 #ifdef G4CMPTLI_DEBUG
@@ -108,83 +139,114 @@ void G4CMPBiLinearInterp::UseMesh(const vector<point3d>& xyz,
 // Return index of tetrahedron with all edges shared, to start FindTetra()
 
 G4int G4CMPBiLinearInterp::FirstInteriorTetra() const {
-  G4int minIndex = Neighbors.size()/4;
+  const RecordTable& Records = Mesh->Records;	// For convenience
+
+  G4int minIndex = Records.size()/4;
 
-  for (G4int i=0; i<(G4int)Neighbors.size(); i++) {
-    if (*std::min_element(Neighbors[i].begin(), Neighbors[i].end())>minIndex)
+  for (G4int i=0; i<(G4int)Records.size(); i++) {
+    const tetra2d& neighbors = Records[i].neighbors;
+    if (*std::min_element(neighbors.begin(), neighbors.end())>minIndex)
       return i;
   }
 
-  return Neighbors.size()/2;
+  return Records.size()/2;
 }
 
 
 // Compress external 3D tables to 2D version (for client convenience)
 
-void G4CMPBiLinearInterp::Compress3DPoints(const std::vector<point3d>& xyz) {
-  X.clear();
-  X.resize(xyz.size());
+void G4CMPBiLinearInterp::Compress3DPoints(MeshTables& mesh,
+					   const vector<point3d>& xyz) const {
+  mesh.X.clear();
+  mesh.X.resize(xyz.size());
 
-  std::transform(xyz.begin(), xyz.end(), X.begin(),
+  std::transform(xyz.begin(), xyz.end(), mesh.X.begin(),
 		 [](const point3d& p3d){return point2d{p3d[0],p3d[1]};});
 }
 
-void G4CMPBiLinearInterp::Compress3DTetras(const std::vector<tetra3d>& tetra) {
-  Tetrahedra.clear();
-  Tetrahedra.resize(tetra.size());
+void G4CMPBiLinearInterp::Compress3DTetras(MeshTables& mesh,
+					   const vector<tetra3d>& tetra) const {
+  mesh.Tetrahedra.clear();
+  mesh.Tetrahedra.resize(tetra.size());
 
-  std::transform(tetra.begin(), tetra.end(), Tetrahedra.begin(),
+  std::transform(tetra.begin(), tetra.end(), mesh.Tetrahedra.begin(),
 		 [](const tetra3d& t3d){return tetra2d{t3d[0],t3d[1],t3d[2]};});
 }
 
 
-// Tetrahedra sort functions, labelled for each facet option
+// Process list of defined triangles and build table of neighbors.  Each
+// edge is filed under its lowest vertex, so the (at most two) triangles
+// sharing it are found together in one short list, without a global sort.
 
-namespace {
-  G4bool tLess01(const tetra2d& a, const tetra2d& b) {
-    return ( a[0]<b[0] || (a[0]==b[0] && a[1]<b[1]) );
-  }
-  
-  G4bool tLess02(const tetra2d& a, const tetra2d& b) {
-    return ( a[0]<b[0] || (a[0]==b[0] && a[2]<b[2]) );
-  }
-  
-  G4bool tLess12(const tetra2d& a, const tetra2d& b) {
-    return ( a[1]<b[1] || (a[1]==b[1] && a[2]<b[2]) );
-  }
-}
-
-// Process list of defined tetrahedra and build table of neighbors
+void G4CMPBiLinearInterp::FillNeighbors(MeshTables& mesh,
+					vector<tetra2d>& Neighbors) const {
+  vector<tetra2d>& Tetrahedra = mesh.Tetrahedra;	// For convenience below
 
-void G4CMPBiLinearInterp::FillNeighbors() {
   G4cout << "G4CMPBiLinearInterp::FillNeighbors (" << Tetrahedra.size()
 	 << " triangles)" << G4endl;
 
   time_t start, fin;
   std::time(&start);
 
-  // Put the tetrahedra vertices, then the whole list, in indexed order
-  for (auto& iTetra: Tetrahedra) sort(iTetra.begin(), iTetra.end());
-  sort(Tetrahedra.begin(), Tetrahedra.end());
-
-  // Duplicate list sorted on facets (triplets of vertices)
-  Tetra01 = Tetrahedra; sort(Tetra01.begin(), Tetra01.end(), tLess01);
-  Tetra02 = Tetrahedra; sort(Tetra02.begin(), Tetra02.end(), tLess02);
-  Tetra12 = Tetrahedra; sort(Tetra12.begin(), Tetra12.end(), tLess12);
+  // Put the triangle vertices in indexed order, so edges compare directly
+  ParallelFor(Tetrahedra.size(), [&Tetrahedra](size_t begin, size_t end) {
+      for (size_t i=begin; i<end; i++) {
+	sort(Tetrahedra[i].begin(), Tetrahedra[i].end());
+      }
+    });
 
   G4int Ntet = Tetrahedra.size();		// For convenience below
 
   Neighbors.clear();
   Neighbors.resize(Ntet, {{-1,-1,-1}});		// Pre-allocate space
 
-  // For each tetrahedron, find another which shares three corners
-  for (G4int i=0; i<Ntet; i++) {
-    const auto& iTet = Tetrahedra[i];
-    Neighbors[i][0] = FindNeighbor({{iTet[1],iTet[2]}}, i);
-    Neighbors[i][1] = FindNeighbor({{iTet[0],iTet[2]}}, i);
-    Neighbors[i][2] = FindNeighbor({{iTet[0],iTet[1]}}, i);
+  G4int Nvtx = 0;
+  for (const tetra2d& tetra: Tetrahedra) Nvtx = std::max(Nvtx, tetra[2]+1);
+
+  // Edge opposite vertex k of triangle i is labelled 3*i+k.  Its lowest
+  // vertex is tetra[0], except for the edge opposite tetra[0] itself.
+  vector<G4int> first(Nvtx+1, 0);		// Start of each vertex's list
+  for (const tetra2d& tetra: Tetrahedra) {
+    first[tetra[0]+1] += 2;
+    first[tetra[1]+1]++;
+  }
+  for (G4int v=0; v<Nvtx; v++) first[v+1] += first[v];
+
+  vector<G4int> edges(3*size_t(Ntet));
+  {
+    vector<G4int> next(first.begin(), first.end()-1);
+    for (G4int i=0; i<Ntet; i++) {
+      edges[next[Tetrahedra[i][1]]++] = 3*i;
+      for (G4int k=1; k<3; k++) edges[next[Tetrahedra[i][0]]++] = 3*i+k;
+    }
   }
 
+  // Other vertex of edge, for comparison within list
+  auto edgeKey = [&Tetrahedra](G4int edge) -> G4int {
+    return Tetrahedra[edge/3][edge%3==2 ? 1 : 2];
+  };
+
+  // Matching edges are adjacent once each (short) list is sorted
+  ParallelFor(Nvtx, [&](size_t begin, size_t end) {
+      vector<std::pair<G4int,G4int> > list;
+      for (size_t v=begin; v<end; v++) {
+	list.clear();
+	for (G4int j=first[v]; j<first[v+1]; j++) {
+	  list.emplace_back(edgeKey(edges[j]), edges[j]);
+	}
+	sort(list.begin(), list.end());
+
+	for (size_t j=1; j<list.size(); j++) {
+	  const G4int ea = list[j-1].second, eb = list[j].second;
+	  if (list[j].first != list[j-1].first || ea/3 == eb/3) continue;
+
+	  Neighbors[ea/3][ea%3] = eb/3;
+	  Neighbors[eb/3][eb%3] = ea/3;
+	  j++;				// Edge can only be shared once
+	}
+      }
+    });
+
   std::time(&fin);
   G4cout << "G4CMPBiLinearInterp::FillNeighbors: Took "
          << difftime(fin, start) << " seconds for " << Neighbors.size()
@@ -192,53 +254,70 @@ void G4CMPBiLinearInterp::FillNeighbors() {
 
 }
 
-// Locate other tetrahedron with specified face (excluding "skip" tetrahedron)
 
-G4int G4CMPBiLinearInterp::FindNeighbor(const array<G4int,2>& edge,
-					G4int skip) const {
-  G4int result = -1;
-  result = FindTetraID(Tetra12, {{-1,edge[0],edge[1]}}, skip, tLess12);
-  if (result >= 0) return result;	// Successful match
+// Renumber triangles along Z-order (Morton) curve of their centroids, so
+// that triangles close in space are close in memory during searches
 
-  result = FindTetraID(Tetra02, {{edge[0],-1,edge[1]}}, skip, tLess02);
-  if (result >= 0) return result;	// Successful match
+void G4CMPBiLinearInterp::SortTetrahedra(MeshTables& mesh,
+					 vector<tetra2d>& neighbors) const {
+  const vector<point2d>& X = mesh.X;		// For convenience below
+  vector<tetra2d>& Tetrahedra = mesh.Tetrahedra;
+  const size_t ntet = Tetrahedra.size();
+  if (ntet < 2 || X.empty()) return;
 
-  result = FindTetraID(Tetra01, {{edge[0],edge[1],-1}}, skip, tLess01);
-  return result;			// If this one failed, they all failed
-}
+  // Bounding box of mesh points, to scale centroids to unit square
+  point2d xmin = X[0], xmax = X[0];
+  for (const point2d& xi: X) {
+    for (G4int dim=0; dim<2; dim++) {
+      xmin[dim] = std::min(xmin[dim], xi[dim]);
+      xmax[dim] = std::max(xmax[dim], xi[dim]);
+    }
+  }
 
-// Locate other tetrahedron with given vertices (excluding "skip" tetrahedron)
-// "Wild" means that at least one vertex may be "-1", which matches anything
+  G4double scale[2];
+  for (G4int dim=0; dim<2; dim++) {
+    scale[dim] = (xmax[dim]>xmin[dim] ? 1./(xmax[dim]-xmin[dim]) : 0.);
+  }
 
-G4int G4CMPBiLinearInterp::
-FindTetraID(const vector<tetra2d>& tetras, const tetra2d& wildTetra, G4int skip,
-	    G4CMPBiLinearInterp::TetraComp tLess) const {
-  const auto start  = tetras.begin();
-  const auto finish = tetras.end();
+  vector<std::pair<uint64_t,G4int> > order(ntet);
+  G4double u[2];
+  for (size_t itet=0; itet<ntet; itet++) {
+    const tetra2d& tetra = Tetrahedra[itet];
+    for (G4int dim=0; dim<2; dim++) {
+      G4double c = (X[tetra[0]][dim] + X[tetra[1]][dim] + X[tetra[2]][dim])/3.;
+      u[dim] = (c-xmin[dim])*scale[dim];
+    }
+    order[itet] = std::make_pair(MortonKey(u, 2), G4int(itet));
+  }
 
-  // Shared edge (if any) will always be adjacent in sorted table
-  auto match = lower_bound(start, finish, wildTetra, tLess);
-  if (match == finish) return -1;		// No match at all? PROBLEM!
+  sort(order.begin(), order.end());
 
-  G4int index = (lower_bound(Tetrahedra.begin(),Tetrahedra.end(),*match)
-		 - Tetrahedra.begin());
-  if (index == skip) {				// Move to adjacent entry
-    if (match == finish-1) return -1;		// Nothing left to search
+  // Move triangles to new positions, and relabel neighbor indices
+  vector<G4int> newIndex(ntet);
+  for (size_t i=0; i<ntet; i++) newIndex[order[i].second] = i;
 
-    index = (lower_bound(Tetrahedra.begin(),Tetrahedra.end(),*(++match))
-	     - Tetrahedra.begin());
+  vector<tetra2d> newTetra(ntet), newNeighbors(ntet);
+  for (size_t i=0; i<ntet; i++) {
+    newTetra[i] = Tetrahedra[order[i].second];
+    newNeighbors[i] = neighbors[order[i].second];
+    for (G4int& n: newNeighbors[i]) if (n >= 0) n = newIndex[n];
   }
 
-  // Test for equality (not < nor >), return index or failure
-  return (!tLess(*match,wildTetra) && !tLess(wildTetra,*match)) ? index : -1;
+  Tetrahedra.swap(newTetra);
+  neighbors.swap(newNeighbors);
 }
 
+// Compute matrices used in tetrahedral barycentric coordinate calculation,
+// and pack with everything else FindTetrahedron() needs for each step
 
-// Compute matrices used in tetrahedral barycentric coordinate calculation
+void G4CMPBiLinearInterp::FillRecords(MeshTables& mesh,
+				      const vector<tetra2d>& neighbors) const {
+  const vector<point2d>& X = mesh.X;		// For convenience below
+  const vector<tetra2d>& Tetrahedra = mesh.Tetrahedra;
+  RecordTable& Records = mesh.Records;
 
-void G4CMPBiLinearInterp::FillTInverse() {
 #ifdef G4CMPTLI_DEBUG
-  G4cout << "G4CMPBiLinearInterp::FillTInverse (" << Tetrahedra.size()
+  G4cout << "G4CMPBiLinearInterp::FillRecords (" << Tetrahedra.size()
 	 << " tetrahedra)" << G4endl;
 
   time_t start, fin;
@@ -246,48 +325,188 @@ void G4CMPBiLinearInterp::FillTInverse() {
 #endif
 
   size_t ntet = Tetrahedra.size();
-  TInverse.resize(ntet);		    // Avoid reallocation inside loop
-  TExtend.resize(ntet);
-  TInvGood.resize(ntet, false);
+  Records.resize(ntet);			    // Avoid reallocation inside loop
+
+  ParallelFor(ntet, [&](size_t begin, size_t end) {
+      mat2x2 T;
+      for (size_t itet=begin; itet<end; itet++) {
+	const tetra2d& tetra = Tetrahedra[itet];  // For convenience below
+	TetraRecord& rec = Records[itet];
+#ifdef G4CMPTLI_DEBUG
+	if (G4CMPConfigManager::GetVerboseLevel() > 1) {
+	  G4cout << " Processing Tetrahedra[" << itet << "]: " << tetra
+		 << G4endl;
+	}
+#endif
+
+	for (G4int dim=0; dim<2; ++dim) {
+	  for (G4int vert=0; vert<2; ++vert) {
+	    T[dim][vert] = (X[tetra[vert]][dim] - X[tetra[2]][dim]);
+	  }
+	}
+
+	rec.good = MatInv(T, rec.invT, true);
+	rec.X2 = X[tetra[2]];
+	rec.neighbors = neighbors[itet];
+      }	// for (itet...
+    });
 
-  mat2x2 T;
+  // Report bad triangles after filling, so messages are not interleaved
   for (size_t itet=0; itet<ntet; itet++) {
+    if (Records[itet].good) continue;
+
     const tetra2d& tetra = Tetrahedra[itet];	// For convenience below
-#ifdef G4CMPTLI_DEBUG
-    if (G4CMPConfigManager::GetVerboseLevel() > 1) {
-      G4cout << " Processing Tetrahedra[" << itet << "]: " << tetra << G4endl;
+    G4cerr << "ERROR: Non-invertible matrix " << itet << " with " << G4endl;
+    for (G4int i=0; i<3; i++) {
+      G4cerr << " " << tetra[i] << " @ " << X[tetra[i]] << G4endl;
     }
+  }
+
+#ifdef G4CMPTLI_DEBUG
+  std::time(&fin);
+  G4cout << "G4CMPBiLinearInterp::FillRecords: Took "
+         << difftime(fin, start) << " seconds for " << Records.size()
+	 << " entries." << G4endl;
 #endif
+}
 
-    for (G4int dim=0; dim<2; ++dim) {
-      for (G4int vert=0; vert<2; ++vert) {
-	T[dim][vert] = (X[tetra[vert]][dim] - X[tetra[2]][dim]);
-      }
+
+// Build uniform grid over mesh, with a nearby triangle for each cell
+
+namespace {
+  // Convert coordinate to cell index along one axis, clamped to grid
+  inline G4int GridCell(G4double x, G4double xmin, G4double step, G4int n) {
+    return std::min(std::max(G4int((x-xmin)/step), 0), n-1);
+  }
+}
+
+void G4CMPBiLinearInterp::FillSeedGrid(MeshTables& mesh) const {
+  mesh.GridSeed.clear();
+  if (mesh.Tetrahedra.empty()) return;
+
+  const vector<point2d>& X = mesh.X;		// For convenience below
+  const vector<tetra2d>& Tetrahedra = mesh.Tetrahedra;
+
+  // Bounding box of mesh points
+  point2d xmax = X[0];
+  mesh.GridMin = X[0];
+  for (const point2d& xi: X) {
+    for (G4int dim=0; dim<2; dim++) {
+      mesh.GridMin[dim] = std::min(mesh.GridMin[dim], xi[dim]);
+      xmax[dim] = std::max(xmax[dim], xi[dim]);
+    }
+  }
+
+  // Choose roughly square cells, about one per mesh point
+  G4double maxExtent = std::max(xmax[0]-mesh.GridMin[0],
+				xmax[1]-mesh.GridMin[1]);
+
+  G4double area = 1.;
+  G4int ndim = 0;
+  for (G4int dim=0; dim<2; dim++) {
+    G4double extent = xmax[dim]-mesh.GridMin[dim];
+    if (extent > 1e-6*maxExtent) { area *= extent; ndim++; }
+  }
+
+  G4double cell = (ndim>0 ? std::pow(area/X.size(), 1./ndim) : 1.);
+
+  for (G4int dim=0; dim<2; dim++) {
+    G4double extent = xmax[dim]-mesh.GridMin[dim];
+    if (extent > 1e-6*maxExtent) {
+      mesh.GridN[dim] = std::max(1, G4int(std::ceil(extent/cell)));
+      mesh.GridStep[dim] = extent/mesh.GridN[dim];
+    } else {
+      mesh.GridN[dim] = 1;
+      mesh.GridStep[dim] = (extent>0. ? extent : 1.);
     }
+  }
+
+  const G4int nx = mesh.GridN[0], ny = mesh.GridN[1];
+  mesh.GridSeed.assign(nx*ny, -1);
+  vector<G4bool> centered(mesh.GridSeed.size(), false);
 
-    TInvGood[itet] = MatInv(T, TInverse[itet], true);
-    BuildT3x2(itet, TExtend[itet]);
+  // Each cell gets a triangle containing its center, if one exists,
+  // otherwise any triangle whose bounding box overlaps the cell
+  const G4double barySafety = -1e-10;	// Same tolerance as FindTetrahedron
+  G4int lo[2], hi[2];
+  for (size_t itet=0; itet<Tetrahedra.size(); itet++) {
+    const TetraRecord& rec = mesh.Records[itet];
+    if (!rec.good) continue;			// Unusable for searches
 
-    if (!TInvGood[itet]) {
-      G4cerr << "ERROR: Non-invertible matrix " << itet << " with " << G4endl;
-      for (G4int i=0; i<3; i++) {
-	G4cerr << " " << tetra[i] << " @ " << X[tetra[i]] << G4endl;
+    const tetra2d& tetra = Tetrahedra[itet];	// For convenience below
+    const mat2x2& invT = rec.invT;
+    const point2d& X2 = rec.X2;
+
+    for (G4int dim=0; dim<2; dim++) {
+      G4double tmin = X[tetra[0]][dim], tmax = tmin;
+      for (G4int vert=1; vert<3; vert++) {
+	tmin = std::min(tmin, X[tetra[vert]][dim]);
+	tmax = std::max(tmax, X[tetra[vert]][dim]);
       }
+      lo[dim] = GridCell(tmin, mesh.GridMin[dim], mesh.GridStep[dim],
+			 mesh.GridN[dim]);
+      hi[dim] = GridCell(tmax, mesh.GridMin[dim], mesh.GridStep[dim],
+			 mesh.GridN[dim]);
+    }
+
+    G4double center[2], bary[3];
+    for (G4int iy=lo[1]; iy<=hi[1]; iy++) {
+      center[1] = mesh.GridMin[1] + (iy+0.5)*mesh.GridStep[1] - X2[1];
+      for (G4int ix=lo[0]; ix<=hi[0]; ix++) {
+	G4int icell = ix + nx*iy;
+	if (centered[icell]) continue;
+
+	if (mesh.GridSeed[icell] < 0) mesh.GridSeed[icell] = itet;
+
+	center[0] = mesh.GridMin[0] + (ix+0.5)*mesh.GridStep[0] - X2[0];
+	bary[2] = 1.;
+	for (G4int k=0; k<2; k++) {
+	  bary[k] = invT[k][0]*center[0] + invT[k][1]*center[1];
+	  bary[2] -= bary[k];
+	}
+
+	if (std::all_of(bary, bary+3,
+			[barySafety](G4double b){return b>=barySafety;})) {
+	  mesh.GridSeed[icell] = itet;
+	  centered[icell] = true;
+	}
+      }	// for (ix...
     }
   }	// for (itet...
 
 #ifdef G4CMPTLI_DEBUG
-  std::time(&fin);
-  G4cout << "G4CMPBiLinearInterp::FillTInverse: Took "
-         << difftime(fin, start) << " seconds for " << TInverse.size()
-	 << " entries." << G4endl;
+  G4cout << "G4CMPBiLinearInterp::FillSeedGrid: " << nx << " x " << ny
+	 << " cells, " << std::count(centered.begin(), centered.end(), true)
+	 << " with centers inside mesh" << G4endl;
 #endif
 }
 
+// Look up seed triangle from grid; -1 means point is outside the hull
+
+G4int G4CMPBiLinearInterp::FindSeedTetra(const G4double pt[2]) const {
+  const MeshTables& mesh = *Mesh;		// For convenience below
+  if (mesh.GridSeed.empty()) return -1;
+
+  const G4double gridTol = 1e-6;	// Fraction of cell, for rounding errors
+
+  G4int icell[2];
+  for (G4int dim=0; dim<2; dim++) {
+    G4double u = (pt[dim]-mesh.GridMin[dim]) / mesh.GridStep[dim];
+    if (u < -gridTol || u > mesh.GridN[dim]+gridTol) return -1;
+    icell[dim] = std::min(std::max(G4int(u), 0), mesh.GridN[dim]-1);
+  }
+
+  return mesh.GridSeed[icell[0] + mesh.GridN[0]*icell[1]];
+}
+
 
 // Compute field (gradient) across each tetrahedron
 
 void G4CMPBiLinearInterp::FillGradients() {
+  const vector<tetra2d>& Tetrahedra = Mesh->Tetrahedra;	// For convenience
+  const RecordTable& Records = Mesh->Records;
+  const ValueTable& V = *(this->V);
+
 #ifdef G4CMPTLI_DEBUG
   G4cout << "G4CMPBiLinearInterp::FillGradients (" << Tetrahedra.size()
 	 << " tetrahedra)" << G4endl;
@@ -296,24 +515,29 @@ void G4CMPBiLinearInterp::FillGradients() {
   std::time(&start);
 #endif
 
+  // Existing gradients may be shared with clones; fill new table
   size_t ntet = Tetrahedra.size();
-  Grad.resize(ntet);		    // Avoid reallocation inside loop
-
-  for (size_t itet=0; itet<ntet; itet++) {
-    const tetra2d& tetra = Tetrahedra[itet];  // For convenience below
-    const mat3x2& ET = TExtend[itet];
-
-    Grad[itet].set((V[tetra[0]]*ET[0][0] + V[tetra[1]]*ET[1][0] +
-		    V[tetra[2]]*ET[2][0]),
-		   (V[tetra[0]]*ET[0][1] + V[tetra[1]]*ET[1][1] +
-		    V[tetra[2]]*ET[2][1]),
-		   0.);
+  auto grad = std::make_shared<GradTable>(ntet);
+  GradTable& Grad = *grad;
+
+  ParallelFor(ntet, [&](size_t begin, size_t end) {
+      mat3x2 ET;
+      for (size_t itet=begin; itet<end; itet++) {
+	const tetra2d& tetra = Tetrahedra[itet];  // For convenience below
+	BuildT3x2(Records[itet].invT, ET);
+
+	Grad[itet].set((V[tetra[0]]*ET[0][0] + V[tetra[1]]*ET[1][0] +
+			V[tetra[2]]*ET[2][0]),
+		       (V[tetra[0]]*ET[0][1] + V[tetra[1]]*ET[1][1] +
+			V[tetra[2]]*ET[2][1]),
+		       0.);
 #ifdef G4CMPTLI_DEBUG
-    if (G4CMPConfigManager::GetVerboseLevel() > 1) {
-      G4cout << " Computed Grad[" << itet << "]: " << Grad[itet] << G4endl;
-    }
+	if (G4CMPConfigManager::GetVerboseLevel() > 1) {
+	  G4cout << " Computed Grad[" << itet << "]: " << Grad[itet] << G4endl;
+	}
 #endif
-  }	// for (itet...
+      }	// for (itet...
+    });
 
 #ifdef G4CMPTLI_DEBUG
   std::time(&fin);
@@ -321,6 +545,8 @@ void G4CMPBiLinearInterp::FillGradients() {
          << difftime(fin, start) << " seconds for " << Grad.size()
 	 << " entries." << G4endl;
 #endif
+
+  this->Grad = grad;
 }
 
 
@@ -333,9 +559,11 @@ G4CMPBiLinearInterp::GetValue(const G4double pos[2], G4bool quiet) const {
     
   if (TetraIdx() == -1) return 0;
 
-  return(V[Tetrahedra[TetraIdx()][0]] * bary[0] +
-	 V[Tetrahedra[TetraIdx()][1]] * bary[1] +
-	 V[Tetrahedra[TetraIdx()][2]] * bary[2]);    
+  const tetra2d& tetra = Mesh->Tetrahedra[TetraIdx()];
+  const ValueTable& V = *(this->V);
+
+  return(V[tetra[0]] * bary[0] + V[tetra[1]] * bary[1] +
+	 V[tetra[2]] * bary[2]);
 }
 
 G4ThreeVector 
@@ -344,7 +572,78 @@ G4CMPBiLinearInterp::GetGrad(const G4double pos[2], G4bool quiet) const {
 
   G4double bary[3] = { 0. };
   FindTetrahedron(pos, bary, quiet);
-  return (TetraIdx()<0. ? zero : Grad[TetraIdx()]);
+  return (TetraIdx()<0. ? zero : (*Grad)[TetraIdx()]);
+}
+
+void G4CMPBiLinearInterp::GetValues(const G4double pos[2], G4double values[],
+				    G4bool quiet) const {
+  G4double bary[3] = { 0. };
+  FindTetrahedron(pos, bary, quiet);
+  FillValues(bary, values);
+}
+
+G4ThreeVector
+G4CMPBiLinearInterp::GetGradValues(const G4double pos[2], G4double values[],
+				   G4bool quiet) const {
+  static const G4ThreeVector zero(0.,0.,0.);	// For failure returns
+
+  G4double bary[3] = { 0. };
+  FindTetrahedron(pos, bary, quiet);
+  FillValues(bary, values);
+  return (TetraIdx()<0. ? zero : (*Grad)[TetraIdx()]);
+}
+
+// Evaluate many points without per-point virtual calls; large batches
+// spread over the mesh are visited along a Z-order curve
+
+void G4CMPBiLinearInterp::EvaluateBatch(size_t npts, const G4double pos[],
+					G4double values[],
+					G4ThreeVector grads[],
+					G4bool quiet) const {
+  static const G4ThreeVector zero(0.,0.,0.);	// For failure returns
+
+  const G4int nsets = GetNumberOfValueSets();
+
+  // Seed grid covers bounding box of mesh
+  const MeshTables& mesh = *Mesh;
+  G4double meshMax[2];
+  for (G4int dim=0; dim<2; dim++) {
+    meshMax[dim] = mesh.GridMin[dim] + mesh.GridN[dim]*mesh.GridStep[dim];
+  }
+
+  vector<size_t> order;
+  SortPoints(npts, pos, 2, mesh.GridMin.data(), meshMax,
+	     mesh.Tetrahedra.size(), order);
+
+  G4double bary[3] = { 0. };
+  for (size_t i: order) {
+    FindTetrahedron(pos+2*i, bary, quiet);
+    if (values) FillValues(bary, values+i*nsets);
+    if (grads) grads[i] = (TetraIdx()<0. ? zero : (*Grad)[TetraIdx()]);
+  }
+}
+
+void G4CMPBiLinearInterp::FillValues(const G4double bary[3],
+				     G4double values[]) const {
+  if (TetraIdx() < 0.) {
+    std::fill(values, values+GetNumberOfValueSets(), 0.);
+    return;
+  }
+
+  const tetra2d& tetra = Mesh->Tetrahedra[TetraIdx()];
+  const ValueTable& V = *(this->V);
+
+  values[0] = 0.;
+  for (G4int j=0; j<3; j++) values[0] += V[tetra[j]] * bary[j];
+
+  if (NExtra == 0) return;
+
+  const ValueTable& VX = *VExtra;		// Interleaved by mesh point
+  for (G4int k=0; k<NExtra; k++) {
+    values[1+k] = (VX[tetra[0]*NExtra+k] * bary[0] +
+		   VX[tetra[1]*NExtra+k] * bary[1] +
+		   VX[tetra[2]*NExtra+k] * bary[2]);
+  }
 }
 
 void 
@@ -352,17 +651,34 @@ G4CMPBiLinearInterp::FindTetrahedron(const G4double pt[2], G4double bary[3],
 				      G4bool quiet) const {
   const G4double barySafety = -1e-10;	// Deal with points close to edges
 
+  const vector<tetra2d>& Tetrahedra = Mesh->Tetrahedra;	// For convenience
+  const RecordTable& Records = Mesh->Records;
+
   G4int minBaryIdx = -1;
 
   G4double bestBary = 0.;	// Norm of barycentric coordinates (below)
   G4int bestTet = -1;
 
-  if (TetraIdx() == -1) TetraIdx() = TetraStart;
+  // Grid index rejects points outside mesh, or gives nearby starting point
+  G4int seedTet = FindSeedTetra(pt);
+  if (seedTet < 0) {
+    if (!quiet) {
+      G4cerr << "G4CMPBiLinearInterp::FindTetrahedron:"
+	     << " Point outside of hull!\n pt = "
+	     << pt[0] << " " << pt[1] << G4endl;
+    }
+
+    TetraIdx() = -1;
+    return;
+  }
+
+  if (TetraIdx() == -1) TetraIdx() = seedTet;
 
 #ifdef G4CMPTLI_DEBUG
   if (G4CMPConfigManager::GetVerboseLevel() > 1) {
     G4cout << "FindTetrahedron pt " << pt[0] << " " << pt[1]
-	   << "\n starting from TetraIdx " << TetraIdx() << G4endl;
+	   << "\n starting from TetraIdx " << TetraIdx() << " (seed "
+	   << seedTet << ")" << G4endl;
   }
 #endif
 
@@ -396,9 +712,15 @@ G4CMPBiLinearInterp::FindTetrahedron(const G4double pt[2], G4double bary[3],
     if (std::all_of(bary, bary+3,
 		    [barySafety](G4double b){return b>=barySafety;})) return;
 
+    // Previous triangle missed; jump to neighborhood of new point
+    if (count == 0 && TetraIdx() != seedTet) {
+      TetraIdx() = seedTet;
+      continue;
+    }
+
     // Evaluate barycentric distance from current tetrahedron
     G4double newNorm = BaryNorm(bary);
-    if (newNorm < bestBary || count == 0) {	// Getting closer
+    if (newNorm < bestBary || bestTet < 0) {	// Getting closer
       bestBary = newNorm;
       bestTet  = TetraIdx();
 
@@ -411,9 +733,9 @@ G4CMPBiLinearInterp::FindTetrahedron(const G4double pt[2], G4double bary[3],
     }
 
     // Point is outside current tetrahedron; shift to nearest neighbor
-    minBaryIdx = std::min_element(bary, bary+4) - bary;
+    minBaryIdx = std::min_element(bary, bary+3) - bary;
 
-    G4int newTetraIdx = Neighbors[TetraIdx()][minBaryIdx];
+    G4int newTetraIdx = Records[TetraIdx()].neighbors[minBaryIdx];
     if (newTetraIdx == -1) {   // Fell off edge of world
       if (!quiet) {
 	G4cerr << "G4CMPBiLinearInterp::FindTetrahedron:"
@@ -454,36 +776,34 @@ G4CMPBiLinearInterp::FindTetrahedron(const G4double pt[2], G4double bary[3],
 
 G4bool 
 G4CMPBiLinearInterp::Cart2Bary(const G4double pt[2], G4double bary[3]) const {
-  const tetra2d& tetra = Tetrahedra[TetraIdx()]; // For convenience below
-  const mat2x2& invT = TInverse[TetraIdx()];
-  
-  if (TInvGood[TetraIdx()]) {
+  const TetraRecord& rec = Mesh->Records[TetraIdx()];	// For convenience
+  const mat2x2& invT = rec.invT;
+  const point2d& X2 = rec.X2;
+
+  if (rec.good) {
     bary[2] = 1.0;
     for(G4int k=0; k<2; ++k) {
-      bary[k] = (invT[k][0]*(pt[0] - X[tetra[2]][0]) +
-		 invT[k][1]*(pt[1] - X[tetra[2]][1]) );
+      bary[k] = (invT[k][0]*(pt[0] - X2[0]) +
+		 invT[k][1]*(pt[1] - X2[1]) );
       bary[2] -= bary[k];
     }
   }
 
-  return TInvGood[TetraIdx()];
+  return rec.good;
 }
 
 G4double G4CMPBiLinearInterp::BaryNorm(G4double bary[3]) const {
   return (bary[0]*bary[0]+bary[1]*bary[1]+bary[2]*bary[2]);
 }
 
-G4bool G4CMPBiLinearInterp::BuildT3x2(size_t itet, mat3x2& ET) const {
+void G4CMPBiLinearInterp::BuildT3x2(const mat2x2& invT, mat3x2& ET) const {
   // NOTE:  If matrix inversion failed, invT is set to all zeros
-  const mat2x2& invT = TInverse[itet];   // For convenience below
   for (G4int i=0; i<2; ++i) {
     for (G4int j=0; j<2; ++j) {
       ET[i][j] = invT[i][j];
     }
     ET[2][i] = -invT[0][i] - invT[1][i];
   }
-
-  return TInvGood[itet];
 }
 
 G4double G4CMPBiLinearInterp::Det2(const mat2x2& matrix) const {
@@ -525,8 +845,8 @@ G4bool G4CMPBiLinearInterp::MatInv(const mat2x2& matrix, mat2x2& result,
 void G4CMPBiLinearInterp::SavePoints(const G4String& fname) const {
   G4cout << "Writing points and values to " << fname << G4endl;
   std::ofstream save(fname);
-  for (size_t i=0; i<X.size(); i++) {
-    save << X[i] << " " << V[i]
+  for (size_t i=0; i<Mesh->X.size(); i++) {
+    save << Mesh->X[i] << " " << (*V)[i]
 	 << std::endl;
   }
 }
@@ -534,8 +854,9 @@ void G4CMPBiLinearInterp::SavePoints(const G4String& fname) const {
 void G4CMPBiLinearInterp::SaveTetra(const G4String& fname) const {
   G4cout << "Writing tetrahedra and neighbors to " << fname << G4endl;
   std::ofstream save(fname);
-    for (size_t i=0; i<Tetrahedra.size(); i++) {
-      save << Tetrahedra[i] << "        " << Neighbors[i] << std::endl;
+    for (size_t i=0; i<Mesh->Tetrahedra.size(); i++) {
+      save << Mesh->Tetrahedra[i] << "        " << Mesh->Records[i].neighbors
+	   << std::endl;
   }
 }
 
@@ -543,7 +864,11 @@ void G4CMPBiLinearInterp::SaveTetra(const G4String& fname) const {
 // Print out tetrahedral information with coordinates
 
 void G4CMPBiLinearInterp::PrintTetra(std::ostream& os, G4int iTetra) const {
-  os << " from tetra " << iTetra << " neighbors " << Neighbors[iTetra] << ":"
+  const vector<point2d>& X = Mesh->X;		// For convenience below
+  const vector<tetra2d>& Tetrahedra = Mesh->Tetrahedra;
+  const tetra2d& neighbors = Mesh->Records[iTetra].neighbors;
+
+  os << " from tetra " << iTetra << " neighbors " << neighbors << ":"
      << "\n " << Tetrahedra[iTetra][0] << ": " << X[Tetrahedra[iTetra][0]]
      << "\n " << Tetrahedra[iTetra][1] << ": " << X[Tetrahedra[iTetra][1]]
      << "\n " << Tetrahedra[iTetra][2] << ": " << X[Tetrahedra[iTetra][2]]
@@ -29,6 +29,7 @@
 // 20250423  Remove error suppression for starting at boundary.
 // 20250927  Increase verbosity for IsGoodBoundary() related messages; add
 //	       overloadable function to kill track when max-reflections.
+// 20261016  Read standard surface parameters from flat record, not table.
 
 #include "G4CMPBoundaryUtils.hh"
 #include "G4CMPConfigManager.hh"
@@ -63,7 +64,7 @@ G4CMPBoundaryUtils::G4CMPBoundaryUtils(G4VProcess* process)
     procName(process->GetProcessName()), procUtils(0),
     kCarTolerance(G4GeometryTolerance::GetInstance()->GetSurfaceTolerance()),
     maximumReflections(-1), prePV(0), postPV(0), surfProp(0), matTable(0),
-    electrode(0) {
+    electrode(0), surfParams(0) {
   procUtils = dynamic_cast<G4CMPProcessUtils*>(process);
   if (!procUtils) {
     G4Exception("G4CMPBoundaryUtils::G4CMPBoundaryUtils", "Boundary000",
@@ -139,6 +140,7 @@ G4bool G4CMPBoundaryUtils::GetBoundingVolumes(const G4Step& aStep) {
 G4bool G4CMPBoundaryUtils::GetSurfaceProperty(const G4Step& aStep) {
   surfProp = nullptr;				// Avoid stale cache!
   matTable = nullptr;
+  surfParams = nullptr;
   electrode = nullptr;
   
   // Look for specific surface between pre- and post-step points first
@@ -185,14 +187,18 @@ G4bool G4CMPBoundaryUtils::GetSurfaceProperty(const G4Step& aStep) {
   const G4ParticleDefinition* pd = aStep.GetTrack()->GetParticleDefinition();
   if (G4CMP::IsChargeCarrier(pd)) {
     matTable = surfProp->GetChargeMaterialPropertiesTablePointer();
+    surfParams = &surfProp->GetChargeParameters();
     electrode = surfProp->GetChargeElectrode();
   }
 
   if (G4CMP::IsPhonon(pd)) {
     matTable = surfProp->GetPhononMaterialPropertiesTablePointer();
+    surfParams = &surfProp->GetPhononParameters();
     electrode = surfProp->GetPhononElectrode();
   }
 
+  if (surfParams && !surfParams->valid) matTable = nullptr;
+
   if (!matTable) {
     G4Exception((procName+"::GetSurfaceProperty").c_str(),
 		"Boundary004", JustWarning,
@@ -319,7 +325,7 @@ G4CMPBoundaryUtils::ApplyBoundaryAction(const G4Track& aTrack,
 // Default conditions for absorption or reflection
 
 G4bool G4CMPBoundaryUtils::AbsorbTrack(const G4Track&, const G4Step&) const {
-  G4double absProb = GetMaterialProperty("absProb");
+  G4double absProb = surfParams->absProb;
   G4double rand = G4UniformRand();
   if (buVerboseLevel>2) {
     G4cout << " AbsorbTrack: absProb " << absProb << " rand " << rand
@@ -330,7 +336,7 @@ G4bool G4CMPBoundaryUtils::AbsorbTrack(const G4Track&, const G4Step&) const {
 }
 
 G4bool G4CMPBoundaryUtils::ReflectTrack(const G4Track&, const G4Step&) const {
-  G4double reflProb = GetMaterialProperty("reflProb");
+  G4double reflProb = surfParams->reflProb;
   G4double rand = G4UniformRand();
   if (buVerboseLevel>2) {
     G4cout << " ReflectTrack: reflProb " << reflProb << " rand " << rand
@@ -47,6 +47,14 @@
 // 20250502  G4CMP-358: Limit number of steps for charged tracks in E-field.
 // 20250325  G4CMP-463: Add parameter for phonon surface step size & limit.
 // 20250711  G4CMP-491: Turn off phonon surface displacement loop by default.
+// 20261016  Add flag and directory for binary mesh field cache files.
+// 20261016  Add number of threads for building mesh field tables.
+// 20261016  Add step size and tolerance for regular-grid field cache.
+// 20261016  Use K-Vg eigensolver by default, now that it is fast.
+// 20261016  Add tolerance for tabulated scattering rates.
+// 20261016  Add parameters for multi-emission Luke macro-steps.
+// 20261016  Add flag, step length and signal binning for fast charge mode.
+// 20261016  Add importance file for phonon weight windows.
 
 
 #include "G4CMPConfigManager.hh"
@@ -55,6 +63,7 @@
 #include "G4CMPLindhardNIEL.hh"
 #include "G4CMPEmpiricalNIEL.hh"
 #include "G4CMPImpactTunlNIEL.hh"
+#include "G4CMPPhononWeightWindow.hh"
 #include "G4CMPSarkisNIEL.hh"
 #include "G4VNIELPartition.hh"
 #include "G4RunManager.hh"
@@ -94,9 +103,14 @@ G4CMPConfigManager::G4CMPConfigManager()
     ehMaxSteps(getenv("G4CMP_EH_MAX_STEPS")?atoi(getenv("G4CMP_EH_MAX_STEPS")):-1),
     maxLukePhonons(getenv("G4MP_MAX_LUKE")?atoi(getenv("G4MP_MAX_LUKE")):-1),
     pSurfStepLimit(getenv("G4CMP_PHON_SURFLIMIT")?strtod(getenv("G4CMP_PHON_SURFLIMIT"),0):-1),
+    meshThreads(getenv("G4CMP_MESH_THREADS")?atoi(getenv("G4CMP_MESH_THREADS")):0),
+    lukeMacroSteps(getenv("G4CMP_LUKE_MACRO_STEPS")?atoi(getenv("G4CMP_LUKE_MACRO_STEPS")):0),
+    lukeMacroPhonons(getenv("G4CMP_LUKE_MACRO_PHONONS")?atoi(getenv("G4CMP_LUKE_MACRO_PHONONS")):1),
     LatticeDir(getenv("G4LATTICEDATA")?getenv("G4LATTICEDATA"):"./CrystalMaps"),
     IVRateModel(getenv("G4CMP_IV_RATE_MODEL")?getenv("G4CMP_IV_RATE_MODEL"):""),
     lukeFilename(getenv("G4CMP_LUKE_FILE")?getenv("G4CMP_LUKE_FILE"):"LukePhononEnergies"),
+    meshCacheDir(getenv("G4CMP_MESH_CACHE_DIR")?getenv("G4CMP_MESH_CACHE_DIR"):""),
+    phononWindowFile(""),
     eTrapMFP(getenv("G4CMP_ETRAPPING_MFP")?strtod(getenv("G4CMP_ETRAPPING_MFP"),0)*mm:DBL_MAX),
     hTrapMFP(getenv("G4CMP_HTRAPPING_MFP")?strtod(getenv("G4CMP_HTRAPPING_MFP"),0)*mm:DBL_MAX),
     eDTrapIonMFP(getenv("G4CMP_EDTRAPION_MFP")?strtod(getenv("G4CMP_EDTRAPION_MFP"),0)*mm:DBL_MAX),
@@ -114,11 +128,18 @@ G4CMPConfigManager::G4CMPConfigManager()
     EminPhonons(getenv("G4CMP_EMIN_PHONONS")?strtod(getenv("G4CMP_EMIN_PHONONS"),0)*eV:0.),
     EminCharges(getenv("G4CMP_EMIN_CHARGES")?strtod(getenv("G4CMP_EMIN_CHARGES"),0)*eV:0.),
     pSurfStepSize(getenv("G4CMP_PHON_SURFSTEP")?strtod(getenv("G4CMP_PHON_SURFSTEP"),0)*um:0.),
-    useKVsolver(getenv("G4CMP_USE_KVSOLVER")?atoi(getenv("G4CMP_USE_KVSOLVER")):0),
+    fieldGridStep(getenv("G4CMP_FIELD_GRID_STEP")?strtod(getenv("G4CMP_FIELD_GRID_STEP"),0)*mm:0.),
+    fieldGridTol(getenv("G4CMP_FIELD_GRID_TOL")?strtod(getenv("G4CMP_FIELD_GRID_TOL"),0):0.01),
+    rateTableTol(getenv("G4CMP_RATE_TABLE_TOL")?strtod(getenv("G4CMP_RATE_TABLE_TOL"),0):1e-4),
+    fastChargeStep(getenv("G4CMP_FAST_CHARGE_STEP")?strtod(getenv("G4CMP_FAST_CHARGE_STEP"),0)*mm:10*um),
+    ramoBinWidth(getenv("G4CMP_RAMO_BIN_WIDTH")?strtod(getenv("G4CMP_RAMO_BIN_WIDTH"),0)*ns:0.),
+    useKVsolver(getenv("G4CMP_USE_KVSOLVER")?atoi(getenv("G4CMP_USE_KVSOLVER")):1),
     fanoEnabled(getenv("G4CMP_FANO_ENABLED")?atoi(getenv("G4CMP_FANO_ENABLED")):1),
     kaplanKeepPh(getenv("G4CMP_KAPLAN_KEEP")?atoi(getenv("G4CMP_KAPLAN_KEEP")):true),
     chargeCloud(getenv("G4CMP_CHARGE_CLOUD")?atoi(getenv("G4CMP_CHARGE_CLOUD")):0),
     recordMinE(getenv("G4CMP_RECORD_EMIN")?atoi(getenv("G4CMP_RECORD_EMIN")):true),
+    useMeshCache(getenv("G4CMP_MESH_CACHE")?atoi(getenv("G4CMP_MESH_CACHE")):true),
+    fastCharges(getenv("G4CMP_FAST_CHARGES")?atoi(getenv("G4CMP_FAST_CHARGES")):false),
     nielPartition(0),
     Empklow(getenv("G4CMP_EMPIRICAL_KLOW")?strtod(getenv("G4CMP_EMPIRICAL_KLOW"),0):0.040),
     Empkhigh(getenv("G4CMP_EMPIRICAL_KHigh")?strtod(getenv("G4CMP_EMPIRICAL_KHigh"),0):0.142),
@@ -135,6 +156,9 @@ G4CMPConfigManager::G4CMPConfigManager()
     setNIEL(getenv("G4CMP_NIEL_FUNCTION"));
   else 
     setNIEL(new G4CMPLewinSmithNIEL);
+
+  if (getenv("G4CMP_PHONON_WINDOW"))
+    setPhononWindow(getenv("G4CMP_PHONON_WINDOW"));
 }
 
 G4CMPConfigManager::~G4CMPConfigManager() {
@@ -147,9 +171,14 @@ G4CMPConfigManager::G4CMPConfigManager(const G4CMPConfigManager& master)
   : verbose(master.verbose), fPhysicsModelID(master.fPhysicsModelID), 
     ehBounces(master.ehBounces), pBounces(master.pBounces),
     maxLukePhonons(master.maxLukePhonons),
-    pSurfStepLimit(master.pSurfStepLimit), version(master.version),
+    pSurfStepLimit(master.pSurfStepLimit), meshThreads(master.meshThreads),
+    lukeMacroSteps(master.lukeMacroSteps),
+    lukeMacroPhonons(master.lukeMacroPhonons),
+    version(master.version),
     LatticeDir(master.LatticeDir), IVRateModel(master.IVRateModel),
-    lukeFilename(master.lukeFilename), eTrapMFP(master.eTrapMFP),
+    lukeFilename(master.lukeFilename), meshCacheDir(master.meshCacheDir),
+    phononWindowFile(master.phononWindowFile),
+    eTrapMFP(master.eTrapMFP),
     hTrapMFP(master.hTrapMFP), eDTrapIonMFP(master.eDTrapIonMFP),
     eATrapIonMFP(master.eATrapIonMFP), hDTrapIonMFP(master.hDTrapIonMFP),
     hATrapIonMFP(master.hATrapIonMFP),
@@ -158,10 +187,14 @@ G4CMPConfigManager::G4CMPConfigManager(const G4CMPConfigManager& master)
     genPhonons(master.genPhonons), genCharges(master.genCharges), 
     lukeSample(master.lukeSample), combineSteps(master.combineSteps),
     EminPhonons(master.EminPhonons), EminCharges(master.EminCharges),
-    pSurfStepSize(master.pSurfStepSize), useKVsolver(master.useKVsolver),
+    pSurfStepSize(master.pSurfStepSize), fieldGridStep(master.fieldGridStep),
+    fieldGridTol(master.fieldGridTol), rateTableTol(master.rateTableTol),
+    fastChargeStep(master.fastChargeStep), ramoBinWidth(master.ramoBinWidth),
+    useKVsolver(master.useKVsolver),
     fanoEnabled(master.fanoEnabled), kaplanKeepPh(master.kaplanKeepPh),
     chargeCloud(master.chargeCloud), recordMinE(master.recordMinE),
-    nielPartition(master.nielPartition),
+    useMeshCache(master.useMeshCache), fastCharges(master.fastCharges),
+    nielPartition(master.nielPartition), phononWindow(master.phononWindow),
     Empklow(master.Empklow), Empkhigh(master.Empkhigh),
     EmpElow(master.EmpElow), EmpEhigh(master.EmpEhigh),
     EmpEDepK(master.EmpEDepK), EmpkFixed(master.EmpkFixed),
@@ -204,6 +237,24 @@ void G4CMPConfigManager::setNIEL(G4VNIELPartition* niel) {
 }
 
 
+// Load phonon importance tables, shared by copies of this instance
+
+void G4CMPConfigManager::setPhononWindow(const G4String& filename) {
+  phononWindowFile = filename;
+  phononWindow.reset();
+
+  if (filename.empty() || filename == "none") return;
+
+  auto window = std::make_shared<G4CMPPhononWeightWindow>();
+  if (window->Load(filename)) phononWindow = window;
+  else {
+    G4Exception("G4CMPConfigManager::setPhononWindow", "Config001",
+		JustWarning, ("Unable to load "+filename+
+			      ", phonon weight windows disabled").c_str());
+  }
+}
+
+
 // Report configuration setting for diagnostics
 
 void G4CMPConfigManager::printConfig(std::ostream& os) const {
@@ -232,6 +283,8 @@ void G4CMPConfigManager::printConfig(std::ostream& os) const {
      << "\n/g4cmp/produceCharges " << genCharges << "\t\t\t\t# G4CMP_MAKE_CHARGES"
      << "\n/g4cmp/sampleLuke " << lukeSample << "\t\t\t\t# G4CMP_LUKE_SAMPLE"
      << "\n/g4cmp/maxLukePhonons " << maxLukePhonons << "\t\t\t# G4CMP_MAX_LUKE"
+     << "\n/g4cmp/lukeMacroSteps " << lukeMacroSteps << "\t\t\t# G4CMP_LUKE_MACRO_STEPS"
+     << "\n/g4cmp/lukeMacroPhonons " << lukeMacroPhonons << "\t\t\t# G4CMP_LUKE_MACRO_PHONONS"
      << "\n/g4cmp/combiningStepLength " << combineSteps/mm << " mm\t\t\t# G4CMP_COMBINE_STEPLEN"
      << "\n/g4cmp/minEPhonons " << EminPhonons/eV << " eV\t\t\t\t# G4CMP_EMIN_PHONONS"
      << "\n/g4cmp/minECharges " << EminCharges/eV << " eV\t\t\t\t# G4CMP_EMIN_CHARGES"
@@ -240,6 +293,16 @@ void G4CMPConfigManager::printConfig(std::ostream& os) const {
      << "\n/g4cmp/kaplanKeepPhonons " << kaplanKeepPh << "\t\t\t# G4CMP_KAPLAN_KEEP "
      << "\n/g4cmp/createChargeCloud " << chargeCloud << "\t\t\t# G4CMP_CHARGE_CLOUD"
      << "\n/g4cmp/recordMinETracks " << recordMinE << "\t\t\t# G4CMP_RECORD_EMIN"
+     << "\n/g4cmp/useMeshCache " << useMeshCache << "\t\t\t\t# G4CMP_MESH_CACHE"
+     << "\n/g4cmp/meshCacheDir " << meshCacheDir << "\t\t\t# G4CMP_MESH_CACHE_DIR"
+     << "\n/g4cmp/meshThreads " << meshThreads << "\t\t\t\t# G4CMP_MESH_THREADS"
+     << "\n/g4cmp/fieldGridStep " << fieldGridStep/mm << " mm\t\t\t# G4CMP_FIELD_GRID_STEP"
+     << "\n/g4cmp/fieldGridTolerance " << fieldGridTol << "\t\t# G4CMP_FIELD_GRID_TOL"
+     << "\n/g4cmp/rateTableTolerance " << rateTableTol << "\t\t# G4CMP_RATE_TABLE_TOL"
+     << "\n/g4cmp/fastCharges " << fastCharges << "\t\t\t\t# G4CMP_FAST_CHARGES"
+     << "\n/g4cmp/fastChargeStep " << fastChargeStep/mm << " mm\t\t\t# G4CMP_FAST_CHARGE_STEP"
+     << "\n/g4cmp/ramoBinWidth " << ramoBinWidth/ns << " ns\t\t\t# G4CMP_RAMO_BIN_WIDTH"
+     << "\n/g4cmp/phononWeightWindow " << phononWindowFile << "\t\t# G4CMP_PHONON_WINDOW"
      << "\n/g4cmp/NIELPartition "
      << (nielPartition ? typeid(*nielPartition).name() : "---")
      << "\t# G4CMP_NIEL_FUNCTION "
@@ -44,6 +44,14 @@
 // 20250212  G4CMP-457: Add macro command for Lindhard empirical ionization.
 // 20250502  G4CMP-358: Add macro command for maximum steps (stuck tracks).
 // 20250325  G4CMP-463: Add parameter for phonon surface step size & limit.
+// 20261016  Add macro commands to control binary mesh field cache.
+// 20261016  Add macro command for number of mesh building threads.
+// 20261016  Add macro commands for regular-grid field cache.
+// 20261016  Add macro command for tabulated scattering rate tolerance.
+// 20261016  Add macro commands for multi-emission Luke macro-steps.
+// 20261016  Add macro commands for fast charge transport mode.
+// 20261016  Add macro command for phonon weight-window file.
+// 20261016  Mesh cache is only used with a cache directory; update guidance.
 
 #include "G4CMPConfigMessenger.hh"
 #include "G4CMPConfigManager.hh"
@@ -61,14 +69,21 @@ G4CMPConfigMessenger::G4CMPConfigMessenger(G4CMPConfigManager* mgr)
   : G4UImessenger("/g4cmp/",
 		  "User configuration for G4CMP phonon/charge carrier library"),
     theManager(mgr), versionCmd(0), printCmd(0), verboseCmd(0), ehBounceCmd(0),
-    pBounceCmd(0), maxStepsCmd(0), maxLukeCmd(0), pSurfStepLimitCmd(0),
+    pBounceCmd(0), maxStepsCmd(0), maxLukeCmd(0), lukeMacroCmd(0),
+    lukeMacroPhCmd(0), pSurfStepLimitCmd(0),
+    meshThreadsCmd(0),
     clearCmd(0), minEPhononCmd(0), minEChargeCmd(0), sampleECmd(0),
     comboStepCmd(0), trapEMFPCmd(0), trapHMFPCmd(0), eDTrapIonMFPCmd(0),
     eATrapIonMFPCmd(0), hDTrapIonMFPCmd(0), hATrapIonMFPCmd(0), tempCmd(0),
-    pSurfStepSizeCmd(0), minstepCmd(0), makePhononCmd(0), makeChargeCmd(0),
-    lukePhononCmd(0), dirCmd(0), lukeFileCmd(0), ivRateModelCmd(0),
-    nielPartitionCmd(0),kvmapCmd(0), fanoStatsCmd(0), kaplanKeepCmd(0),
-    ehCloudCmd(0), recordMinECmd(0) {
+    pSurfStepSizeCmd(0), fieldGridStepCmd(0), fastStepCmd(0), ramoBinCmd(0),
+    minstepCmd(0), makePhononCmd(0),
+    makeChargeCmd(0), lukePhononCmd(0), fieldGridTolCmd(0), rateTableTolCmd(0),
+    dirCmd(0),
+    lukeFileCmd(0), ivRateModelCmd(0),
+    nielPartitionCmd(0), meshCacheDirCmd(0), phononWindowCmd(0),
+    kvmapCmd(0), fanoStatsCmd(0),
+    kaplanKeepCmd(0), ehCloudCmd(0), recordMinECmd(0), meshCacheCmd(0),
+    fastChargeCmd(0) {
   verboseCmd = CreateCommand<G4UIcmdWithAnInteger>("verbose",
 					   "Enable diagnostic messages");
 
@@ -114,6 +129,15 @@ G4CMPConfigMessenger::G4CMPConfigMessenger(G4CMPConfigManager* mgr)
   maxLukeCmd->SetGuidance("This is a soft maximum, estimated from the bias");
   maxLukeCmd->SetGuidance("voltage of the device and the downsampling scale");
 
+  lukeMacroCmd = CreateCommand<G4UIcmdWithAnInteger>("lukeMacroSteps",
+		   "Set average number of Luke emissions per charge step");
+  lukeMacroCmd->SetGuidance("Charges take steps long enough for this many");
+  lukeMacroCmd->SetGuidance("emissions, which are all generated together.");
+  lukeMacroCmd->SetGuidance("Values below 2 emit one phonon per step (default)");
+
+  lukeMacroPhCmd = CreateCommand<G4UIcmdWithAnInteger>("lukeMacroPhonons",
+		   "Set number of weighted phonons kept from each macro-step");
+
   minEPhononCmd = CreateCommand<G4UIcmdWithADoubleAndUnit>("minEPhonons",
           "Minimum energy for creating or tracking phonons");
   minEPhononCmd->SetUnitCategory("Energy");
@@ -211,6 +235,54 @@ G4CMPConfigMessenger::G4CMPConfigMessenger(G4CMPConfigManager* mgr)
   kaplanKeepCmd->SetParameterName("enable",true,false);
   kaplanKeepCmd->SetDefaultValue(true);
 
+  meshCacheCmd = CreateCommand<G4UIcmdWithABool>("useMeshCache",
+       "Read and write binary cache of mesh field tables (skip Qhull)");
+  meshCacheCmd->SetGuidance("Cache is only used if meshCacheDir is also set");
+  meshCacheCmd->SetParameterName("enable",true,false);
+  meshCacheCmd->SetDefaultValue(true);
+
+  meshCacheDirCmd = CreateCommand<G4UIcmdWithAString>("meshCacheDir",
+       "Directory for mesh cache files (none by default, disabling cache)");
+
+  meshThreadsCmd = CreateCommand<G4UIcmdWithAnInteger>("meshThreads",
+       "Number of threads used to build mesh field tables");
+  meshThreadsCmd->SetGuidance("Zero (default) uses all available cores");
+
+  fieldGridStepCmd = CreateCommand<G4UIcmdWithADoubleAndUnit>("fieldGridStep",
+       "Spacing of regular grid used to cache mesh electric field");
+  fieldGridStepCmd->SetGuidance("Zero (default) uses the tetrahedral mesh directly");
+  fieldGridStepCmd->SetUnitCategory("Length");
+  fieldGridStepCmd->SetUnitCandidates("mm cm um nm");
+
+  fieldGridTolCmd = CreateCommand<G4UIcmdWithADouble>("fieldGridTolerance",
+       "Relative field variation in grid cell above which mesh is used");
+
+  rateTableTolCmd = CreateCommand<G4UIcmdWithADouble>("rateTableTolerance",
+       "Relative accuracy of tabulated scattering rates (0 to disable)");
+
+  fastChargeCmd = CreateCommand<G4UIcmdWithABool>("fastCharges",
+       "Drift charges with lattice drift table instead of full tracking");
+  fastChargeCmd->SetGuidance("No Luke phonons or scattering are produced");
+  fastChargeCmd->SetParameterName("enable",true,false);
+  fastChargeCmd->SetDefaultValue(true);
+
+  fastStepCmd = CreateCommand<G4UIcmdWithADoubleAndUnit>("fastChargeStep",
+       "Integration step length for fast charge transport");
+  fastStepCmd->SetUnitCategory("Length");
+  fastStepCmd->SetUnitCandidates("mm cm um nm");
+
+  ramoBinCmd = CreateCommand<G4UIcmdWithADoubleAndUnit>("ramoBinWidth",
+       "Time bin for induced currents from fast charge transport");
+  ramoBinCmd->SetGuidance("Zero (default) computes only total induced charge");
+  ramoBinCmd->SetUnitCategory("Time");
+  ramoBinCmd->SetUnitCandidates("ns us ms s");
+
+  phononWindowCmd = CreateCommand<G4UIcmdWithAString>("phononWeightWindow",
+       "Importance file for phonon splitting and Russian roulette");
+  phononWindowCmd->SetGuidance("Empty or \"none\" disables weight windows");
+  phononWindowCmd->SetParameterName("file",true);
+  phononWindowCmd->SetDefaultValue("none");
+
   // Commands for Emp Lindhard model
   EmpEDepKCmd = CreateCommand<G4UIcmdWithABool>("/g4cmp/NIELPartition/Empirical/EDepK",
       "Enable or disable energy-dependent k parameter for Emp Lindhard model.");
@@ -241,10 +313,14 @@ G4CMPConfigMessenger::~G4CMPConfigMessenger() {
   delete pBounceCmd; pBounceCmd=0;
   delete maxStepsCmd; maxStepsCmd=0;
   delete maxLukeCmd; maxLukeCmd=0;
+  delete lukeMacroCmd; lukeMacroCmd=0;
+  delete lukeMacroPhCmd; lukeMacroPhCmd=0;
   delete clearCmd; clearCmd=0;
   delete minEPhononCmd; minEPhononCmd=0;
   delete minEChargeCmd; minEChargeCmd=0;
   delete recordMinECmd; recordMinECmd=0;
+  delete meshCacheCmd; meshCacheCmd=0;
+  delete meshCacheDirCmd; meshCacheDirCmd=0;
   delete sampleECmd; sampleECmd=0;
   delete comboStepCmd; comboStepCmd=0;
   delete trapEMFPCmd; trapEMFPCmd=0;
@@ -268,6 +344,14 @@ G4CMPConfigMessenger::~G4CMPConfigMessenger() {
   delete nielPartitionCmd; nielPartitionCmd=0;
   delete pSurfStepSizeCmd; pSurfStepSizeCmd=0;
   delete pSurfStepLimitCmd; pSurfStepLimitCmd=0;
+  delete meshThreadsCmd; meshThreadsCmd=0;
+  delete fieldGridStepCmd; fieldGridStepCmd=0;
+  delete fieldGridTolCmd; fieldGridTolCmd=0;
+  delete rateTableTolCmd; rateTableTolCmd=0;
+  delete fastChargeCmd; fastChargeCmd=0;
+  delete fastStepCmd; fastStepCmd=0;
+  delete ramoBinCmd; ramoBinCmd=0;
+  delete phononWindowCmd; phononWindowCmd=0;
   delete EmpklowCmd; EmpklowCmd = 0;
   delete EmpkhighCmd; EmpkhighCmd = 0;
   delete EmpElowCmd; EmpElowCmd = 0;
@@ -285,6 +369,8 @@ void G4CMPConfigMessenger::SetNewValue(G4UIcommand* cmd, G4String value) {
   if (cmd == makeChargeCmd) theManager->SetGenCharges(StoD(value));
   if (cmd == lukePhononCmd) theManager->SetLukeSampling(StoD(value));
   if (cmd == maxLukeCmd) theManager->SetMaxLukePhonons(StoI(value));
+  if (cmd == lukeMacroCmd) theManager->SetLukeMacroSteps(StoI(value));
+  if (cmd == lukeMacroPhCmd) theManager->SetLukeMacroPhonons(StoI(value));
   if (cmd == ehBounceCmd) theManager->SetMaxChargeBounces(StoI(value));
   if (cmd == pBounceCmd) theManager->SetMaxPhononBounces(StoI(value));
   if (cmd == maxStepsCmd) theManager->SetMaxChargeSteps(StoI(value));
@@ -295,6 +381,22 @@ void G4CMPConfigMessenger::SetNewValue(G4UIcommand* cmd, G4String value) {
     theManager->SetPhononSurfStepSize(pSurfStepSizeCmd->GetNewDoubleValue(value));
 
   if (cmd == pSurfStepLimitCmd) theManager->SetPhononSurfStepLimit(StoI(value));
+  if (cmd == meshThreadsCmd) theManager->SetMeshThreads(StoI(value));
+
+  if (cmd == fieldGridStepCmd)
+    theManager->SetFieldGridStep(fieldGridStepCmd->GetNewDoubleValue(value));
+
+  if (cmd == fieldGridTolCmd) theManager->SetFieldGridTolerance(StoD(value));
+
+  if (cmd == rateTableTolCmd) theManager->SetRateTableTolerance(StoD(value));
+
+  if (cmd == fastChargeCmd) theManager->UseFastCharges(StoB(value));
+
+  if (cmd == fastStepCmd)
+    theManager->SetFastChargeStep(fastStepCmd->GetNewDoubleValue(value));
+
+  if (cmd == ramoBinCmd)
+    theManager->SetRamoBinWidth(ramoBinCmd->GetNewDoubleValue(value));
 
   if (cmd == clearCmd)
     theManager->SetSurfaceClearance(clearCmd->GetNewDoubleValue(value));
@@ -343,6 +445,9 @@ void G4CMPConfigMessenger::SetNewValue(G4UIcommand* cmd, G4String value) {
   if (cmd == ivRateModelCmd) theManager->SetIVRateModel(value);
   if (cmd == nielPartitionCmd) theManager->SetNIELPartition(value);
   if (cmd == ehCloudCmd) theManager->CreateChargeCloud(StoB(value));
+  if (cmd == meshCacheCmd) theManager->UseMeshCache(StoB(value));
+  if (cmd == meshCacheDirCmd) theManager->SetMeshCacheDir(value);
+  if (cmd == phononWindowCmd) theManager->SetPhononWindowFile(value);
 
   if (cmd == versionCmd)
     G4cout << "G4CMP version: " << theManager->Version() << G4endl;
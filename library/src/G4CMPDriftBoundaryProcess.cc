@@ -17,6 +17,7 @@
 // 20180827  M. Kelsey -- Prevent partitioner from recomputing sampling factors
 // 20210328  Modify above; compute direct-phonon sampling factor here
 // 20250927  AbsorbTrack() should use '&&' to require that both conditions pass
+// 20261016  Read surface parameters from flat record; fill records at run start.
 
 #include "G4CMPDriftBoundaryProcess.hh"
 #include "G4CMPConfigManager.hh"
@@ -35,6 +36,7 @@
 #include "G4Step.hh"
 #include "G4StepPoint.hh"
 #include "G4StepStatus.hh"
+#include "G4Threading.hh"
 #include "G4Track.hh"
 #include "G4VParticleChange.hh"
 #include "G4VPhysicalVolume.hh"
@@ -53,6 +55,14 @@ G4CMPDriftBoundaryProcess::~G4CMPDriftBoundaryProcess() {
 }
 
 
+// Surface tables are complete once geometry is built; copy to flat records
+
+void G4CMPDriftBoundaryProcess::BuildPhysicsTable(const G4ParticleDefinition&) {
+  if (G4Threading::IsMasterThread())
+    G4CMPSurfaceProperty::UpdateAllParameters();
+}
+
+
 // Process actions
 
 G4double G4CMPDriftBoundaryProcess::
@@ -103,8 +113,8 @@ G4CMPDriftBoundaryProcess::PostStepDoIt(const G4Track& aTrack,
 
 G4bool G4CMPDriftBoundaryProcess::AbsorbTrack(const G4Track& aTrack,
                                               const G4Step& aStep) const {
-  G4double absMinK = (G4CMP::IsElectron(aTrack) ? GetMaterialProperty("minKElec")
-		      : G4CMP::IsHole(aTrack) ? GetMaterialProperty("minKHole")
+  G4double absMinK = (G4CMP::IsElectron(aTrack) ? surfParams->minKElec
+		      : G4CMP::IsHole(aTrack) ? surfParams->minKHole
 		      : -1.);
 
   if (absMinK < 0.) {
@@ -0,0 +1,117 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPDriftTable.cc
+/// \brief Implementation of the G4CMPDriftTable class, a lookup table of
+///	   charge carrier drift speed and diffusion vs. field.
+//
+// $Id$
+//
+// 20261016  New class for tabulated drift speed and diffusion.
+
+#include "G4CMPDriftTable.hh"
+#include "G4SystemOfUnits.hh"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+
+// Read five columns per line, skipping comments and blank lines
+
+G4bool G4CMPDriftTable::Load(const G4String& filename) {
+  Clear();
+
+  std::ifstream input(filename);
+  if (!input.good()) {
+    G4cerr << "G4CMPDriftTable: Unable to open " << filename << G4endl;
+    return false;
+  }
+
+  std::string line;
+  G4int lineNo = 0;
+  while (std::getline(input, line)) {
+    lineNo++;
+    size_t hash = line.find('#');
+    if (hash != std::string::npos) line.erase(hash);
+    if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+    std::istringstream values(line);
+    G4double field, vElec, dElec, vHole, dHole;
+    if (!(values >> field >> vElec >> dElec >> vHole >> dHole) ||
+	field <= 0. || vElec < 0. || dElec < 0. || vHole < 0. || dHole < 0.) {
+      G4cerr << "G4CMPDriftTable: Invalid entry at " << filename << ":"
+	     << lineNo << G4endl;
+      Clear();
+      return false;
+    }
+
+    AddPoint(field*volt/cm, vElec*km/s, dElec*cm2/s, vHole*km/s, dHole*cm2/s);
+  }
+
+  if (!IsFilled()) {
+    G4cerr << "G4CMPDriftTable: No entries in " << filename << G4endl;
+    return false;
+  }
+
+  return true;
+}
+
+
+// Keep fields in increasing order, so interpolation can bisect
+
+void G4CMPDriftTable::AddPoint(G4double field, G4double vElectron,
+			       G4double dElectron, G4double vHole,
+			       G4double dHole) {
+  size_t i = std::upper_bound(fField.begin(), fField.end(), field)
+    - fField.begin();
+
+  fField.insert(fField.begin()+i, field);
+  fVel[0].insert(fVel[0].begin()+i, vElectron);
+  fVel[1].insert(fVel[1].begin()+i, vHole);
+  fDiff[0].insert(fDiff[0].begin()+i, dElectron);
+  fDiff[1].insert(fDiff[1].begin()+i, dHole);
+}
+
+void G4CMPDriftTable::Clear() {
+  fField.clear();
+  for (G4int i=0; i<2; i++) {
+    fVel[i].clear();
+    fDiff[i].clear();
+  }
+}
+
+
+// Speed and diffusion lookups
+
+G4double G4CMPDriftTable::GetVelocity(G4bool isHole, G4double field) const {
+  if (!IsFilled() || field <= 0.) return 0.;
+
+  const std::vector<G4double>& vel = fVel[isHole?1:0];
+  if (field < fField.front()) return vel.front() * field/fField.front();
+
+  return Interpolate(vel, field);
+}
+
+G4double G4CMPDriftTable::GetDiffusion(G4bool isHole, G4double field) const {
+  if (!IsFilled()) return 0.;
+
+  return Interpolate(fDiff[isHole?1:0], field);
+}
+
+
+// Linear in log(field) between points, constant beyond ends of table
+
+G4double G4CMPDriftTable::Interpolate(const std::vector<G4double>& y,
+				      G4double field) const {
+  if (field <= fField.front()) return y.front();
+  if (field >= fField.back()) return y.back();
+
+  size_t i = std::upper_bound(fField.begin(), fField.end(), field)
+    - fField.begin();
+
+  G4double t = std::log(field/fField[i-1]) / std::log(fField[i]/fField[i-1]);
+  return y[i-1] + t*(y[i]-y[i-1]);
+}
@@ -12,6 +12,7 @@
 // $Id$
 //
 // 20161111 Initial commit - R. Agnese
+// 20261016  Add per-step cache of electric field and potential at track.
 
 #include "G4CMPDriftTrackInfo.hh"
 #include "G4LatticePhysical.hh"
@@ -37,6 +38,39 @@ void G4CMPDriftTrackInfo::SetValleyIndex(G4int valIdx) {
   valleyIdx = valIdx;
 }
 
+// Cached values are valid only at the same step and position
+
+G4bool G4CMPDriftTrackInfo::GetCachedField(G4int step,
+					   const G4ThreeVector& pos,
+					   G4ThreeVector& field) const {
+  if (step != fieldStep || pos != fieldPos) return false;
+  field = fieldValue;
+  return true;
+}
+
+void G4CMPDriftTrackInfo::SetCachedField(G4int step, const G4ThreeVector& pos,
+					 const G4ThreeVector& field) {
+  fieldStep = step;
+  fieldPos = pos;
+  fieldValue = field;
+}
+
+G4bool G4CMPDriftTrackInfo::GetCachedPotential(G4int step,
+					       const G4ThreeVector& pos,
+					       G4double& potential) const {
+  if (step != potentialStep || pos != potentialPos) return false;
+  potential = potentialValue;
+  return true;
+}
+
+void G4CMPDriftTrackInfo::SetCachedPotential(G4int step,
+					     const G4ThreeVector& pos,
+					     G4double potential) {
+  potentialStep = step;
+  potentialPos = pos;
+  potentialValue = potential;
+}
+
 void G4CMPDriftTrackInfo::Print() const {
 //TODO
 }
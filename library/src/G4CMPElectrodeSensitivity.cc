@@ -48,6 +48,11 @@ void G4CMPElectrodeSensitivity::Initialize(G4HCofThisEvent* HCE) {
   HCE->AddHitsCollection(HCID, hitsCollection);
 }
 
+void G4CMPElectrodeSensitivity::InsertHit(G4CMPElectrodeHit* hit) {
+  if (hitsCollection && isActive()) hitsCollection->insert(hit);
+  else delete hit;
+}
+
 G4bool G4CMPElectrodeSensitivity::ProcessHits(G4Step* aStep,
                                               G4TouchableHistory* ROhist) {
   if (IsHit(aStep, ROhist)) {
@@ -33,6 +33,10 @@
 //		method of each process separately.
 // 20240703 I. Ataee -- Cleaning up the code and using MapPtoV_el instea of redoing
 //		what it does in the EvaluateRhsGivenB method.
+// 20261016  Precompose global-to-valley force and band-energy transforms for
+//		each valley when lattice or coordinates change; evaluation is
+//		then two matrix-vector products.
+// 20261016  Add TotalEnergy() for use by G4CMPUniformFieldStepper.
 
 #include "G4CMPEqEMField.hh"
 #include "G4CMPConfigManager.hh"
@@ -45,7 +49,9 @@ G4CMPEqEMField::G4CMPEqEMField(G4ElectroMagneticField *emField,
 			       const G4LatticePhysical* lattice)
   : G4EqMagElectricField(emField), theLattice(lattice), 
     verboseLevel(G4CMPConfigManager::GetVerboseLevel()),
-    fCharge(0.), fMass(0.), valleyIndex(-1) {;}
+    fCharge(0.), fMass(0.), valleyIndex(-1), mc2sq(0.) {
+  FillValleyTransforms();
+}
 
 
 // Replace physical lattice if track has changed volumes
@@ -54,6 +60,7 @@ G4CMPEqEMField::G4CMPEqEMField(G4ElectroMagneticField *emField,
 G4bool G4CMPEqEMField::ChangeLattice(const G4LatticePhysical* lattice) {
   G4bool newLat = (lattice != theLattice);
   theLattice = lattice;
+  if (newLat) FillValleyTransforms();
   return newLat;
 }
 
@@ -64,6 +71,61 @@ G4bool G4CMPEqEMField::ChangeLattice(const G4LatticePhysical* lattice) {
 void G4CMPEqEMField::SetTransforms(const G4AffineTransform& lToG) {
   fGlobalToLocal = fLocalToGlobal = lToG;
   fGlobalToLocal.Invert();
+  FillValleyTransforms();
+}
+
+
+// Each transform is linear, so apply chain to unit vectors for matrices
+
+void G4CMPEqEMField::FillValleyTransforms() {
+  valleyForce.clear();
+  valleyBand.clear();
+  if (!theLattice) return;
+
+  const G4double mass = theLattice->GetElectronMass();
+  const G4RotationMatrix& mTensor = theLattice->GetMassTensor();
+  mc2sq = mass*c_squared * mass*c_squared;
+
+  G4ThreeVector fcol[3], band[3];
+  for (size_t iv=0; iv<theLattice->NumberOfValleys(); iv++) {
+    const G4RotationMatrix& nToV = theLattice->GetValley(iv);
+    const G4RotationMatrix& vToN = theLattice->GetValleyInv(iv);
+
+    for (G4int j=0; j<3; j++) {
+      G4ThreeVector& axis = band[j];
+      axis.set(j==0, j==1, j==2);
+      fGlobalToLocal.ApplyAxisTransform(axis);
+      theLattice->RotateToLattice(axis);
+      axis.transform(nToV);			// Global axis in valley frame
+
+      // Force: Herring-Vogt in valley frame, then back to global
+      G4ThreeVector& col = fcol[j];
+      col = axis;
+      col *= theLattice->GetMInvTensor();
+      col *= mass;
+      col.transform(vToN);
+      theLattice->RotateToSolid(col);
+      fLocalToGlobal.ApplyAxisTransform(col);
+    }
+
+    valleyForce.emplace_back(G4Rep3x3(fcol[0].x(), fcol[1].x(), fcol[2].x(),
+				      fcol[0].y(), fcol[1].y(), fcol[2].y(),
+				      fcol[0].z(), fcol[1].z(), fcol[2].z()));
+
+    // Band energy <p|M|p> uses diagonal mass tensor in valley frame
+    G4double q[3][3];
+    for (G4int i=0; i<3; i++) {
+      for (G4int j=0; j<3; j++) {
+	q[i][j] = (mTensor.xx()*band[i].x()*band[j].x() +
+		   mTensor.yy()*band[i].y()*band[j].y() +
+		   mTensor.zz()*band[i].z()*band[j].z()) / mass;
+      }
+    }
+
+    valleyBand.emplace_back(G4Rep3x3(q[0][0], q[0][1], q[0][2],
+				     q[1][0], q[1][1], q[1][2],
+				     q[2][0], q[2][1], q[2][2]));
+  }
 }
 
 
@@ -98,6 +160,15 @@ void G4CMPEqEMField::SetChargeMomentumMass(G4ChargeState particleCharge,
 }
 
 
+// Band energy gives speed |v| = |p|c/(Ekin+mc^2); see MapPtoV_el()
+// Without valley, same as base class, E = sqrt(p^2+m^2)
+
+G4double G4CMPEqEMField::TotalEnergy(const G4ThreeVector& p) const {
+  return (valleyIndex == -1 ? sqrt(p.mag2() + fMass*fMass)
+	  : sqrt(p.dot(valleyBand[valleyIndex]*p) + mc2sq));
+}
+
+
 // Field evaluation:  Given momentum (y) and field, return velocity, force
 
 void G4CMPEqEMField::EvaluateRhsGivenB(const G4double y[],
@@ -114,8 +185,6 @@ void G4CMPEqEMField::EvaluateRhsGivenB(const G4double y[],
   mom.set(y[3],y[4],y[5]);			// Momentum
   Efield.set(field[3],field[4],field[5]);	// Electric field
 
-  force = Efield;	// Apply transforms here so Efield stays original
-
 #ifdef G4CMP_DEBUG
   if (verboseLevel>2) {
     G4cout << "G4CMPEqEMField" << " @ " << pos << " mm" << G4endl
@@ -128,13 +197,11 @@ void G4CMPEqEMField::EvaluateRhsGivenB(const G4double y[],
 
   momdir = mom.unit();
 
-  fGlobalToLocal.ApplyAxisTransform(mom);
-  vel = theLattice->MapPtoV_el(valleyIndex,mom);
-  G4double vinv = 1./vel.mag();
+  G4double vinv = TotalEnergy(mom) / (mom.mag()*c_light);
 
 #ifdef G4CMP_DEBUG
   if (verboseLevel>2) {
-    G4cout << " v " << vel/(km/s) << " " << vel.mag()/(km/s) << " km/s"
+    G4cout << " v " << 1./vinv/(km/s) << " km/s"
 	   << G4endl << " TOF (1/v) " << vinv/(ns/mm) << " ns/mm"
 	   << " c/v " << vinv*c_light << G4endl
 	   << " E-field         " << Efield/(volt/cm) << " "
@@ -142,55 +209,8 @@ void G4CMPEqEMField::EvaluateRhsGivenB(const G4double y[],
   }
 #endif
 
-  fGlobalToLocal.ApplyAxisTransform(force);
-#ifdef G4CMP_DEBUG
-  if (verboseLevel>2)
-    G4cout << " Field (loc)     " << force/(volt/cm) << " "
-	   << force.mag()/(volt/cm) << G4endl;
-#endif
-
-  theLattice->RotateToLattice(force);
-#ifdef G4CMP_DEBUG
-  if (verboseLevel>2)
-    G4cout << " Field (lat)     " << force/(volt/cm) << " "
-	   << force.mag()/(volt/cm) << G4endl;
-#endif
-
-  // Rotate force into and out of valley frame, applying Herring-Vogt transform
-  const G4RotationMatrix& nToV = theLattice->GetValley(valleyIndex);
-  const G4RotationMatrix& vToN = theLattice->GetValleyInv(valleyIndex);
-
-  force.transform(nToV);			// Rotate to valley
-#ifdef G4CMP_DEBUG
-  if (verboseLevel>2)
-    G4cout << " Field (val)     " << force/(volt/cm) << " "
-	   << force.mag()/(volt/cm) << G4endl;
-#endif
-
-  force *= theLattice->GetMInvTensor();
-  force *= theLattice->GetElectronMass();
-#ifdef G4CMP_DEBUG
-  if (verboseLevel>2)
-    G4cout << " m0M^-1*E     " << force/(volt/cm) << " "
-	   << force.mag()/(volt/cm) << G4endl;
-#endif
-
-  force.transform(vToN);			// Back to lattice
-#ifdef G4CMP_DEBUG
-  if (verboseLevel>2)
-    G4cout << " m0M^-1*E (lat) " << force/(volt/cm) << " "
-	   << force.mag()/(volt/cm) << G4endl;
-#endif
-
-  theLattice->RotateToSolid(force);		// Back to crystal frame
-#ifdef G4CMP_DEBUG
-  if (verboseLevel>2)
-    G4cout << " m0M^-1*E (loc) " << force/(volt/cm) << " "
-	   << force.mag()/(volt/cm) << G4endl;
-#endif
-
-  // Restore field to global coordinate frame for G4Transporation
-  fLocalToGlobal.ApplyAxisTransform(force);
+  // Herring-Vogt transform in valley frame, all in one step
+  force = valleyForce[valleyIndex]*Efield;
 #ifdef G4CMP_DEBUG
   if (verboseLevel>2)
     G4cout << " m0M^-1*E (glb) " << force/(volt/cm) << " "
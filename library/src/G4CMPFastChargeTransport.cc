@@ -0,0 +1,220 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPFastChargeTransport.cc
+/// \brief Implementation of the G4CMPFastChargeTransport class, drifting
+///	   charge carriers with tabulated speeds and computing induced
+///	   Shockley-Ramo signals.
+//
+// $Id$
+//
+// 20261016  New class for tabulated drift and Shockley-Ramo signals.
+
+#include "G4CMPFastChargeTransport.hh"
+#include "G4CMPConfigManager.hh"
+#include "G4CMPDriftTable.hh"
+#include "G4CMPFieldUtils.hh"
+#include "G4CMPLocalElectroMagField.hh"
+#include "G4CMPMeshElectricField.hh"
+#include "G4ElectroMagneticField.hh"
+#include "G4LogicalVolume.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VSolid.hh"
+#include "Randomize.hh"
+#include <algorithm>
+#include <cmath>
+
+
+namespace {
+  const size_t maxSignalBins = 1 << 20;		// Guard against runaway times
+  const G4int defaultMaxSteps = 1000000;	// If config limit not set
+  const std::vector<G4double> noCurrent;
+}
+
+
+// Constructor
+
+G4CMPFastChargeTransport::G4CMPFastChargeTransport(G4int verbose)
+  : verboseLevel(verbose), nSteps(0), collected(false), field(0), mesh(0),
+    drift(0), isHole(false), charge(0.),
+    binWidth(G4CMPConfigManager::GetRamoBinWidth()) {
+  for (G4int i=0; i<4; i++) point[i] = 0.;
+  for (G4int i=0; i<6; i++) fieldBuf[i] = 0.;
+}
+
+
+// Drift from pos to surface, stepping along field at tabulated speed
+
+G4bool G4CMPFastChargeTransport::Drift(const G4LogicalVolume* vol,
+				       const G4CMPDriftTable* table,
+				       G4double q, G4ThreeVector& pos,
+				       G4double& time) {
+  nSteps = 0;
+  collected = false;
+  if (!vol || !table || !table->IsFilled() || q == 0.) return false;
+
+  // Tracking fields are in global coordinates; need local implementation
+  const G4CMPLocalElectroMagField* local = G4CMP::GetLocalField(vol);
+  mesh = G4CMP::GetMeshField(vol);
+  field = local ? local->GetLocalField() : mesh;
+  if (!field) return false;
+
+  const G4VSolid* solid = vol->GetSolid();
+  if (solid->Inside(pos) == kOutside) return false;
+
+  drift = table;
+  charge = q;
+  isHole = (q > 0.);
+
+  const G4int nchan = mesh ? mesh->GetNumberOfPotentials()-1 : 0;
+  if (nchan > GetNumberOfChannels()) {
+    inducedQ.resize(nchan, 0.);
+    inducedI.resize(nchan);
+  }
+
+  if (nchan > 0) GetPotentials(pos, Vstart);
+
+  const G4double stepLen = G4CMPConfigManager::GetFastChargeStep();
+  G4int maxSteps = G4CMPConfigManager::GetMaxChargeSteps();
+  if (maxSteps <= 0) maxSteps = defaultMaxSteps;
+
+  G4ThreeVector vdir, vmid, step;
+  G4double speed=0., diff=0., dt=0.;
+  while (!collected && nSteps < maxSteps) {
+    speed = DriftVelocity(pos, vdir, diff);
+
+    if (speed > 0.) dt = stepLen/speed;
+    else if (diff > 0.) dt = stepLen*stepLen/(6.*diff);
+    else break;				// Stalled in zero field
+
+    nSteps++;
+
+    // Midpoint rule follows curvature of field lines
+    if (speed > 0.) {
+      G4double vm = DriftVelocity(pos+(0.5*speed*dt)*vdir, vmid, diff);
+      if (vm > 0.) {
+	speed = vm;
+	vdir = vmid;
+      }
+    }
+
+    step = (speed*dt)*vdir;
+    if (diff > 0.) {
+      G4double sigma = std::sqrt(2.*diff*dt);
+      step += G4ThreeVector(G4RandGauss::shoot(0.,sigma),
+			    G4RandGauss::shoot(0.,sigma),
+			    G4RandGauss::shoot(0.,sigma));
+    }
+
+    G4double length = step.mag();
+    if (length <= 0.) continue;
+
+    G4double toOut = solid->DistanceToOut(pos, step/length);
+    if (toOut <= length) {		// Carrier reaches surface
+      dt *= toOut/length;
+      pos += (toOut/length)*step;
+      collected = true;
+    } else {
+      pos += step;
+    }
+
+    if (nchan > 0 && binWidth > 0.) {	// Induced current along path
+      GetPotentials(pos, Vend);
+      AddSignal(Vstart, Vend, time+0.5*dt);
+      Vstart.swap(Vend);
+    }
+
+    time += dt;
+  }
+
+  if (nchan > 0 && binWidth <= 0.) {	// Only total induced charge needed
+    GetPotentials(pos, Vend);
+    AddSignal(Vstart, Vend, time);
+  }
+
+  if (verboseLevel > 1) {
+    G4cout << "G4CMPFastChargeTransport::Drift " << (isHole?"hole":"electron")
+	   << (collected ? " collected at " : " stopped at ") << pos
+	   << " time " << time/ns << " ns after " << nSteps << " steps"
+	   << G4endl;
+  }
+
+  return true;
+}
+
+
+// Speed from drift table; holes move along field, electrons against it
+
+G4double G4CMPFastChargeTransport::DriftVelocity(const G4ThreeVector& pos,
+						 G4ThreeVector& vdir,
+						 G4double& diffusion) const {
+  point[0] = pos.x();
+  point[1] = pos.y();
+  point[2] = pos.z();
+  field->GetFieldValue(point, fieldBuf);
+
+  vdir.set(fieldBuf[3], fieldBuf[4], fieldBuf[5]);
+  G4double emag = vdir.mag();
+  diffusion = drift->GetDiffusion(isHole, emag);
+  if (emag <= 0.) return 0.;
+
+  vdir /= (isHole ? emag : -emag);
+  return drift->GetVelocity(isHole, emag);
+}
+
+
+// Weighting potentials from mesh field, with single search
+
+void G4CMPFastChargeTransport::GetPotentials(const G4ThreeVector& pos,
+					     std::vector<G4double>& V) const {
+  V.resize(mesh->GetNumberOfPotentials());
+
+  point[0] = pos.x();
+  point[1] = pos.y();
+  point[2] = pos.z();
+  mesh->GetPotentials(point, V.data());
+}
+
+
+// Induced charge is q*dV for each weighting potential
+
+void G4CMPFastChargeTransport::AddSignal(const std::vector<G4double>& V0,
+					 const std::vector<G4double>& V1,
+					 G4double tmid) {
+  G4double bin = (binWidth > 0. && tmid >= 0.) ? tmid/binWidth : -1.;
+  size_t ibin = (bin >= 0. && bin < maxSignalBins) ? size_t(bin)
+    : maxSignalBins;
+
+  for (size_t i=1; i<V0.size() && i<V1.size(); i++) {
+    G4double dq = charge * (V1[i]-V0[i])/volt;
+    inducedQ[i-1] += dq;
+
+    if (ibin < maxSignalBins) {
+      std::vector<G4double>& current = inducedI[i-1];
+      if (current.size() <= ibin) current.resize(ibin+1, 0.);
+      current[ibin] += dq/binWidth;
+    }
+  }
+}
+
+
+// Reset accumulated signals, e.g., at start of event
+
+void G4CMPFastChargeTransport::ClearSignals() {
+  binWidth = G4CMPConfigManager::GetRamoBinWidth();
+
+  std::fill(inducedQ.begin(), inducedQ.end(), 0.);
+  for (std::vector<G4double>& current: inducedI) current.clear();
+}
+
+G4double G4CMPFastChargeTransport::GetInducedCharge(G4int ich) const {
+  return (ich >= 0 && ich < GetNumberOfChannels()) ? inducedQ[ich] : 0.;
+}
+
+const std::vector<G4double>&
+G4CMPFastChargeTransport::GetInducedCurrent(G4int ich) const {
+  return (ich >= 0 && ich < GetNumberOfChannels()) ? inducedI[ich]
+    : noCurrent;
+}
@@ -22,6 +22,7 @@
 // 20210901  Add local verbosity flag for reporting diagnostics, pass through
 //		to G4CMPLocalEMField.
 // 20211010  "stepperLength" is suppsed to be in units of time, not distance?
+// 20261016  Use analytic G4CMPUniformFieldStepper for uniform fields.
 
 #include "G4CMPFieldManager.hh"
 #include "G4CMPConfigManager.hh"
@@ -31,6 +32,7 @@
 #include "G4CMPLocalElectroMagField.hh"
 #include "G4CMPDriftTrackInfo.hh"
 #include "G4CMPTrackUtils.hh"
+#include "G4CMPUniformFieldStepper.hh"
 #include "G4ChordFinder.hh"
 #include "G4ClassicalRK4.hh"
 #include "G4ElectroMagneticField.hh"
@@ -45,6 +47,7 @@
 #include "G4SystemOfUnits.hh"
 #include "G4ThreeVector.hh"
 #include "G4Track.hh"
+#include "G4UniformElectricField.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4VSolid.hh"
 #include "G4VTouchable.hh"
@@ -93,7 +96,18 @@ G4CMPFieldManager::~G4CMPFieldManager() {
 
 void G4CMPFieldManager::CreateTransport() {
   theEqMotion    = new G4CMPEqEMField(myDetectorField);
-  theStepper     = new G4ClassicalRK4(theEqMotion, stepperVars);
+
+  // Charges in uniform field follow known trajectory, no need for RK4
+  if (HasUniformField()) {
+    if (verboseLevel)
+      G4cout << "G4CMPFieldManager using analytic uniform-field stepper."
+	     << G4endl;
+
+    theStepper   = new G4CMPUniformFieldStepper(theEqMotion, stepperVars);
+  } else {
+    theStepper   = new G4ClassicalRK4(theEqMotion, stepperVars);
+  }
+
   theDriver      = new G4MagInt_Driver(stepperLength, theStepper, stepperVars);
   theChordFinder = new G4ChordFinder(theDriver);
   SetChordFinder(theChordFinder);
@@ -107,6 +121,15 @@ void G4CMPFieldManager::CreateTransport() {
   SetDeltaOneStep(10*nm);
 }
 
+// Look for uniform field inside local-coordinate wrapper
+
+G4bool G4CMPFieldManager::HasUniformField() const {
+  if (!myDetectorField) return false;
+
+  return dynamic_cast<const G4UniformElectricField*>(
+				myDetectorField->GetLocalField()) != 0;
+}
+
 
 // Run-time Configuration
 
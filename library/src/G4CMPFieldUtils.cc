@@ -10,11 +10,14 @@
 //
 // 20180622  Michael Kelsey
 // 20211005  Add position-only utility (get touchable from position)
+// 20261016  Track-based queries use per-step cache in G4CMPDriftTrackInfo
 
 #include "G4CMPFieldUtils.hh"
+#include "G4CMPDriftTrackInfo.hh"
 #include "G4CMPGeometryUtils.hh"
 #include "G4CMPLocalElectroMagField.hh"
 #include "G4CMPMeshElectricField.hh"
+#include "G4CMPTrackUtils.hh"
 #include "G4ElectroMagneticField.hh"
 #include "G4Field.hh"
 #include "G4FieldManager.hh"
@@ -39,7 +42,19 @@ G4ThreeVector G4CMP::GetFieldAtPosition(const G4Step& step) {
 }
 
 G4ThreeVector G4CMP::GetFieldAtPosition(const G4Track& track) {
-  return GetFieldAtPosition(track.GetTouchable(), track.GetPosition());
+  G4CMPDriftTrackInfo* info = GetTrackInfo<G4CMPDriftTrackInfo>(track);
+  if (!info) return GetFieldAtPosition(track.GetTouchable(),
+				      track.GetPosition());
+
+  // Several processes and rate models ask for field in the same step
+  G4int step = track.GetCurrentStepNumber();
+  G4ThreeVector field;
+  if (!info->GetCachedField(step, track.GetPosition(), field)) {
+    field = GetFieldAtPosition(track.GetTouchable(), track.GetPosition());
+    info->SetCachedField(step, track.GetPosition(), field);
+  }
+
+  return field;
 }
 
 
@@ -77,7 +92,19 @@ G4double G4CMP::GetPotentialAtPosition(const G4Step& step) {
 }
 
 G4double G4CMP::GetPotentialAtPosition(const G4Track& track) {
-  return GetPotentialAtPosition(track.GetTouchable(), track.GetPosition());
+  G4CMPDriftTrackInfo* info = GetTrackInfo<G4CMPDriftTrackInfo>(track);
+  if (!info) return GetPotentialAtPosition(track.GetTouchable(),
+					   track.GetPosition());
+
+  G4int step = track.GetCurrentStepNumber();
+  G4double potential = 0.;
+  if (!info->GetCachedPotential(step, track.GetPosition(), potential)) {
+    potential = GetPotentialAtPosition(track.GetTouchable(),
+				       track.GetPosition());
+    info->SetCachedPotential(step, track.GetPosition(), potential);
+  }
+
+  return potential;
 }
 
 // Get potential at starting position of track
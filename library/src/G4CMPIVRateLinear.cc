@@ -13,6 +13,7 @@
 // 20210908  Use global track position to query field; configure field.
 // 20211003  Use encapsulated G4CMPFieldUtils to get field.
 // 20230829  Rotated E-field to local frame first and changed Mass Multiplication in HV transformation
+// 20261016  Use rate table vs. field magnitude, filled once per lattice.
 
 #include "G4CMPIVRateLinear.hh"
 #include "G4CMPFieldUtils.hh"
@@ -27,6 +28,16 @@
 #include <math.h>
 #include <iostream>
 
+
+// Tabulate power law up to 10 kV/cm, well above any realistic bias
+
+void G4CMPIVRateLinear::LoadDataForTrack(const G4Track* track) {
+  G4CMPVScatteringRate::LoadDataForTrack(track);
+
+  rateTable = TabulateRate([this](G4double F) { return FieldRate(F); }, 1e4);
+}
+
+
 // Scattering rate is computed from electric field
 
 G4double G4CMPIVRateLinear::Rate(const G4Track& aTrack) const {
@@ -54,15 +65,22 @@ G4double G4CMPIVRateLinear::Rate(const G4Track& aTrack) const {
   }
 
   // Compute mean free path -- NOTE FIELD UNITS ARE V/cm HERE
-  G4double rate = theLattice->GetIVLinRate0() +
-    theLattice->GetIVLinRate1() * pow(fieldVector.mag(),
-				      theLattice->GetIVLinExponent());
+  G4double Emag = fieldVector.mag();
+  G4double rate = ((rateTable && rateTable->InRange(Emag))
+		   ? rateTable->Value(Emag) : FieldRate(Emag));
 
   if (verboseLevel > 1) G4cout << "IV rate = " << rate/hertz << " Hz" << G4endl;
   return rate;
 }
 
 
+G4double G4CMPIVRateLinear::FieldRate(G4double Efield) const {
+  return ( theLattice->GetIVLinRate0() +
+	   theLattice->GetIVLinRate1() * pow(Efield,
+					     theLattice->GetIVLinExponent()) );
+}
+
+
 // Threshold is minimum energy of any scattering channel
 
 G4double G4CMPIVRateLinear::Threshold(G4double Eabove) const {
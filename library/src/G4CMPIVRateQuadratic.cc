@@ -16,6 +16,7 @@
 // 20230829  Rotated E-field to local frame first and changed Mass
 //	       Multiplication in HV transformation
 // 20250515  Apply IV energy thresholds to reduce zero-voltage scatters
+// 20261016  Use rate table vs. field magnitude, filled once per lattice.
 
 #include "G4CMPIVRateQuadratic.hh"
 #include "G4CMPFieldUtils.hh"
@@ -33,6 +34,15 @@
 #include <vector>
 
 
+// Tabulate power law up to 10 kV/cm (in V/m), well above any realistic bias
+
+void G4CMPIVRateQuadratic::LoadDataForTrack(const G4Track* track) {
+  G4CMPVScatteringRate::LoadDataForTrack(track);
+
+  rateTable = TabulateRate([this](G4double F) { return FieldRate(F); }, 1e6);
+}
+
+
 // Scattering rate is computed from electric field
 
 G4double G4CMPIVRateQuadratic::Rate(const G4Track& aTrack) const {
@@ -61,15 +71,22 @@ G4double G4CMPIVRateQuadratic::Rate(const G4Track& aTrack) const {
   }
 
   // Compute mean free path; field vector units are V/m below
-  G4double E_0 = theLattice->GetIVQuadField() / (volt/m);
-  G4double rate = theLattice->GetIVQuadRate() *
-    pow((E_0*E_0 + fieldVector.mag2()), theLattice->GetIVQuadExponent()/2.0);
+  G4double Emag = fieldVector.mag();
+  G4double rate = ((rateTable && rateTable->InRange(Emag))
+		   ? rateTable->Value(Emag) : FieldRate(Emag));
 
   if (verboseLevel > 1) G4cout << "IV rate = " << rate/hertz << " Hz" << G4endl;
   return rate;
 }
 
 
+G4double G4CMPIVRateQuadratic::FieldRate(G4double Efield) const {
+  G4double E_0 = theLattice->GetIVQuadField() / (volt/m);
+  return ( theLattice->GetIVQuadRate() *
+	   pow((E_0*E_0 + Efield*Efield), theLattice->GetIVQuadExponent()/2.0) );
+}
+
+
 // Threshold is minimum energy of any scattering channel
 
 G4double G4CMPIVRateQuadratic::Threshold(G4double Eabove) const {
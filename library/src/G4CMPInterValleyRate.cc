@@ -12,6 +12,8 @@
 // 20170830  Follow Jacoboni, with unified D0/D1 expression and units; drop
 //		acoustic rate, as it is _intra_valley.
 // 20170919  Add interface for threshold identification
+// 20261016  Drop per-call LoadDataForTrack(); now handled in process.  Use
+//		rate table vs. energy, filled once per lattice.
 
 #include "G4CMPInterValleyRate.hh"
 #include "G4LatticePhysical.hh"
@@ -41,23 +43,31 @@ void G4CMPInterValleyRate::LoadDataForTrack(const G4Track* track) {
 
   m_DOS = theLattice->GetElectronDOSMass();
   m_DOS3half = sqrt(m_DOS*m_DOS*m_DOS);
+
+  // Total rate turns on at each IV phonon energy
+  rateTable = TabulateRate([this](G4double E) {
+			     return opticalRate(E) + scatterRate(E); },
+			   1.*eV, theLattice->GetIVEnergy());
 }
 
 
 // Scattering rate is computed from matrix elements
 
 G4double G4CMPInterValleyRate::Rate(const G4Track& aTrack) const {
-  const_cast<G4CMPInterValleyRate*>(this)->LoadDataForTrack(&aTrack);
-
-  // Initialize numerical buffers
-  eTrk = GetKineticEnergy(aTrack);
+  G4double eTrk = GetKineticEnergy(aTrack);
   if (verboseLevel>1)
     G4cout << "G4CMPInterValleyRate eTrk " << eTrk/eV << " eV" << G4endl;
 
-  G4double orate = opticalRate();
+  if (rateTable && rateTable->InRange(eTrk)) {
+    G4double rate = rateTable->Value(eTrk);
+    if (verboseLevel>1) G4cout << "IV rate = " << rate/hertz << " Hz" << G4endl;
+    return rate;
+  }
+
+  G4double orate = opticalRate(eTrk);
   if (verboseLevel>2) G4cout << "IV phonons  " << orate/hertz << " Hz" << G4endl;
  
-  G4double nrate = scatterRate();
+  G4double nrate = scatterRate(eTrk);
   if (verboseLevel>2) G4cout << "IV neutrals " << nrate/hertz << " Hz" << G4endl;
 
   G4double rate = nrate + orate;
@@ -68,15 +78,15 @@ G4double G4CMPInterValleyRate::Rate(const G4Track& aTrack) const {
 
 // Compute components of overall intervalley rate
 
-G4double G4CMPInterValleyRate::acousticRate() const {
+G4double G4CMPInterValleyRate::acousticRate(G4double E) const {
   G4double D_ac  = theLattice->GetElectronAcousticDeform();
   G4double D_ac_sq = D_ac*D_ac;
 
-  return ( sqrt(2)*kT * m_DOS3half * D_ac_sq * energyFunc(eTrk)
+  return ( sqrt(2)*kT * m_DOS3half * D_ac_sq * energyFunc(E)
 	   / (pi*hbar_4th*density*uSound*uSound) );
 }
 
-G4double G4CMPInterValleyRate::opticalRate() const {
+G4double G4CMPInterValleyRate::opticalRate(G4double E) const {
    // FIXME:  Rate should not have 'kT', but leaving it out ruins drift curve
   G4double scale = nValley*/*kT**/m_DOS3half / (sqrt(2)*pi*hbar_sq*density);
 
@@ -84,12 +94,12 @@ G4double G4CMPInterValleyRate::opticalRate() const {
   G4int N_op = theLattice->GetNIVDeform();
   for (G4int i = 0; i<N_op; i++) {
     G4double Emin_op = theLattice->GetIVEnergy(i);
-    if (eTrk <= Emin_op) continue;		// Apply threshold behaviour
+    if (E <= Emin_op) continue;		// Apply threshold behaviour
 
     G4double D_op = theLattice->GetIVDeform(i);
     G4double oscale = scale * D_op*D_op / Emin_op;
 
-    G4double Efunc = energyFunc(eTrk-Emin_op);	// Energy above threshold
+    G4double Efunc = energyFunc(E-Emin_op);	// Energy above threshold
 
     G4double orate = oscale * Efunc;
 
@@ -105,13 +115,13 @@ G4double G4CMPInterValleyRate::opticalRate() const {
   return total;
 }
 
-G4double G4CMPInterValleyRate::scatterRate() const {
+G4double G4CMPInterValleyRate::scatterRate(G4double E) const {
   G4double n_I = theLattice->GetImpurities();		// Number density
   G4double epsilon_r = theLattice->GetPermittivity();	// Dielectric constant
   G4double E_T = 0.75*eV * (m_DOS/m_electron) / epsilon_r;
   
-  return ( 4*sqrt(2)* n_I * hbar_sq * sqrt(eTrk)
-	   / (m_DOS3half * (eTrk+E_T)) );
+  return ( 4*sqrt(2)* n_I * hbar_sq * sqrt(E)
+	   / (m_DOS3half * (E+E_T)) );
 }
 
 
@@ -68,6 +68,8 @@
 //		Add Fermi-Dirac occupation statistics for QP energy spectrum.
 // 20250101  G4CMP-439: Create separate debugging file per worker thread;
 //		add EventID and TrackID columns to debugging output.
+// 20261016  Sample QP and phonon energies in variables which remove the PDF
+//		divergences at the bandgap, with exact maximum for rejection.
 
 #include "globals.hh"
 #include "G4CMPKaplanQP.hh"
@@ -82,6 +84,7 @@
 #include "G4TrackingManager.hh"
 #include "G4Track.hh"
 #include "Randomize.hh"
+#include <cmath>
 #include <numeric>
 
 
@@ -529,20 +532,42 @@ G4double G4CMPKaplanQP::QPEnergyRand(G4double Energy) const {
   //           /
   //           sqrt((E'*E' - gapEnergy*gapEnergy) *
   //                ((Energy - E')*(Energy - E') - gapEnergy*gapEnergy));
-  // The shape of the PDF is like a U, so the max values are at the endpoints:
-  // E' = gapEnergy and E' = Energy - gapEnergy
+  //
+  // The shape of the PDF is like a U, diverging at the endpoints
+  // E' = gapEnergy and E' = Energy - gapEnergy.  Substituting
+  // E' = gapEnergy + (Energy-2*gapEnergy)*sin^2(theta), the Jacobian
+  // cancels both divergences, leaving a smooth function of theta
+  //
+  // PDF(theta) = 2*(gapEnergy*Energy + k*w) / sqrt(2*gapEnergy*Energy + k*w)
+  //
+  // with k = (Energy-2*gapEnergy)^2/4 and w = sin^2(2*theta).  This rises
+  // with w, so the maximum is at theta = pi/4, and at least 2/pi of uniform
+  // theta values are accepted.
 
-  // Add buffer so first/last bins don't give zero denominator in pdfSum
+  // Same range as sampling in E', excluding 1/BUFF of range at each end
   const G4double BUFF = 1000.;
-  G4double xmin = gapEnergy + (Energy-2.*gapEnergy)/BUFF;
-  G4double xmax = gapEnergy + (Energy-2.*gapEnergy)*(BUFF-1.)/BUFF;
-  G4double ymax = QPEnergyPDF(Energy, xmin);
+  const G4double thmin = std::asin(std::sqrt(1./BUFF));
+  const G4double thmax = halfpi - thmin;
 
-  G4double xtest=0., ytest=ymax;
+  const G4double range = Energy - 2.*gapEnergy;
+  const G4double gapE = gapEnergy*Energy;
+  const G4double k = range*range/4.;
+
+  // Thermal occupation of final state; second term depends on E'
+  const G4double occupyE = 1. - ThermalPDF(Energy);
+  const G4double ymax = occupyE * 2.*(gapE+k) / std::sqrt(2.*gapE+k);
+
+  G4double xtest=0., ytest=ymax, yval=0.;
   do {
+    G4double theta = G4UniformRand()*(thmax-thmin) + thmin;
+    G4double sinth = std::sin(theta), costh = std::cos(theta);
+    G4double kw = 4.*k*sinth*sinth*costh*costh;
+
+    xtest = gapEnergy + range*sinth*sinth;
     ytest = G4UniformRand()*ymax;
-    xtest = G4UniformRand()*(xmax-xmin) + xmin;
-  } while (ytest > QPEnergyPDF(Energy, xtest));
+    yval = ((occupyE - ThermalPDF(Energy-xtest))
+	    * 2.*(gapE+kw) / std::sqrt(2.*gapE+kw));
+  } while (ytest > yval);
 
   return xtest;
 }
@@ -571,18 +596,27 @@ G4double G4CMPKaplanQP::PhononEnergyRand(G4double Energy) const {
   // PDF(E') = ((Energy-E')*(Energy-E') * (E'-gapEnergy*gapEnergy/Energy))
   //           /
   //           sqrt((E'*E' - gapEnergy*gapEnergy);
+  //
+  // Substituting E' = gapEnergy*cosh(t), the Jacobian cancels the
+  // divergence at E' = gapEnergy, leaving the cubic numerator above as the
+  // PDF in t.  Its maximum is at E' = (Energy+2*gapEnergy^2/Energy)/3.
 
-  // Add buffer so first bin doesn't give zero denominator in pdfSum
+  // Same range as sampling in E', excluding 1/BUFF above gapEnergy
   const G4double BUFF = 1000.;
+  const G4double gapsq = gapEnergy*gapEnergy;
   G4double xmin = gapEnergy + gapEnergy/BUFF;
   G4double xmax = Energy;
-  G4double ymax = PhononEnergyPDF(Energy, xmin);
+  G4double tmin = std::acosh(xmin/gapEnergy);
+  G4double tmax = std::acosh(xmax/gapEnergy);
+
+  G4double xpeak = std::min(std::max((Energy+2.*gapsq/Energy)/3., xmin), xmax);
+  G4double ymax = (Energy-xpeak)*(Energy-xpeak) * (xpeak-gapsq/Energy);
 
   G4double xtest=0., ytest=ymax;
   do {
+    xtest = gapEnergy*std::cosh(G4UniformRand()*(tmax-tmin) + tmin);
     ytest = G4UniformRand()*ymax;
-    xtest = G4UniformRand()*(xmax-xmin) + xmin;
-  } while (ytest > PhononEnergyPDF(Energy, xtest));
+  } while (ytest > (Energy-xtest)*(Energy-xtest) * (xtest-gapsq/Energy));
 
   return Energy-xtest;
 }
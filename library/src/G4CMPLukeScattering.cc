@@ -46,12 +46,20 @@
 // 20250223  G4CMP-462 -- Restore use of G4CMP_DEBUG flag to hide changes to
 //		lattice verbosity, which causes a data race.
 // 20250508  G4CMP-480 -- Pass global phonon wavevector to CreatePhonon.
+// 20261016  Add optional macro-steps, generating many emissions per step
+//		and keeping only a few weighted phonons.
+// 20261016  Place macro-step emissions along the step, with recoils applied
+//		at emission time; resample phonons with no recoil energy.
+// 20261016  Weight kept macro-step phonons by emission count, not energy;
+//		keep shifted positions out of daughter volumes, and relocate
+//		navigator after moving end point.
 
 #include "G4CMPLukeScattering.hh"
 #include "G4CMPConfigManager.hh"
 #include "G4CMPDriftElectron.hh"
 #include "G4CMPDriftHole.hh"
 #include "G4CMPDriftTrackInfo.hh"
+#include "G4CMPGeometryUtils.hh"
 #include "G4CMPLukeEmissionRate.hh"
 #include "G4CMPSecondaryUtils.hh"
 #include "G4CMPTrackUtils.hh"
@@ -61,6 +69,7 @@
 #include "G4ExceptionSeverity.hh"
 #include "G4LatticeManager.hh"
 #include "G4LatticePhysical.hh"
+#include "G4Navigator.hh"
 #include "G4PhononPolarization.hh"
 #include "G4PhysicalConstants.hh"
 #include "G4RandomDirection.hh"
@@ -69,8 +78,13 @@
 #include "G4StepPoint.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4Track.hh"
+#include "G4TransportationManager.hh"
 #include "G4VParticleChange.hh"
+#include "G4VSolid.hh"
+#include "G4VTouchable.hh"
 #include "Randomize.hh"
+#include <algorithm>
+#include <float.h>
 #include <iostream>
 #include <fstream>
 
@@ -90,8 +104,26 @@ G4CMPLukeScattering::~G4CMPLukeScattering() {
 
 // Physics
 
+G4double G4CMPLukeScattering::GetMeanFreePath(const G4Track& aTrack,
+					      G4double prevStep,
+					      G4ForceCondition* condition) {
+  G4double mfp = G4CMPVDriftProcess::GetMeanFreePath(aTrack, prevStep,
+						     condition);
+
+  G4int nMacro = G4CMPConfigManager::GetLukeMacroSteps();
+  if (nMacro < 2) return mfp;
+
+  // Emissions must be collected however the step ends
+  *condition = Forced;
+
+  return (mfp < DBL_MAX/nMacro) ? nMacro*mfp : DBL_MAX;
+}
+
 G4VParticleChange* G4CMPLukeScattering::PostStepDoIt(const G4Track& aTrack,
                                                      const G4Step& aStep) {
+  if (G4CMPConfigManager::GetLukeMacroSteps() > 1)
+    return MacroStepDoIt(aTrack, aStep);
+
   // Is the initializer in the correct place or should it be after the
   // boundary check?
   InitializeParticleChange(GetValleyIndex(aTrack), aTrack);
@@ -369,3 +401,251 @@ G4VParticleChange* G4CMPLukeScattering::PostStepDoIt(const G4Track& aTrack,
   ClearNumberOfInteractionLengthLeft();
   return &aParticleChange;
 }
+
+
+// Emissions are placed along the step, on the uniform-field trajectory
+// between pre- and post-step momenta, with each recoil applied at its own
+// emission time.  Emission times are drawn by thinning a Poisson process at
+// the larger of the rates at the ends of each interval (rate increases with
+// |k|, which is convex in time between emissions).
+
+G4VParticleChange*
+G4CMPLukeScattering::MacroStepDoIt(const G4Track& aTrack,
+				   const G4Step& aStep) {
+  InitializeParticleChange(GetValleyIndex(aTrack), aTrack);
+  ClearNumberOfInteractionLengthLeft();
+
+  const G4double dt = aStep.GetDeltaTime();
+  if (dt <= 0.) return &aParticleChange;
+
+  G4int iValley = GetValleyIndex(aTrack);	// Doesn't change valley
+  G4double mass = (IsElectron() ? theLattice->GetElectronMass()
+		   : theLattice->GetHoleMass());
+  G4double massc2 = aTrack.GetDynamicParticle()->GetMass();
+  G4double l0 = (IsElectron() ? theLattice->GetElectronScatter()
+		 : theLattice->GetHoleScatter());
+  G4double vsound = theLattice->GetSoundSpeed();
+  G4double kSound = vsound*mass / (hbar_Planck*sqrt(1.-vsound*vsound/c_squared));
+
+  // Same rate as G4CMPLukeEmissionRate, from local carrier momentum
+  auto rate = [&](const G4ThreeVector& p) {
+    G4double kmag = GetSphericalK(iValley, p).mag();
+    return (kmag > kSound) ? 1./ChargeCarrierTimeStep(kmag/kSound, l0) : 0.;
+  };
+
+  // Momentum changes linearly over step, from field alone
+  const G4StepPoint* preStep = aStep.GetPreStepPoint();
+  G4ThreeVector p0 = GetLocalDirection(preStep->GetMomentum());
+  G4ThreeVector p1 = GetLocalMomentum(aTrack);
+  G4ThreeVector dpField = p1 - p0;
+
+  // Velocity is linear in momentum for both carriers (see MapPtoV_el)
+  G4double Etot = ((IsElectron() ? theLattice->MapPtoEkin(iValley, p1)
+		    : GetKineticEnergy(aTrack)) + mass*c_squared);
+  const G4double pToV = c_light / Etot;
+
+  // Keep a uniform random subset of emitted phonons (reservoir sampling)
+  const size_t nKeep = std::max(1, G4CMPConfigManager::GetLukeMacroPhonons());
+  keptQ.clear();
+  keptE.clear();
+  keptT.clear();
+  keptX.clear();
+
+  G4ThreeVector kick, shift;		// Sums of recoils and their effect
+  G4ThreeVector ptrk, qvec;
+  G4double Etrk=0., Ephonon=0., Esum=0.;
+  G4double t = 0.;
+  G4long nDone = 0;
+  while (true) {
+    G4double rmax = std::max(rate(p0 + kick), rate(p1 + kick));
+    if (rmax <= 0.) break;
+
+    G4double tnext = t - std::log(G4UniformRand())/rmax;
+    p0 += dpField * ((std::min(tnext,dt)-t)/dt);  // Field only, start of interval
+    t = tnext;
+    if (t >= dt) break;
+
+    ptrk = p0 + kick;
+    if (G4UniformRand()*rmax >= rate(ptrk)) continue;	// Thinning
+
+    Etrk = (IsElectron() ? theLattice->MapPtoEkin(iValley, ptrk)
+	    : sqrt(ptrk.mag2() + massc2*massc2) - massc2);
+
+    G4ThreeVector pbefore = ptrk;
+    if (!MakeEmission(iValley, kSound, massc2, ptrk, Etrk, qvec, Ephonon))
+      continue;
+
+    // Recoil changes velocity for the rest of the step
+    G4ThreeVector dp = ptrk - pbefore;
+    kick += dp;
+    shift += (pToV*(dt-t)) * dp;
+
+    // Offset at time t from recoils before this emission
+    G4ThreeVector offset = shift - (pToV*(dt-t))*kick;
+
+    Esum += Ephonon;
+    if (keptE.size() < nKeep) {
+      keptQ.push_back(qvec);
+      keptE.push_back(Ephonon);
+      keptT.push_back(t);
+      keptX.push_back(offset);
+    } else {
+      size_t j = size_t(G4UniformRand()*(nDone+1));
+      if (j < nKeep) {
+	keptQ[j] = qvec;
+	keptE[j] = Ephonon;
+	keptT[j] = t;
+	keptX[j] = offset;
+      }
+    }
+    nDone++;
+  }
+
+  if (verboseLevel > 1) {
+    G4cout << GetProcessName() << "::MacroStepDoIt: " << nDone
+	   << " emissions over " << dt/ns << " ns, " << Esum/eV << " eV in "
+	   << keptE.size() << " phonons" << G4endl;
+  }
+
+  if (nDone == 0) return &aParticleChange;
+
+  // Kept phonons are a uniform subset, so each stands for the same number
+  // of emissions; weighting by energy instead would bias the spectrum
+  G4double scale = G4double(nDone) / keptE.size();
+
+  // Positions along field-only parabola, offset by recoils before emission
+  G4ThreeVector x0 = preStep->GetPosition();
+  G4ThreeVector dxStep = aTrack.GetPosition() - x0;
+  G4ThreeVector accel = pToV * dpField;		// Velocity change over step
+  const G4VSolid* solid = GetCurrentTouchable()->GetSolid();
+
+  // Moving from pos by shift must stay in this volume, not in a daughter
+  auto staysInVolume = [&](const G4ThreeVector& pos,
+			   const G4ThreeVector& shift) {
+    G4double dist = shift.mag();
+    if (dist <= 0.) return true;
+    G4ThreeVector lpos = GetLocalPosition(pos);
+    if (solid->Inside(lpos) == kOutside ||
+	solid->DistanceToOut(lpos, GetLocalDirection(shift/dist)) < dist)
+      return false;
+    return (G4CMP::GetVolumeAtPoint(pos+shift) == aTrack.GetVolume());
+  };
+
+  G4double Edeposit = 0.;
+  aParticleChange.SetSecondaryWeightByProcess(true);
+  aParticleChange.SetNumberOfSecondaries(keptE.size());
+  for (size_t i=0; i<keptE.size(); i++) {
+    G4double weight =
+      G4CMP::ChoosePhononWeight(G4CMPConfigManager::GetLukeSampling());
+    if (weight <= 0.) {
+      Edeposit += scale*keptE[i];
+      continue;
+    }
+
+    G4double ti = keptT[i];
+    G4ThreeVector offset = keptX[i] + (0.5*ti*(ti-dt)/dt)*accel;
+    RotateToGlobalDirection(offset);
+
+    // Chord between end points is always inside crystal; fall back to it
+    G4ThreeVector pos = x0 + (ti/dt)*dxStep;
+    if (staysInVolume(pos, offset)) pos += offset;
+
+    G4Track* phonon = G4CMP::CreatePhonon(aTrack,
+					  G4PhononPolarization::UNKNOWN,
+					  GetGlobalDirection(keptQ[i]),
+					  keptE[i],
+					  preStep->GetGlobalTime() + ti,
+					  pos);
+    phonon->SetWeight(aTrack.GetWeight() * scale * weight);
+    aParticleChange.AddSecondary(phonon);
+  }
+
+  if (Edeposit > 0.) aParticleChange.ProposeNonIonizingEnergyDeposit(Edeposit);
+
+  // If user wants to track phonons immediately, put track back on stack
+  if (secondariesFirst && aParticleChange.GetNumberOfSecondaries() > 0 &&
+      aTrack.GetTrackStatus() == fAlive)
+    aParticleChange.ProposeTrackStatus(fSuspend);
+
+  // Recoils move the end point, unless step was limited by the surface or
+  // the move would leave the volume.  Navigator is relocated to the new
+  // point, as after the boundary processes' surface walk.
+  const G4StepPoint* postStep = aStep.GetPostStepPoint();
+  if (postStep->GetStepStatus() != fGeomBoundary) {
+    RotateToGlobalDirection(shift);
+    if (shift.mag() < postStep->GetSafety() ||
+	staysInVolume(aTrack.GetPosition(), shift)) {
+      G4ThreeVector endPos = aTrack.GetPosition() + shift;
+      aParticleChange.ProposePosition(endPos);
+      G4TransportationManager::GetTransportationManager()->
+	GetNavigatorForTracking()->LocateGlobalPointWithinVolume(endPos);
+    }
+  }
+
+  ptrk = p1 + kick;
+  RotateToGlobalDirection(ptrk);	// Update track in world coordinates
+  FillParticleChange(iValley, ptrk);
+
+  return &aParticleChange;
+}
+
+// Wavevector in spherical frame (where electrons act like holes) from
+// local carrier momentum
+
+G4ThreeVector G4CMPLukeScattering::GetSphericalK(G4int iValley,
+					       const G4ThreeVector& ptrk) const {
+  if (!IsElectron()) return ptrk / hbarc;
+
+  G4ThreeVector ktrk = theLattice->MapPtoK(iValley, ptrk);
+  return theLattice->EllipsoidalToSphericalTranformation(iValley, ktrk);
+}
+
+// Same kinematics as PostStepDoIt(), where carrier wavevector is taken in
+// spherical frame for electrons; recoil magnitude is set from energy.
+// Throws which would leave no recoil energy are repeated, as the rejection
+// loop in PostStepDoIt() does for out-of-cone phonons.
+
+G4bool G4CMPLukeScattering::MakeEmission(G4int iValley, G4double kSound,
+					 G4double massc2, G4ThreeVector& ptrk,
+					 G4double& Etrk, G4ThreeVector& qvec,
+					 G4double& Ephonon) const {
+  G4ThreeVector ktrk = GetSphericalK(iValley, ptrk);
+  G4double kmag = ktrk.mag();
+  if (kmag <= kSound) return false;
+
+  G4ThreeVector kdir = ktrk / kmag;
+  G4double q = 0.;
+
+  const G4int maxThrows = 1000;		// Avoids potential infinite loop
+  G4int iThrow = 0;
+  do {
+    if (iThrow++ >= maxThrows) {
+      G4cerr << GetProcessName() << " ERROR: Unable to generate phonon after "
+	     << maxThrows << " attempts" << G4endl;
+      return false;
+    }
+
+    G4double theta = MakePhononTheta(kmag, kSound);
+    q = 2.*(kmag*cos(theta)-kSound);
+
+    qvec = q*kdir;
+    qvec.rotate(kdir.orthogonal(), theta);
+    qvec.rotate(kdir, G4UniformRand()*twopi);
+
+    Ephonon = MakePhononEnergy(q);
+  } while (Ephonon >= Etrk);
+
+  Etrk -= Ephonon;
+
+  G4ThreeVector krecoil = ktrk - qvec;
+  if (IsElectron()) {
+    qvec = q * theLattice->SphericalToEllipsoidalTranformation(iValley, qvec).unit();
+    krecoil = theLattice->SphericalToEllipsoidalTranformation(iValley, krecoil);
+    ptrk = theLattice->MapEkintoP(iValley, theLattice->MapKtoP(iValley, krecoil),
+				  Etrk);
+  } else {
+    ptrk = krecoil.unit() * sqrt(Etrk*(Etrk+2.*massc2));
+  }
+
+  return true;
+}
@@ -22,14 +22,33 @@
 // 20190919  BUG FIX:  2D project functions need 'break' in switch statements.
 // 20200519  Move local "static" buffers to class for thread safety.
 // 20210323  For 2D radial fields, need to manually protect rho < 0.
+// 20261016  Read EPot file in one pass; reuse binary mesh cache if the
+//		file contents and voltage scale are unchanged.
+// 20261016  Add AddPotential(), GetPotentials() to share one mesh among
+//		several potentials (e.g., Ramo weighting potentials).
+// 20261016  Add EvaluateBatch() to pass arrays of points to interpolator.
+// 20261016  Add BuildFieldGrid() to resample 3D field onto regular grid,
+//		used by GetFieldValue() except in cells flagged for mesh.
+// 20261016  Write mesh cache only under configured cache directory.
+// 20261016  Add SameMeshPoints(), ReadPotential() so callers can probe
+//		fields quietly, reading each file once; AddPotential() always
+//		reports mismatches.
+// 20261016  BuildFieldGrid() also checks field at cell faces and edges.
+// 20261016  Build field grid on first GetFieldValue(), not in constructors;
+//		2D meshes skip the grid without a warning.
 
 #include "G4CMPMeshElectricField.hh"
 #include "G4CMPBiLinearInterp.hh"
 #include "G4CMPConfigManager.hh"
 #include "G4CMPTriLinearInterp.hh"
+#include "G4AutoLock.hh"
 #include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <iterator>
+#include <sstream>
 
 using std::array;
 using std::vector;
@@ -88,7 +107,7 @@ G4CMPMeshElectricField(const G4CMPVMeshInterpolator* mesh,
 
 G4CMPMeshElectricField::G4CMPMeshElectricField(const G4CMPMeshElectricField &p)
   : G4ElectricField(p), Interp(p.Interp->Clone()), xCoord(p.xCoord),
-    yCoord(p.yCoord) {;}
+    yCoord(p.yCoord), Grid(p.Grid) {;}
 
 G4CMPMeshElectricField& 
 G4CMPMeshElectricField::operator=(const G4CMPMeshElectricField &p) {
@@ -99,6 +118,7 @@ G4CMPMeshElectricField::operator=(const G4CMPMeshElectricField &p) {
     Interp = p.Interp->Clone();
     xCoord = p.xCoord;
     yCoord = p.yCoord;
+    Grid = p.Grid;
   }
 
   return *this;
@@ -140,22 +160,136 @@ void G4CMPMeshElectricField::BuildInterp(const G4String& EPotFileName,
     G4cout << G4endl;
   }
 
-  vector<array<G4double,4> > tempX;
-  array<G4double,4> temp = {{ 0, 0, 0, 0 }};
-  G4double x,y,z,v;
+  const std::string contents = ReadEPotFile(EPotFileName);
+  if (contents.empty()) return;
+
+  const G4String cacheName = MeshCacheName(EPotFileName);
+  const G4bool useCache = !cacheName.empty();
+  const std::uint64_t cacheKey = useCache ? MeshCacheKey(contents, VScale) : 0;
+
+  if (useCache) {
+    G4CMPTriLinearInterp* cached = new G4CMPTriLinearInterp;
+    if (cached->LoadMeshCache(cacheName, cacheKey)) {
+      if (Interp) delete Interp;
+      Interp = cached;
+      return;
+    }
+
+    delete cached;
+  }
+
+  vector<array<G4double,3> > X;
+  vector<G4double> V;
+  ParseEPot(contents, VScale, X, V);
  
-  G4double vmin=99999., vmax=-99999.;
-  std::ifstream epotFile(EPotFileName);
+  if (Interp) delete Interp;
+  G4CMPTriLinearInterp* tli = new G4CMPTriLinearInterp(X, V);
+  Interp = tli;
+
+  if (useCache) tli->SaveMeshCache(cacheName, cacheKey);
+}
+
+
+// Load additional potential from file with identical mesh points
+
+G4int G4CMPMeshElectricField::AddPotential(const G4String& EPotFileName,
+					   G4double VScale) {
+  if (G4CMPConfigManager::GetVerboseLevel() > 0) {
+    G4cout << "G4CMPMeshElectricField::AddPotential " << EPotFileName;
+    if (VScale != 1.) G4cout << " rescaled by " << VScale;
+    G4cout << G4endl;
+  }
+
+  vector<array<G4double,3> > X;
+  vector<G4double> V;
+  if (!ReadPotential(EPotFileName, VScale, X, V)) return -1;
+
+  if (xCoord == kUndefined && Interp && !SameMeshPoints(X)) {
+    G4ExceptionDescription msg;
+    msg << EPotFileName << " mesh points do not match existing field.";
+    G4Exception("G4CMPMeshElectricField::AddPotential", "G4CMPEM003",
+		JustWarning, msg);
+    return -1;
+  }
+
+  return AddPotential(X, V);
+}
+
+// Add potential already read from file (see ReadPotential())
+
+G4int G4CMPMeshElectricField::AddPotential(const vector<array<G4double,3> >& X,
+					   const vector<G4double>& V) {
+  G4CMPTriLinearInterp* tli = dynamic_cast<G4CMPTriLinearInterp*>(Interp);
+  if (!tli || xCoord != kUndefined) {
+    G4Exception("G4CMPMeshElectricField::AddPotential", "G4CMPEM002",
+		JustWarning, "Additional potentials require 3D mesh from file");
+    return -1;
+  }
+
+  if (X.size() != V.size() || !tli->SameMeshPoints(X)) {
+    G4Exception("G4CMPMeshElectricField::AddPotential", "G4CMPEM003",
+		JustWarning, "Mesh points do not match existing field");
+    return -1;
+  }
+
+  return Interp->AddValues(V);
+}
+
+// Quiet check of mesh points, for callers choosing among several fields
+
+G4bool G4CMPMeshElectricField::
+SameMeshPoints(const vector<array<G4double,3> >& X) const {
+  const G4CMPTriLinearInterp* tli =
+    dynamic_cast<const G4CMPTriLinearInterp*>(Interp);
+  return (tli && xCoord == kUndefined && tli->SameMeshPoints(X));
+}
+
+// Read and parse EPot file, without building a mesh
+
+G4bool G4CMPMeshElectricField::ReadPotential(const G4String& EPotFileName,
+					     G4double VScale,
+					     vector<array<G4double,3> >& X,
+					     vector<G4double>& V) {
+  const std::string contents = ReadEPotFile(EPotFileName);
+  if (contents.empty()) return false;
+
+  ParseEPot(contents, VScale, X, V);
+  return true;
+}
+
+
+// Read entire file; contents are used for both parsing and cache key
+
+std::string 
+G4CMPMeshElectricField::ReadEPotFile(const G4String& EPotFileName) {
+  std::ifstream epotFile(EPotFileName, std::ios::binary);
   if (!epotFile.good()) {
     G4ExceptionDescription msg;
     msg << "Unable to open " << EPotFileName;
-    G4Exception("G4CMPMeshElectricField::BuildInterp", "G4CMPEM001",
+    G4Exception("G4CMPMeshElectricField::ReadEPotFile", "G4CMPEM001",
                FatalException, msg);
-    return;
+    return "";
   }
 
-  while (epotFile.good() && !epotFile.eof()) {
-    epotFile >> x >> y >> z >> v;
+  return std::string((std::istreambuf_iterator<char>(epotFile)),
+		     std::istreambuf_iterator<char>());
+}
+
+// Convert lines of x, y, z, V into mesh points and values, sorted by position
+
+void G4CMPMeshElectricField::ParseEPot(const std::string& contents,
+				       G4double VScale,
+				       vector<array<G4double,3> >& X,
+				       vector<G4double>& V) {
+  vector<array<G4double,4> > tempX;
+  array<G4double,4> temp = {{ 0, 0, 0, 0 }};
+  G4double x,y,z,v;
+ 
+  G4double vmin=99999., vmax=-99999.;
+  std::istringstream epotData(contents);
+
+  while (epotData.good() && !epotData.eof()) {
+    epotData >> x >> y >> z >> v;
     temp[0] = x*m;
     temp[1] = y*m;
     temp[2] = z*m;
@@ -165,7 +299,6 @@ void G4CMPMeshElectricField::BuildInterp(const G4String& EPotFileName,
     if (temp[3]<vmin) vmin = temp[3];
     if (temp[3]>vmax) vmax = temp[3];
   }
-  epotFile.close();
 
   if (G4CMPConfigManager::GetVerboseLevel() > 1) {
     G4cout << " Voltage from " << vmin/volt << " to " << vmax/volt << " V"
@@ -174,8 +307,8 @@ void G4CMPMeshElectricField::BuildInterp(const G4String& EPotFileName,
 
   std::sort(tempX.begin(),tempX.end(), vector_comp);
  
-  vector<array<G4double,3> > X(tempX.size(), {{0,0,0}});
-  vector<G4double> V(tempX.size(),0);
+  X.assign(tempX.size(), {{0,0,0}});
+  V.assign(tempX.size(), 0);
   for (size_t ii = 0; ii < tempX.size(); ++ii)
   {
     X[ii][0] = tempX[ii][0];
@@ -183,9 +316,38 @@ void G4CMPMeshElectricField::BuildInterp(const G4String& EPotFileName,
     X[ii][2] = tempX[ii][2];
     V[ii] = tempX[ii][3];
   }
- 
-  if (Interp) delete Interp;
-  Interp = new G4CMPTriLinearInterp(X, V);
+}
+
+
+// Cache file goes in user-specified directory; none if directory not set,
+// since EPot files are often in read-only or shared installations
+
+G4String 
+G4CMPMeshElectricField::MeshCacheName(const G4String& EPotFileName) const {
+  const G4String& cacheDir = G4CMPConfigManager::GetMeshCacheDir();
+  if (!G4CMPConfigManager::UseMeshCache() || cacheDir.empty()) return "";
+
+  size_t slash = EPotFileName.find_last_of('/');
+  G4String baseName = (slash == std::string::npos) ? EPotFileName
+    : G4String(EPotFileName.substr(slash+1));
+
+  return cacheDir + "/" + baseName + ".g4cmpmesh";
+}
+
+// Hash of file contents and voltage scale (64-bit FNV-1a)
+
+std::uint64_t 
+G4CMPMeshElectricField::MeshCacheKey(const std::string& contents,
+				     G4double VScale) const {
+  const std::uint64_t fnvPrime = 0x100000001b3ULL;
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+  for (unsigned char c: contents) { hash ^= c; hash *= fnvPrime; }
+
+  const unsigned char* vs = reinterpret_cast<const unsigned char*>(&VScale);
+  for (size_t i=0; i<sizeof(VScale); i++) { hash ^= vs[i]; hash *= fnvPrime; }
+
+  return hash;
 }
 
 
@@ -193,6 +355,12 @@ void G4CMPMeshElectricField::BuildInterp(const G4String& EPotFileName,
 
 void G4CMPMeshElectricField::GetFieldValue(const G4double Point[3],
 					   G4double *BEfield) const {
+  const FieldGrid* grid = GetFieldGrid();
+  if (grid && GridFieldValue(*grid, Point, BEfield+3)) {
+    BEfield[0] = BEfield[1] = BEfield[2] = 0.;
+    return;
+  }
+
   G4ThreeVector InterpField;
   if (xCoord == kUndefined) {		// Three dimensions
     InterpField = Interp->GetGrad(Point,true);
@@ -220,6 +388,319 @@ G4double G4CMPMeshElectricField::GetPotential(const G4double Point[3]) const {
 }
 
 
+// Evaluate all potentials on mesh with a single search
+
+G4int G4CMPMeshElectricField::GetNumberOfPotentials() const {
+  return Interp ? Interp->GetNumberOfValueSets() : 0;
+}
+
+void G4CMPMeshElectricField::GetPotentials(const G4double Point[3],
+					   G4double V[]) const {
+  if (xCoord == kUndefined) {		// Three dimensions
+    Interp->GetValues(Point, V, true);
+  } else {				// Two dimensions
+    G4double proj[2] = { 0.,0. };
+    Project2D(Point, proj);
+    Interp->GetValues(proj, V, true);
+  }
+}
+
+void G4CMPMeshElectricField::GetFieldAndPotentials(const G4double Point[3],
+						   G4double *BEfield,
+						   G4double V[]) const {
+  G4ThreeVector InterpField;
+  if (xCoord == kUndefined) {		// Three dimensions
+    InterpField = Interp->GetGradValues(Point, V, true);
+  } else {				// Two dimensions
+    G4double proj[2] = { 0.,0. };
+    Project2D(Point, proj);
+    InterpField = Interp->GetGradValues(proj, V, true);
+    Expand2Dat(Point, InterpField);
+  }
+
+  for (size_t i = 0; i < 3; ++i) {
+    BEfield[i] = 0.0;
+    BEfield[3+i] = -1 * InterpField[i];
+  }
+}
+
+
+// Evaluate arrays of points with one call to interpolator
+
+void G4CMPMeshElectricField::EvaluateBatch(size_t npts,
+					   const G4double Points[],
+					   G4double Efield[],
+					   G4double V[]) const {
+  vector<G4ThreeVector> grads(Efield ? npts : 0);
+  G4ThreeVector* gradBuf = (Efield ? grads.data() : nullptr);
+
+  if (xCoord == kUndefined) {		// Three dimensions
+    Interp->EvaluateBatch(npts, Points, V, gradBuf, true);
+  } else {				// Two dimensions
+    vector<G4double> proj(2*npts);
+    for (size_t i=0; i<npts; i++) Project2D(Points+3*i, &proj[2*i]);
+
+    Interp->EvaluateBatch(npts, proj.data(), V, gradBuf, true);
+    if (Efield) {
+      for (size_t i=0; i<npts; i++) Expand2Dat(Points+3*i, grads[i]);
+    }
+  }
+
+  if (!Efield) return;
+
+  for (size_t i=0; i<npts; i++) {
+    for (size_t j=0; j<3; j++) Efield[3*i+j] = -1 * grads[i][j];
+  }
+}
+
+
+// Sample field at nodes of regular grid, and at the center of each cell,
+// face and edge.  A cell is used only if all of those points are inside
+// the hull, the field at each corner is within tolerance of the center,
+// and the trilinear value (mean of the corners of that cell, face or edge)
+// matches the mesh field within tolerance at every sample point.  Checking
+// faces and edges catches field features which cross the cell without
+// changing the corners or center much.
+
+std::shared_ptr<const G4CMPMeshElectricField::FieldGrid>
+G4CMPMeshElectricField::MakeFieldGrid() const {
+  const G4double step = G4CMPConfigManager::GetFieldGridStep();
+  if (step <= 0. || !Interp) return nullptr;
+
+  // 2D meshes are already fast to search, and always use mesh directly
+  const G4CMPTriLinearInterp* tli =
+    dynamic_cast<const G4CMPTriLinearInterp*>(Interp);
+  if (!tli || xCoord != kUndefined) return nullptr;
+
+  auto grid = std::make_shared<FieldGrid>();
+
+  G4double xmax[3];
+  tli->GetMeshBounds(grid->Min.data(), xmax);
+
+  // Choose number of cells to get step, or slightly smaller
+  const G4double maxNodes = 1<<26;	// About 1.5 GB of field values
+  G4double nodes = 1.;
+  for (G4int dim=0; dim<3; dim++) {
+    G4double extent = xmax[dim] - grid->Min[dim];
+    G4double ncell = std::max(std::ceil(extent/step), 1.);
+    nodes *= ncell+1.;
+    if (nodes > maxNodes) break;	// Avoid overflowing G4int below
+
+    grid->N[dim] = G4int(ncell);
+    grid->Step[dim] = (extent > 0. ? extent/ncell : step);
+  }
+
+  if (nodes > maxNodes) {
+    G4ExceptionDescription msg;
+    msg << "Field grid step " << step/mm << " mm needs more than "
+	<< maxNodes << " points, using mesh directly";
+    G4Exception("G4CMPMeshElectricField::BuildFieldGrid", "G4CMPEM005",
+		JustWarning, msg);
+    return nullptr;
+  }
+
+  const G4int nx = grid->N[0]+1, ny = grid->N[1]+1, nz = grid->N[2]+1;
+  const size_t nnodes = size_t(nx)*ny*nz;
+
+  // Field at grid points, in same order as mesh search walks through them
+  grid->E.assign(3*nnodes, 0.);
+  vector<char> inside(nnodes, 0);
+
+  G4double pt[3];
+  size_t inode = 0;
+  for (G4int k=0; k<nz; k++) {
+    pt[2] = grid->Min[2] + k*grid->Step[2];
+    for (G4int j=0; j<ny; j++) {
+      pt[1] = grid->Min[1] + j*grid->Step[1];
+      for (G4int i=0; i<nx; i++, inode++) {
+	pt[0] = grid->Min[0] + i*grid->Step[0];
+	if (!tli->IsInside(pt)) continue;
+
+	inside[inode] = 1;
+	G4ThreeVector grad = tli->GetGrad(pt, true);
+	for (G4int dim=0; dim<3; dim++) grid->E[3*inode+dim] = -grad[dim];
+      }
+    }
+  }
+
+  const G4double tol = G4CMPConfigManager::GetFieldGridTolerance();
+  const size_t off[3] = { 1, size_t(nx), size_t(nx)*ny };
+
+  // Mesh field at point compared with mean of grid nodes around it
+  auto matches = [&](const G4double p[3], const size_t* around, G4int n) {
+    for (G4int c=0; c<n; c++) if (!inside[around[c]]) return false;
+    if (!tli->IsInside(p)) return false;
+
+    G4ThreeVector mesh = -tli->GetGrad(p, true), mean;
+    for (G4int c=0; c<n; c++) {
+      const G4double* e = &grid->E[3*around[c]];
+      mean += G4ThreeVector(e[0], e[1], e[2]) / n;
+    }
+
+    return ((mean-mesh).mag() <= tol*mesh.mag());
+  };
+
+  // Edge midpoints and face centers, flagged by lowest node.  Edge along
+  // axis d, and face normal to axis d, are shared by neighbouring cells.
+  vector<char> edgeOK[3], faceOK[3];
+  for (G4int d=0; d<3; d++) {
+    edgeOK[d].assign(nnodes, 0);
+    faceOK[d].assign(nnodes, 0);
+  }
+
+  size_t around[4];
+  inode = 0;
+  for (G4int k=0; k<nz; k++) {
+    for (G4int j=0; j<ny; j++) {
+      for (G4int i=0; i<nx; i++, inode++) {
+	if (!inside[inode]) continue;
+
+	const G4int idx[3] = { i, j, k };
+	G4double node[3];
+	for (G4int dim=0; dim<3; dim++)
+	  node[dim] = grid->Min[dim] + idx[dim]*grid->Step[dim];
+
+	for (G4int d=0; d<3; d++) {
+	  const G4int a = (d+1)%3, b = (d+2)%3;	// Axes spanning face
+
+	  if (idx[d] < grid->N[d]) {
+	    std::copy(node, node+3, pt);
+	    pt[d] += 0.5*grid->Step[d];
+	    around[0] = inode; around[1] = inode+off[d];
+	    edgeOK[d][inode] = matches(pt, around, 2);
+	  }
+
+	  if (idx[a] < grid->N[a] && idx[b] < grid->N[b]) {
+	    std::copy(node, node+3, pt);
+	    pt[a] += 0.5*grid->Step[a];
+	    pt[b] += 0.5*grid->Step[b];
+	    around[0] = inode;        around[1] = inode+off[a];
+	    around[2] = inode+off[b]; around[3] = inode+off[a]+off[b];
+	    faceOK[d][inode] = matches(pt, around, 4);
+	  }
+	}
+      }
+    }
+  }
+
+  // Compare corners of each cell with mesh field at center, and collect
+  // results for its twelve edges and six faces
+  const size_t corner[8] = { 0, off[0], off[1], off[0]+off[1],
+			     off[2], off[0]+off[2], off[1]+off[2],
+			     off[0]+off[1]+off[2] };
+
+  grid->UseMesh.assign(size_t(grid->N[0])*grid->N[1]*grid->N[2], 1);
+  size_t icell = 0, ngood = 0;
+  for (G4int k=0; k<grid->N[2]; k++) {
+    pt[2] = grid->Min[2] + (k+0.5)*grid->Step[2];
+    for (G4int j=0; j<grid->N[1]; j++) {
+      pt[1] = grid->Min[1] + (j+0.5)*grid->Step[1];
+      for (G4int i=0; i<grid->N[0]; i++, icell++) {
+	pt[0] = grid->Min[0] + (i+0.5)*grid->Step[0];
+
+	const size_t node0 = i + nx*(j + size_t(ny)*k);
+	if (!std::all_of(corner, corner+8, [&](size_t c) {
+	      return inside[node0+c] != 0; })) continue;
+
+	G4bool edgesOK = true;
+	for (G4int d=0; d<3 && edgesOK; d++) {
+	  const size_t a = off[(d+1)%3], b = off[(d+2)%3];
+	  edgesOK = (edgeOK[d][node0] && edgeOK[d][node0+a] &&
+		     edgeOK[d][node0+b] && edgeOK[d][node0+a+b] &&
+		     faceOK[d][node0] && faceOK[d][node0+off[d]]);
+	}
+	if (!edgesOK) continue;
+
+	if (!tli->IsInside(pt)) continue;
+	G4ThreeVector center = -tli->GetGrad(pt, true), mean;
+
+	G4double spread = 0.;
+	for (size_t c: corner) {
+	  const G4double* e = &grid->E[3*(node0+c)];
+	  G4ThreeVector corn(e[0], e[1], e[2]);
+	  spread = std::max(spread, (corn-center).mag());
+	  mean += corn / 8.;
+	}
+
+	grid->UseMesh[icell] = (spread > tol*center.mag() ||
+				(mean-center).mag() > tol*center.mag());
+	if (!grid->UseMesh[icell]) ngood++;
+      }
+    }
+  }
+
+  if (G4CMPConfigManager::GetVerboseLevel() > 0) {
+    G4cout << "G4CMPMeshElectricField::BuildFieldGrid: " << grid->N[0]
+	   << " x " << grid->N[1] << " x " << grid->N[2] << " cells, "
+	   << ngood << " within tolerance " << tol << G4endl;
+  }
+
+  return (ngood > 0) ? grid : nullptr;
+}
+
+// Grid is built on first use, so fields used only for potentials (e.g.,
+// Ramo weighting potentials) never build one.  Copies share the result.
+
+const G4CMPMeshElectricField::FieldGrid*
+G4CMPMeshElectricField::GetFieldGrid() const {
+  if (!Grid->ready.load(std::memory_order_acquire)) {
+    G4AutoLock gridLock(&Grid->mutex);
+    if (!Grid->ready.load(std::memory_order_relaxed)) {
+      Grid->grid = MakeFieldGrid();
+      Grid->ready.store(true, std::memory_order_release);
+    }
+  }
+
+  return Grid->grid.get();
+}
+
+// Replace grid for this field (copies made earlier keep existing grid)
+
+void G4CMPMeshElectricField::BuildFieldGrid() {
+  Grid = std::make_shared<GridState>();
+  Grid->grid = MakeFieldGrid();
+  Grid->ready = true;
+}
+
+// Trilinear interpolation between corners of cell containing point
+
+G4bool G4CMPMeshElectricField::GridFieldValue(const FieldGrid& grid,
+					      const G4double Point[3],
+					      G4double Efield[3]) const {
+
+  G4int idx[3];
+  G4double f[3];
+  for (G4int dim=0; dim<3; dim++) {
+    G4double u = (Point[dim]-grid.Min[dim]) / grid.Step[dim];
+    if (!(u >= 0. && u <= grid.N[dim])) return false;	// Also rejects NaN
+
+    idx[dim] = std::min(G4int(u), grid.N[dim]-1);
+    f[dim] = u - idx[dim];
+  }
+
+  if (grid.UseMesh[idx[0] + grid.N[0]*(idx[1] + size_t(grid.N[1])*idx[2])])
+    return false;
+
+  const size_t nx = grid.N[0]+1, nxy = nx*(grid.N[1]+1);
+  const G4double* e = &grid.E[3*(idx[0] + nx*idx[1] + nxy*idx[2])];
+  const size_t dy = 3*nx, dz = 3*nxy;
+
+  for (G4int dim=0; dim<3; dim++) {
+    const G4double* c = e+dim;
+    G4double c00 = c[0]     + f[0]*(c[3]       - c[0]);
+    G4double c10 = c[dy]    + f[0]*(c[dy+3]    - c[dy]);
+    G4double c01 = c[dz]    + f[0]*(c[dz+3]    - c[dz]);
+    G4double c11 = c[dy+dz] + f[0]*(c[dy+dz+3] - c[dy+dz]);
+
+    G4double c0 = c00 + f[1]*(c10-c00);
+    G4double c1 = c01 + f[1]*(c11-c01);
+    Efield[dim] = c0 + f[2]*(c1-c0);
+  }
+
+  return true;
+}
+
+
 // Convert between 3D and 2D coordinates for projected meshes
 
 namespace {
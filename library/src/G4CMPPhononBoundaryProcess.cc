@@ -41,6 +41,12 @@
 // 20250429  G4CMP-461 -- Implement ability to skip flats during displacement.
 // 20250505  G4CMP-458 -- Rename GetReflectedVector to GetSpecularVector.
 // 20250505  G4CMP-471 -- Update diagnostic output for surface displacement loop.
+// 20261016  Read surface parameters from flat record; fill records at run start.
+// 20261016  Move surface displacement loop to G4CMPSolidUtils; try analytic
+//		walk on G4Box and G4Tubs first.
+// 20261016  Apply phonon weight window after reflection; boundary decay may
+//		have any number of daughters after splitting or roulette.
+// 20261016  Use proposed time of reflected phonon for window importance.
 
 #include "G4CMPPhononBoundaryProcess.hh"
 #include "G4CMPAnharmonicDecay.hh"
@@ -48,6 +54,7 @@
 #include "G4CMPGeometryUtils.hh"
 #include "G4CMPParticleChangeForPhonon.hh"
 #include "G4CMPPhononTrackInfo.hh"
+#include "G4CMPPhononWeightWindow.hh"
 #include "G4CMPSolidUtils.hh"
 #include "G4CMPSurfaceProperty.hh"
 #include "G4CMPTrackUtils.hh"
@@ -65,6 +72,7 @@
 #include "G4Step.hh"
 #include "G4StepPoint.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
 #include "G4ThreeVector.hh"
 #include "G4Track.hh"
 #include "G4TransportationManager.hh"
@@ -101,6 +109,15 @@ void G4CMPPhononBoundaryProcess::LoadDataForTrack(const G4Track* track) {
 }
 
 
+// Surface tables are complete once geometry is built; copy to flat records
+
+void G4CMPPhononBoundaryProcess::
+BuildPhysicsTable(const G4ParticleDefinition&) {
+  if (G4Threading::IsMasterThread())
+    G4CMPSurfaceProperty::UpdateAllParameters();
+}
+
+
 // Compute and return step length
 
 G4double G4CMPPhononBoundaryProcess::
@@ -151,7 +168,7 @@ G4CMPPhononBoundaryProcess::PostStepDoIt(const G4Track& aTrack,
 
 G4bool G4CMPPhononBoundaryProcess::AbsorbTrack(const G4Track& aTrack,
                                                const G4Step& aStep) const {
-  G4double absMinK = GetMaterialProperty("absMinK");
+  G4double absMinK = surfParams->absMinK;
   G4ThreeVector k = G4CMP::GetTrackInfo<G4CMPPhononTrackInfo>(aTrack)->k();
 
   if (verboseLevel>1) {
@@ -195,9 +212,8 @@ DoReflection(const G4Track& aTrack, const G4Step& aStep,
   }
 
   G4double freq = GetKineticEnergy(aTrack)/h_Planck;	// E = hf, f = E/h
-  G4double specProb = surfProp->SpecularReflProb(freq);
-  G4double diffuseProb = surfProp->DiffuseReflProb(freq);
-  G4double downconversionProb = surfProp->AnharmonicReflProb(freq);
+  G4double specProb, diffuseProb, downconversionProb;
+  surfProp->ReflectionProbs(freq, specProb, diffuseProb, downconversionProb);
 
   // Empirical functions may lead to non normalised probabilities.
   // Normalise here.
@@ -224,16 +240,12 @@ DoReflection(const G4Track& aTrack, const G4Step& aStep,
 
     /* Do Downconversion */
     anharmonicDecay->DoDecay(aTrack, aStep, particleChange);
-    G4Track* sec1 = particleChange.GetSecondary(0);
-    G4Track* sec2 = particleChange.GetSecondary(1);
-
-    G4ThreeVector vec1 = G4CMP::GetLambertianVector(theLattice, surfNorm, mode,
-                                                    surfacePoint);
-    G4ThreeVector vec2 = G4CMP::GetLambertianVector(theLattice, surfNorm, mode,
-                                                    surfacePoint);
 
-    sec1->SetMomentumDirection(vec1);
-    sec2->SetMomentumDirection(vec2);
+    for (G4int i=0; i<particleChange.GetNumberOfSecondaries(); i++) {
+      G4ThreeVector vec = G4CMP::GetLambertianVector(theLattice, surfNorm,
+						     mode, surfacePoint);
+      particleChange.GetSecondary(i)->SetMomentumDirection(vec);
+    }
 
     return;
   } else if (random < downconversionProb + specProb) {
@@ -271,6 +283,16 @@ DoReflection(const G4Track& aTrack, const G4Step& aStep,
     DoSimpleKill(aTrack, aStep, particleChange);
     return;
   }
+
+  // Split or roulette reflected phonon according to its new importance
+  const G4CMPPhononWeightWindow* window =
+    G4CMPConfigManager::GetPhononWeightWindow();
+  if (window) {
+    G4ThreeVector pos = GetLocalPosition(*particleChange.GetPosition());
+    G4double imp = window->GetImportance(GetKineticEnergy(aTrack),
+					 particleChange.GetGlobalTime(), pos);
+    window->ApplyToTrack(aTrack, imp, particleChange);
+  }
 }
 
 // Generate specular reflection corrected for momentum dispersion
@@ -302,126 +324,35 @@ GetSpecularVector(const G4ThreeVector& waveVector,
   G4CMPSolidUtils solidUtils(solid, verboseLevel, GetProcessName());
 
   G4ThreeVector stepLocalPos = GetLocalPosition(surfacePoint);
-  G4ThreeVector oldNorm = newNorm;
-  G4ThreeVector oldstepLocalPos = stepLocalPos;
-
-  // Break up wavevector to perp and tan components
-  G4double kPerpMag = reflectedKDir.dot(newNorm);
-  G4ThreeVector kPerpV = kPerpMag * newNorm;		// Negative implied in kPerpMag for inward pointing
-  G4ThreeVector kTan = reflectedKDir - kPerpV;		// Get kTan: reflectedKDir = kPerpV + kTan
-
-  // Get axis and phi for tangent rotations
-  G4ThreeVector axis = kPerpV.cross(kTan).unit();
-  G4double phi = 0.;
-  EInside isIn = solid->Inside(stepLocalPos);
-
-  G4int nAttempts = 0;
 
   // Initialize stepSize for _this_ solid object
   G4CMPConfigManager* config = G4CMPConfigManager::Instance();
   stepSize = config->GetPhononSurfStepSize();
 
-  // Get flat skip step size dependent on solid
-  G4ThreeVector pmin(0,0,0);
-  G4ThreeVector pmax(0,0,0);
-  solid->BoundingLimits(pmin, pmax);
-  G4double flatStepSize = (pmax - pmin).mag();
-
   // Set default stepSize based on solid bounding limits
-  if (stepSize == 0) stepSize = flatStepSize / 1000;
-
-  if (verboseLevel>3) {
-    G4cout << "GetSpecularVector:beforeLoop -> "
-	   << ", stepLocalPos = " << stepLocalPos/mm << " mm"
-	   << ", reflectedKDir = " << reflectedKDir
-	   << ", newNorm = " << newNorm
-	   << ", kPerpMag (newNorm dot reflectedKDir) = " << kPerpMag
-	   << ", kPerpV (kPerpMag * newNorm) = " << kPerpV
-	   << ", kTan (reflectedKDir - kPerpV) = " << kTan
-	   << ", surfaceStepSize = " << G4BestUnit(stepSize, "Length")
-	   << ", nStepLimit = " << nStepLimit << G4endl;
+  if (stepSize == 0) {
+    G4ThreeVector pmin(0,0,0);
+    G4ThreeVector pmax(0,0,0);
+    solid->BoundingLimits(pmin, pmax);
+    stepSize = (pmax - pmin).mag() / 1000;
   }
 
-  // Assumes everything is in Global. Just add the GetGlobal in the loop conditions.
-  while (!G4CMP::PhononVelocityIsInward(theLattice, mode,
-   GetGlobalDirection(reflectedKDir), GetGlobalDirection(newNorm),
-   GetGlobalPosition(stepLocalPos)) && nAttempts++ < nStepLimit) {
-    // Save previous loop values
-    oldstepLocalPos = stepLocalPos;
-    oldNorm = newNorm;
-
-    // Step along kTan direction - this point is now outside the detector
-    stepLocalPos += stepSize * kTan.unit();
-
-    // Get the local normal at the new surface point
-    newNorm = solid->SurfaceNormal(stepLocalPos);
-    // Check position status for flat skipper
-    isIn = solid->Inside(stepLocalPos);
-
-    // Check if the phonon is on a flat. Must be on the solid surface
-    if (oldNorm == newNorm && isIn == kSurface) {
-      // Adjust stepLocalPos to edge of the flat (still on the flat)
-      // Modifies stepLocalPos and kTan in place
-      solidUtils.AdjustOffFlats(stepLocalPos, kTan, flatStepSize, newNorm, 0);
-      // Do a diffuse reflection if stuck in regression
-      if (solid->Inside(stepLocalPos) != kSurface) {
-        reflectedKDir = newNorm;
-        break;
-      }
-      // Step off the flat and adjust newNorm
-      stepLocalPos += stepSize * kTan.unit();
-      newNorm = solid->SurfaceNormal(stepLocalPos);
-    }
-
-    // Adjust stepLocalPos back to surface of detector
-    solidUtils.AdjustToClosestSurfacePoint(stepLocalPos, -newNorm);
-    // Check position status for edge reflections
-    isIn = solid->Inside(stepLocalPos);
-
-    // Large normal changes and not being on surface after initial adjustment
-    // indicates we are approaching an edge
-    if (isIn != kSurface || newNorm * oldNorm <= 0) {
-      // Reset stepLocalPos and newNorm to last valid surface point
-      stepLocalPos = oldstepLocalPos;
-      newNorm = oldNorm;
-      // Modify stepLocalPos in place to edge position
-      solidUtils.AdjustToEdgePosition(kTan, stepLocalPos, stepSize, 1);
-      // Do a diffuse reflection if the adjustment failed
-      if (solid->Inside(stepLocalPos) != kSurface) {
-        reflectedKDir = newNorm;
-        break;
-      }
-      // Reflect kTan against the edge - rotates & modifies kTan; modifies newNorm
-      solidUtils.ReflectAgainstEdge(kTan, stepLocalPos, newNorm);
-    } else {
-      // Rotate kTan to new position
-      axis = newNorm.cross(kTan).unit();
-      phi = oldNorm.azimAngle(newNorm, axis);
-      kTan = kTan.rotate(axis, phi);
-    }
+  // Same as PhononVelocityIsInward(), with everything in local coordinates
+  auto velocityIsInward = [this, mode, solid](const G4ThreeVector& k,
+					      const G4ThreeVector& norm,
+					      const G4ThreeVector& pos) {
+    G4ThreeVector vDir = theLattice->MapKtoVDir(mode, k);
+    return (vDir.dot(norm) < 0.0 &&
+	    solid->Inside(pos + 1*nm*vDir) == kInside);
+  };
 
-    // Get perpendicular component of reflected k w/ new norm
-    // (negative implied in kPerpMag for inward pointing)
-    kPerpV = kPerpMag * newNorm;
-
-    // Calculate new reflectedKDir (kTan + kPerpV) and Vg
-    reflectedKDir = kTan + kPerpV;
-    G4ThreeVector vDir = theLattice->MapKtoVDir(mode, reflectedKDir);
-
-    if (verboseLevel>3) {
-      G4cout << " GetSpecularVector:insideLoop -> "
-	     << " attempts = " << nAttempts
-	     << ", oldstepLocalPos = " << oldstepLocalPos/mm << " mm"
-	     << ", stepLocalPos = " << stepLocalPos/mm << " mm"
-	     << ", oldNorm = " << oldNorm
-	     << ", newNorm = " << newNorm
-	     << ", kPerpMag = " << kPerpMag
-	     << ", kPerpV (kPerpMag * newNorm) = " << kPerpV
-	     << ", kTan = " << kTan
-	     << ", reflectedKDir (kTan + kPerpV) = " << reflectedKDir
-	     << ", Phonon mode = " << G4PhononPolarization::Label(mode)
-	     << ", New group velocity: " << vDir << G4endl;
-    }
+  // Box faces and cylinder sides are walked in closed form, others by steps
+  G4int nAttempts = 0;
+  if (!solidUtils.AnalyticSurfaceWalk(stepLocalPos, newNorm, reflectedKDir,
+				      stepSize, nStepLimit, velocityIsInward,
+				      nAttempts)) {
+    nAttempts = solidUtils.SurfaceWalk(stepLocalPos, newNorm, reflectedKDir,
+				       stepSize, nStepLimit, velocityIsInward);
   }
 
   // Restore global coordinates to new vectors
@@ -38,6 +38,7 @@
 // 20250124  G4CMP-447 -- Add FillParticleChange() to update phonon track info
 // 20250422  N. Tenpas -- Add position arguments for PhononVelocityIsInward.
 // 20250423  N. Tenpas -- Replace duplicated GetLambertianVector() code.
+// 20261016  Cache filmAbsorption, to avoid string lookup at every hit.
 
 #include "G4CMPPhononElectrode.hh"
 #include "G4CMPGeometryUtils.hh"
@@ -60,7 +61,7 @@
 // Constructor and destructor
 
 G4CMPPhononElectrode::G4CMPPhononElectrode()
-  : G4CMPVElectrodePattern(), kaplanQP(0) {;}
+  : G4CMPVElectrodePattern(), kaplanQP(0), filmAbsorption(-1.) {;}
 
 G4CMPPhononElectrode::~G4CMPPhononElectrode() {
   delete kaplanQP; kaplanQP=0;
@@ -69,7 +70,10 @@ G4CMPPhononElectrode::~G4CMPPhononElectrode() {
 // Assumes that user has configured a border surface only at sensor pads
 
 G4bool G4CMPPhononElectrode::IsNearElectrode(const G4Step& /*step*/) const {
-  return G4UniformRand() < GetMaterialProperty("filmAbsorption");
+  if (filmAbsorption < 0.)
+    filmAbsorption = GetMaterialProperty("filmAbsorption");
+
+  return G4UniformRand() < filmAbsorption;
 }
 
 
@@ -3,30 +3,60 @@
 //
 //  20160624  Allow non-unit vector to be passed into computeKinematics()
 //  20170525  Drop unnecessary empty destructor ("rule of five" semantics)
+//  20261016  Replace NR eigensolver with closed-form 3x3 solver, and
+//		precompute elasticity contraction; add thread-safe interface
 
 #include "G4CMPPhononKinematics.hh"
 #include "G4LatticeLogical.hh"
 #include "G4PhononPolarization.hh"
+#include "G4PhysicalConstants.hh"
 #include "G4ThreeVector.hh"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+  // Voigt index (xx,yy,zz,yz,xz,xy) to pair of tensor indices
+  const int voigtI[6] = { 0, 1, 2, 1, 0, 0 };
+  const int voigtL[6] = { 0, 1, 2, 2, 2, 1 };
+}
 
 // ++++++++++++++++++++++ G4CMPPhononKinematics METHODS +++++++++++++++++++++++++++
 
 G4CMPPhononKinematics::G4CMPPhononKinematics(G4LatticeLogical *lat)
-  : lattice(lat), christoffel(G4ThreeVector::SIZE, G4ThreeVector::SIZE, 0.) {;}
+  : lattice(lat) {
+  updateElasticity();
+}
+
+// Copy elasticity tensor, symmetrized in (i,l), and scaled by density
+void G4CMPPhononKinematics::updateElasticity() {
+  const double density = lattice->GetDensity();
+
+  for (int a = 0; a < 6; a++) {
+    const int i = voigtI[a], l = voigtL[a];
+    for (int j = 0; j < G4ThreeVector::SIZE; j++) {
+      for (int m = 0; m < G4ThreeVector::SIZE; m++) {
+	cijlm[a][j][m] = 0.5*(lattice->GetCijkl(i,j,l,m) +
+			      lattice->GetCijkl(l,j,i,m)) / density;
+      }
+    }
+  }
+
+  last_ndir.set(0.,0.,0.);		// Discard any previous results
+}
 
 // Build D_il, the Christoffel matrix that defines the eigensystem
-void G4CMPPhononKinematics::fillChristoffelMatrix(const G4ThreeVector& nn)
-{
-  christoffel.clear();
-  for (int i = 0; i < G4ThreeVector::SIZE; i++) {
-    for (int l = 0; l < G4ThreeVector::SIZE; l++) {
-      for (int j = 0; j < G4ThreeVector::SIZE; j++) {
-	for (int m = 0; m < G4ThreeVector::SIZE; m++) {
-	  christoffel[i][l] += (lattice->GetCijkl(i,j,l,m) * nn[j] * nn[m]);
-	}
+void G4CMPPhononKinematics::fillChristoffelMatrix(const G4ThreeVector& nn,
+						  double dil[3][3]) const {
+  for (int a = 0; a < 6; a++) {
+    double d = 0.;
+    for (int j = 0; j < G4ThreeVector::SIZE; j++) {
+      for (int m = 0; m < G4ThreeVector::SIZE; m++) {
+	d += cijlm[a][j][m] * nn[j] * nn[m];
       }
-      christoffel[i][l] /= lattice->GetDensity();
     }
+
+    dil[voigtI[a]][voigtL[a]] = dil[voigtL[a]][voigtI[a]] = d;
   }
 }
 
@@ -34,19 +64,34 @@ void G4CMPPhononKinematics::fillChristoffelMatrix(const G4ThreeVector& nn)
 void G4CMPPhononKinematics::computeKinematics(const G4ThreeVector& n_dir) {
   if (n_dir.unit().isNear(last_ndir)) return;		// Already computed
 
+  solveModes(n_dir, vphase, slowness, polarization, vgroup);
+
+  /* Store wavevector direction to avoid recalculations */
+  last_ndir = n_dir.unit();
+}
+
+// Compute kinematics for all modes into caller's buffers; group velocity
+// is skipped if vg is null
+void G4CMPPhononKinematics::solveModes(const G4ThreeVector& n_dir,
+				       double vp[], G4ThreeVector slow[],
+				       G4ThreeVector epol[],
+				       G4ThreeVector vg[]) const {
+  const G4ThreeVector n_unit = n_dir.unit();
+
   /* get the Christoffel Matrix D_il, which is symmetric (it
      equals its transpose).  This also means its eigenvalues will
      all be real (NR, pg. 564) */
-  fillChristoffelMatrix(n_dir.unit());
-  
-  /* set up and solve eigensystem of D_il:
-     Use NR's method for real, symmetric matricies.
+  double christoffel[3][3];
+  fillChristoffelMatrix(n_unit, christoffel);
+
+  /* solve eigensystem of D_il:
      Eigenvalues are the phase velocities squared (v_phase = omega/k).
      Eigenvectors are the corresponding polaizrations e_l.
-     Eigenvalues stored in eigenSys.d[0..n-1] in descening order.
-     Corresponding eigenvectors are the columns of eigenSys.z[0..n-1][0..n-1] */
-  eigenSys.setup(christoffel);
-  
+     Eigenvalues stored in eigenVal[0..2] in descending order.
+     Corresponding eigenvectors are the columns of eigenVec[0..2][0..2] */
+  double eigenVal[3], eigenVec[3][3];
+  solveEigenSystem(christoffel, eigenVal, eigenVec);
+
   /* Extract eigen vectors and values for each mode.
    * We must sort them to match the sorting in G4PhononPolarization.
    * This assumes that fast transverse is more energetic than slow transverse,
@@ -57,9 +102,9 @@ void G4CMPPhononKinematics::computeKinematics(const G4ThreeVector& n_dir) {
   G4double mostParallelMeasure = 0;
   size_t longIdx = 0;
   for (size_t i = 0; i < 3; ++i) {
-    const G4double howParallel = G4ThreeVector(eigenSys.z[0][i],
-                                               eigenSys.z[1][i],
-                                               eigenSys.z[2][i])
+    const G4double howParallel = G4ThreeVector(eigenVec[0][i],
+                                               eigenVec[1][i],
+                                               eigenVec[2][i])
                                               .howOrthogonal(n_dir);
     if (howParallel > mostParallelMeasure) {
       mostParallelMeasure = howParallel;
@@ -86,38 +131,143 @@ void G4CMPPhononKinematics::computeKinematics(const G4ThreeVector& n_dir) {
     size_t idx = (mode == G4PhononPolarization::Long ? longIdx :
 		  mode == G4PhononPolarization::TransFast ? fastTransIdx :
 		  slowTransIdx);
-    vphase[mode] = sqrt(eigenSys.d[idx]);
-    slowness[mode] = n_dir.unit()/vphase[mode];
-    polarization[mode].set(eigenSys.z[G4ThreeVector::X][idx],
-                           eigenSys.z[G4ThreeVector::Y][idx],
-                           eigenSys.z[G4ThreeVector::Z][idx]);
-    
-    computeGroupVelocity(mode, idx, eigenSys.z, slowness[mode]);
+    vp[mode] = sqrt(eigenVal[idx]);
+    slow[mode] = n_unit/vp[mode];
+    epol[mode].set(eigenVec[G4ThreeVector::X][idx],
+		   eigenVec[G4ThreeVector::Y][idx],
+		   eigenVec[G4ThreeVector::Z][idx]);
+
+    if (vg) vg[mode] = computeGroupVelocity(epol[mode], slow[mode]);
   }
-  
-  /* Store wavevector direction to avoid recalculations */
-  last_ndir = n_dir.unit();
 }
 
-// Fill group velocity cache for specified mode from lattice parameters
-// NOTE:  Must only be called from computeKinematics() above!
-void G4CMPPhononKinematics::computeGroupVelocity(int mode,
-                                                 size_t idx,
-                                                 const matrix<double>& e_mat,
-                                                 const G4ThreeVector& slow) {
-  vgroup[mode].set(0.,0.,0.);
-  for (int dim=0; dim<G4ThreeVector::SIZE; dim++) {
-    for (int i=0; i<G4ThreeVector::SIZE; i++) {
-      for (int j=0; j<G4ThreeVector::SIZE; j++) {
-	for (int l=0; l<G4ThreeVector::SIZE; l++) {
-    vgroup[mode][dim] += (e_mat[i][idx] * lattice->GetCijkl(i,j,l,dim)
-        * slow[j] * e_mat[l][idx]);
-	}
-      }
+// Group velocity for polarization and slowness vector of one mode,
+// v_m = C_ijlm e_i e_l s_j / density
+G4ThreeVector
+G4CMPPhononKinematics::computeGroupVelocity(const G4ThreeVector& epol,
+					    const G4ThreeVector& slow) const {
+  G4ThreeVector vg;
+  for (int a = 0; a < 6; a++) {
+    // Off-diagonal (i,l) pairs appear twice in full sum
+    double eprod = epol[voigtI[a]] * epol[voigtL[a]] * (a<3 ? 1. : 2.);
+
+    for (int dim=0; dim<G4ThreeVector::SIZE; dim++) {
+      vg[dim] += eprod * (cijlm[a][0][dim]*slow[0] + cijlm[a][1][dim]*slow[1] +
+			  cijlm[a][2][dim]*slow[2]);
     }
   }
-  
-  vgroup[mode] /= lattice->GetDensity();
+
+  return vg;
+}
+
+// Thread-safe calculation does not use or change internal buffers
+G4ThreeVector
+G4CMPPhononKinematics::computeGroupVelocity(int mode,
+					    const G4ThreeVector& n_dir) const {
+  double vp[G4PhononPolarization::NUM_MODES];
+  G4ThreeVector slow[G4PhononPolarization::NUM_MODES];
+  G4ThreeVector epol[G4PhononPolarization::NUM_MODES];
+
+  solveModes(n_dir, vp, slow, epol, 0);		// Only one mode needed
+  return computeGroupVelocity(epol[mode], slow[mode]);
+}
+
+// Eigenvalues from closed-form (trigonometric) solution of characteristic
+// cubic.  The eigenvector of the most isolated eigenvalue is the cross
+// product of two rows of (A - w*I); the other two are found with a single
+// Jacobi rotation in the plane orthogonal to it, which stays accurate for
+// the degenerate transverse modes along crystal symmetry axes.
+void G4CMPPhononKinematics::solveEigenSystem(const double a[3][3],
+					     double eval[3], double evec[3][3]) {
+  const double p1 = a[0][1]*a[0][1] + a[0][2]*a[0][2] + a[1][2]*a[1][2];
+  const double q = (a[0][0] + a[1][1] + a[2][2]) / 3.;
+  const double p2 = (sqr(a[0][0]-q) + sqr(a[1][1]-q) + sqr(a[2][2]-q)
+		     + 2.*p1);
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) evec[i][j] = (i==j) ? 1. : 0.;
+  }
+
+  if (p2 <= 1e-30*q*q) {		// Isotropic: any basis will do
+    eval[0] = eval[1] = eval[2] = q;
+    return;
+  }
+
+  // Roots of characteristic polynomial, with B = (A - q*I)/p
+  const double p = std::sqrt(p2/6.);
+  const double invp = 1./p;
+  double b[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) b[i][j] = (a[i][j] - (i==j ? q : 0.)) * invp;
+  }
+
+  double r = 0.5 * (b[0][0]*(b[1][1]*b[2][2] - b[1][2]*b[2][1])
+		    - b[0][1]*(b[1][0]*b[2][2] - b[1][2]*b[2][0])
+		    + b[0][2]*(b[1][0]*b[2][1] - b[1][1]*b[2][0]));
+  r = std::min(std::max(r, -1.), 1.);
+
+  // Angle phi is in [0,pi/3], so sin(phi) >= 0; saves one call to cos()
+  const double phi = std::acos(r) / 3.;
+  const double w0 = q + 2.*p*std::cos(phi);
+  const double w2 = q + 2.*p*std::cos(phi + twopi/3.);
+  const double w1 = 3.*q - w0 - w2;
+
+  // Eigenvector of isolated eigenvalue: longest cross product of two rows
+  const double wk = (w0-w1 >= w1-w2) ? w0 : w2;
+  G4ThreeVector row[3];
+  for (int i = 0; i < 3; i++) {
+    row[i].set(a[i][0], a[i][1], a[i][2]);
+    row[i][i] -= wk;
+  }
+
+  G4ThreeVector ek = row[0].cross(row[1]);
+  G4ThreeVector cross = row[0].cross(row[2]);
+  if (cross.mag2() > ek.mag2()) ek = cross;
+  cross = row[1].cross(row[2]);
+  if (cross.mag2() > ek.mag2()) ek = cross;
+  ek = ek.unit();
+
+  // Remaining 2x2 eigensystem, in plane orthogonal to ek
+  const G4ThreeVector u = ek.orthogonal().unit();
+  const G4ThreeVector v = ek.cross(u);
+
+  G4ThreeVector au, av, aek;
+  for (int i = 0; i < 3; i++) {
+    au[i]  = a[i][0]*u[0]  + a[i][1]*u[1]  + a[i][2]*u[2];
+    av[i]  = a[i][0]*v[0]  + a[i][1]*v[1]  + a[i][2]*v[2];
+    aek[i] = a[i][0]*ek[0] + a[i][1]*ek[1] + a[i][2]*ek[2];
+  }
+
+  const double buu = u.dot(au), buv = u.dot(av), bvv = v.dot(av);
+
+  // Rotation angle which zeroes buv (Numerical Recipes 11.1)
+  double c = 1., s = 0., t = 0.;
+  if (buv != 0.) {
+    const double theta = 0.5*(bvv-buu)/buv;
+    t = 1./(std::fabs(theta) + std::sqrt(theta*theta+1.));
+    if (theta < 0.) t = -t;
+    c = 1./std::sqrt(t*t+1.);
+    s = t*c;
+  }
+
+  eval[0] = ek.dot(aek);
+  eval[1] = buu - t*buv;
+  eval[2] = bvv + t*buv;
+
+  const G4ThreeVector col[3] = { ek, c*u - s*v, s*u + c*v };
+  for (int i = 0; i < 3; i++) {
+    for (int k = 0; k < 3; k++) evec[k][i] = col[i][k];
+  }
+
+  // Sort eigenvalues into descending order, along with eigenvectors
+  for (int i = 0; i < 2; i++) {
+    int imax = i;
+    for (int j = i+1; j < 3; j++) if (eval[j] > eval[imax]) imax = j;
+    if (imax == i) continue;
+
+    std::swap(eval[i], eval[imax]);
+    for (int k = 0; k < 3; k++) std::swap(evec[k][i], evec[k][imax]);
+  }
 }
 
 const G4ThreeVector& 
@@ -0,0 +1,257 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPPhononWeightWindow.cc
+/// \brief Implementation of the G4CMPPhononWeightWindow class, splitting
+///	   and Russian roulette of phonon tracks by importance.
+//
+// $Id$
+//
+// 20261016  New class for phonon splitting and Russian roulette.
+// 20261016  Split copies of current track use proposed time and position.
+
+#include "G4CMPPhononWeightWindow.hh"
+#include "G4CMPPhononTrackInfo.hh"
+#include "G4CMPTrackUtils.hh"
+#include "G4DynamicParticle.hh"
+#include "G4ParticleChange.hh"
+#include "G4Track.hh"
+#include "G4UnitsTable.hh"
+#include "Randomize.hh"
+#include <algorithm>
+#include <cmath>
+#include <float.h>
+#include <fstream>
+#include <sstream>
+
+
+// Read keyword entries, skipping comments and blank lines
+
+G4bool G4CMPPhononWeightWindow::Load(const G4String& filename) {
+  Clear();
+
+  std::ifstream input(filename);
+  if (!input.good()) {
+    G4cerr << "G4CMPPhononWeightWindow: Unable to open " << filename
+	   << G4endl;
+    return false;
+  }
+
+  std::string line, key, unit;
+  G4int lineNo = 0;
+  while (std::getline(input, line)) {
+    lineNo++;
+    size_t hash = line.find('#');
+    if (hash != std::string::npos) line.erase(hash);
+
+    std::istringstream values(line);
+    if (!(values >> key)) continue;		// Blank line
+
+    G4int axis = (key == "x" ? 0 : key == "y" ? 1 : key == "z" ? 2 : -1);
+    G4double value = 0., imp = 0.;
+    G4bool good = true;
+
+    if (key == "energy" || key == "time" || axis >= 0) {
+      G4String cat = (key == "energy" ? "Energy" :
+		      key == "time" ? "Time" : "Length");
+      good = (values >> value >> unit >> imp) && imp > 0. &&
+	G4UnitDefinition::IsUnitDefined(unit) &&
+	G4UnitDefinition::GetCategory(unit) == cat;
+
+      if (good) {
+	value *= G4UnitDefinition::GetValueOf(unit);
+	if (key == "energy") AddEnergyPoint(value, imp);
+	else if (key == "time") AddTimePoint(value, imp);
+	else AddPositionPoint(axis, value, imp);
+      }
+    } else if (key == "weight") {
+      good = (values >> refWeight) && refWeight > 0.;
+    } else if (key == "ratio") {
+      good = (values >> ratio) && ratio > 1.;
+    } else if (key == "maxSplit") {
+      good = (values >> maxSplit) && maxSplit > 0;
+    } else {
+      good = false;
+    }
+
+    if (!good) {
+      G4cerr << "G4CMPPhononWeightWindow: Invalid entry at " << filename
+	     << ":" << lineNo << G4endl;
+      Clear();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+// Populate importance tables
+
+void G4CMPPhononWeightWindow::AddEnergyPoint(G4double energy,
+					     G4double importance) {
+  energyImp.Add(energy, importance);
+}
+
+void G4CMPPhononWeightWindow::AddTimePoint(G4double time,
+					   G4double importance) {
+  timeImp.Add(time, importance);
+}
+
+void G4CMPPhononWeightWindow::AddPositionPoint(G4int axis, G4double pos,
+					       G4double importance) {
+  if (axis >= 0 && axis < 3) posImp[axis].Add(pos, importance);
+}
+
+void G4CMPPhononWeightWindow::Clear() {
+  energyImp = Table();
+  timeImp = Table();
+  for (G4int i=0; i<3; i++) posImp[i] = Table();
+
+  refWeight = 1.;
+  ratio = 4.;
+  maxSplit = 10;
+}
+
+
+// Importance is product of independent factors
+
+G4double
+G4CMPPhononWeightWindow::GetImportance(G4double energy, G4double time,
+				       const G4ThreeVector& localPos) const {
+  return ( energyImp.Interpolate(energy) * timeImp.Interpolate(time) *
+	   posImp[0].Interpolate(localPos.x()) *
+	   posImp[1].Interpolate(localPos.y()) *
+	   posImp[2].Interpolate(localPos.z()) );
+}
+
+G4double G4CMPPhononWeightWindow::GetTargetWeight(G4double importance) const {
+  return (importance > 0.) ? refWeight/importance : DBL_MAX;
+}
+
+
+// Survivors of roulette take the target weight, preserving expectation
+
+G4bool G4CMPPhononWeightWindow::Roulette(G4double& weight,
+					 G4double importance) const {
+  G4double target = GetTargetWeight(importance);
+  if (weight >= target/std::sqrt(ratio)) return true;
+
+  if (G4UniformRand()*target >= weight) return false;
+
+  weight = target;
+  return true;
+}
+
+// Copies share the weight equally, as close to the target as allowed
+
+G4int G4CMPPhononWeightWindow::Split(G4double& weight,
+				     G4double importance) const {
+  G4double target = GetTargetWeight(importance);
+  if (weight <= target*std::sqrt(ratio)) return 1;
+
+  G4double copies = std::floor(weight/target+0.5);
+  G4int n = (copies < maxSplit) ? G4int(copies) : maxSplit;
+  if (n <= 1) return 1;
+
+  weight /= n;
+  return n;
+}
+
+
+// Window applied to new track, before it is added to ParticleChange
+
+G4double G4CMPPhononWeightWindow::
+ApplyToSecondary(G4Track* sec, G4double weight, G4double importance,
+		 std::vector<G4Track*>& tracks) const {
+  if (!sec) return 0.;
+
+  if (!Roulette(weight, importance)) {
+    delete sec;
+    return 0.;
+  }
+
+  G4int n = Split(weight, importance);
+  sec->SetWeight(weight);
+  tracks.push_back(sec);
+
+  for (G4int i=1; i<n; i++) tracks.push_back(CopyPhonon(*sec));
+
+  return n*weight;
+}
+
+// Window applied to surviving track, after process has filled ParticleChange
+
+void G4CMPPhononWeightWindow::
+ApplyToTrack(const G4Track& track, G4double importance,
+	     G4ParticleChange& particleChange) const {
+  if (particleChange.GetTrackStatus() == fStopAndKill) return;
+
+  G4double weight = particleChange.GetWeight();
+  if (!Roulette(weight, importance)) {
+    particleChange.ProposeTrackStatus(fStopAndKill);
+    return;
+  }
+
+  G4int n = Split(weight, importance);
+  particleChange.ProposeWeight(weight);
+  if (n <= 1) return;
+
+  // Copies must take proposed kinematics, not those of incident track
+  particleChange.SetSecondaryWeightByProcess(true);
+  particleChange.SetNumberOfSecondaries(n-1);
+  for (G4int i=1; i<n; i++) {
+    G4Track* copy = CopyPhonon(track, particleChange.GetGlobalTime(),
+			       *particleChange.GetPosition());
+    copy->SetMomentumDirection(*particleChange.GetMomentumDirection());
+    copy->SetVelocity(particleChange.GetVelocity());
+    copy->SetWeight(weight);
+    particleChange.AddSecondary(copy);
+  }
+}
+
+
+// Duplicate track, including separate copy of wavevector info
+
+G4Track* G4CMPPhononWeightWindow::CopyPhonon(const G4Track& track) {
+  return CopyPhonon(track, track.GetGlobalTime(), track.GetPosition());
+}
+
+G4Track* G4CMPPhononWeightWindow::CopyPhonon(const G4Track& track,
+					     G4double time,
+					     const G4ThreeVector& pos) {
+  G4Track* copy =
+    new G4Track(new G4DynamicParticle(*track.GetDynamicParticle()), time, pos);
+  copy->SetGoodForTrackingFlag(true);	// Protect against production cuts
+  copy->SetTouchableHandle(track.GetTouchableHandle());
+  copy->SetWeight(track.GetWeight());
+  copy->SetVelocity(track.GetVelocity());
+  copy->UseGivenVelocity(true);
+
+  auto trackInfo = G4CMP::GetTrackInfo<G4CMPPhononTrackInfo>(track);
+  if (trackInfo) {
+    G4CMP::AttachTrackInfo(copy, new G4CMPPhononTrackInfo(*trackInfo));
+  }
+
+  return copy;
+}
+
+
+// Keep table points in increasing order for bisection
+
+void G4CMPPhononWeightWindow::Table::Add(G4double xval, G4double yval) {
+  size_t i = std::upper_bound(x.begin(), x.end(), xval) - x.begin();
+  x.insert(x.begin()+i, xval);
+  y.insert(y.begin()+i, yval);
+}
+
+G4double G4CMPPhononWeightWindow::Table::Interpolate(G4double xval) const {
+  if (x.empty()) return 1.;
+  if (xval <= x.front()) return y.front();
+  if (xval >= x.back()) return y.back();
+
+  size_t i = std::upper_bound(x.begin(), x.end(), xval) - x.begin();
+  return y[i-1] + (xval-x[i-1]) * (y[i]-y[i-1]) / (x[i]-x[i-1]);
+}
@@ -0,0 +1,131 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPRateTable.cc
+/// \brief Implementation of the G4CMPRateTable class, a lookup table of
+///	   scattering rate vs. a single variable.
+//
+// $Id$
+//
+// 20261016  New class for tabulated scattering rates.
+
+#include "G4CMPRateTable.hh"
+#include <algorithm>
+#include <cmath>
+#include <float.h>
+
+
+// Fill one table segment for each range between edges
+
+G4bool G4CMPRateTable::Fill(const std::function<G4double(G4double)>& f,
+			    G4double xhigh, G4double tol,
+			    const std::vector<G4double>& edges) {
+  Clear();
+  if (xhigh <= 0. || tol <= 0.) return false;
+
+  std::vector<G4double> bounds(1, 0.);
+  for (G4double edge: edges) {
+    if (edge > 0. && edge < xhigh) bounds.push_back(edge);
+  }
+  std::sort(bounds.begin(), bounds.end());
+  bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+  bounds.push_back(xhigh);
+
+  segments.resize(bounds.size()-1);
+  for (size_t i=0; i<segments.size(); i++) {
+    if (!FillSegment(segments[i], f, bounds[i], bounds[i+1], tol)) {
+      Clear();
+      return false;
+    }
+  }
+
+  xmax = xhigh;
+  return true;
+}
+
+void G4CMPRateTable::Clear() {
+  segments.clear();
+  xmax = maxError = 0.;
+}
+
+
+// Halve grid spacing until every midpoint is interpolated well enough; the
+// function values at midpoints become the new grid points when refining
+
+G4bool G4CMPRateTable::FillSegment(Segment& seg,
+				   const std::function<G4double(G4double)>& f,
+				   G4double x0, G4double x1, G4double tol) {
+  const size_t minIntervals = 16;
+  const size_t maxIntervals = 1 << 16;
+
+  const G4double umax = std::sqrt(x1-x0);
+  seg.x0 = x0;
+
+  size_t n = minIntervals;
+  G4double du = umax/n;
+  seg.y.resize(n+1);
+  for (size_t i=0; i<n; i++) seg.y[i] = f(x0 + i*du*i*du);
+  seg.y[n] = f(x1);
+
+  std::vector<G4double> mid(n), refined;
+  while (n <= maxIntervals) {
+    G4double segError = 0.;
+    for (size_t i=0; i<n; i++) {
+      G4double u = (i+0.5)*du;
+      mid[i] = f(x0 + u*u);
+
+      G4double diff = std::fabs(0.5*(seg.y[i]+seg.y[i+1]) - mid[i]);
+      if (diff > 0.) {
+	segError = std::max(segError, (mid[i] != 0. ? diff/std::fabs(mid[i])
+				       : DBL_MAX));
+      }
+    }
+
+    if (segError <= tol) {
+      seg.invDu = 1./du;
+      maxError = std::max(maxError, segError);
+      return true;
+    }
+
+    // Interleave midpoints to make grid with half the spacing
+    refined.resize(2*n+1);
+    for (size_t i=0; i<n; i++) {
+      refined[2*i]   = seg.y[i];
+      refined[2*i+1] = mid[i];
+    }
+    refined[2*n] = seg.y[n];
+    seg.y.swap(refined);
+
+    n *= 2;
+    du *= 0.5;
+    mid.resize(n);
+  }
+
+  return false;
+}
+
+
+// Linear interpolation in sqrt(x-x0) within segment containing x
+
+G4double G4CMPRateTable::Value(G4double x) const {
+  size_t iseg = segments.size()-1;	// Only a few segments, search down
+  while (iseg > 0 && x < segments[iseg].x0) iseg--;
+
+  const Segment& seg = segments[iseg];
+  G4double u = std::sqrt(x - seg.x0) * seg.invDu;
+  size_t i = std::min(size_t(u), seg.y.size()-2);
+  G4double t = u - i;
+
+  return seg.y[i] + t*(seg.y[i+1]-seg.y[i]);
+}
+
+
+// Total size of table, for diagnostics
+
+size_t G4CMPRateTable::GetNumberOfPoints() const {
+  size_t npts = 0;
+  for (const Segment& seg: segments) npts += seg.y.size();
+  return npts;
+}
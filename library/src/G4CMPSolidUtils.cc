@@ -26,14 +26,21 @@
 // 20250424  G4CMP-465 -- Create G4CMPSolidUtils class.
 // 20250429  G4CMP-461 -- Add function for skipping detector flats.
 // 20250430  N. Tenpas -- Add function for getting distance to bounding box.
+// 20261016  Move surface displacement walk here; add analytic Box/Tubs walk.
+// 20261016  Drop analytic walk on G4Tubs end caps, which did not match the
+//		generic walk; caps use SurfaceWalk().
 
 #include "G4CMPSolidUtils.hh"
 #include "G4AffineTransform.hh"
+#include "G4Box.hh"
 #include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Tubs.hh"
 #include "G4VSolid.hh"
 #include "G4VTouchable.hh"
 #include "G4UnitsTable.hh"
+#include <algorithm>
+#include <cmath>
 
 
 // Direct constructors
@@ -469,6 +476,335 @@ G4double G4CMPSolidUtils::GetDistToBB(const G4ThreeVector pos,
 }
 
 
+// Surface displacement: step along the surface, carrying k with the local
+// normal, until the test passes (e.g., group velocity points into solid)
+
+G4int G4CMPSolidUtils::SurfaceWalk(G4ThreeVector& pos, G4ThreeVector& surfNorm,
+                                   G4ThreeVector& k, G4double stepSize,
+                                   G4int nStepLimit, const SurfaceTest& test) {
+  G4ThreeVector stepPos = pos;
+  G4ThreeVector newNorm = surfNorm;
+  G4ThreeVector oldNorm = newNorm;
+  G4ThreeVector oldStepPos = stepPos;
+  G4ThreeVector reflectedKDir = k;
+
+  // Break up wavevector to perp and tan components
+  G4double kPerpMag = reflectedKDir.dot(newNorm);
+  G4ThreeVector kPerpV = kPerpMag * newNorm;	// Negative implied in kPerpMag for inward pointing
+  G4ThreeVector kTan = reflectedKDir - kPerpV;	// Get kTan: reflectedKDir = kPerpV + kTan
+
+  // Get axis and phi for tangent rotations
+  G4ThreeVector axis = kPerpV.cross(kTan).unit();
+  G4double phi = 0.;
+  EInside isIn = kSurface;
+
+  // Get flat skip step size dependent on solid
+  G4ThreeVector pmin(0,0,0);
+  G4ThreeVector pmax(0,0,0);
+  theSolid->BoundingLimits(pmin, pmax);
+  G4double flatStepSize = (pmax - pmin).mag();
+
+  if (verboseLevel>3) {
+    G4cout << verboseLabel << "::SurfaceWalk:beforeLoop -> "
+	   << ", stepPos = " << stepPos/mm << " mm"
+	   << ", reflectedKDir = " << reflectedKDir
+	   << ", newNorm = " << newNorm
+	   << ", kPerpMag (newNorm dot reflectedKDir) = " << kPerpMag
+	   << ", kPerpV (kPerpMag * newNorm) = " << kPerpV
+	   << ", kTan (reflectedKDir - kPerpV) = " << kTan
+	   << ", surfaceStepSize = " << G4BestUnit(stepSize, "Length")
+	   << ", nStepLimit = " << nStepLimit << G4endl;
+  }
+
+  G4int nAttempts = 0;
+  while (!test(GetLocalDirection(reflectedKDir), GetLocalDirection(newNorm),
+	       GetLocalPosition(stepPos)) && nAttempts++ < nStepLimit) {
+    // Save previous loop values
+    oldStepPos = stepPos;
+    oldNorm = newNorm;
+
+    // Step along kTan direction - this point is now outside the detector
+    stepPos += stepSize * kTan.unit();
+
+    // Get the normal at the new surface point
+    newNorm = GetGlobalDirection(theSolid->SurfaceNormal(GetLocalPosition(stepPos)));
+    // Check position status for flat skipper
+    isIn = theSolid->Inside(GetLocalPosition(stepPos));
+
+    // Check if the phonon is on a flat. Must be on the solid surface
+    if (oldNorm == newNorm && isIn == kSurface) {
+      // Adjust stepPos to edge of the flat (still on the flat)
+      // Modifies stepPos and kTan in place
+      AdjustOffFlats(stepPos, kTan, flatStepSize, newNorm, 0);
+      // Do a diffuse reflection if stuck in regression
+      if (theSolid->Inside(GetLocalPosition(stepPos)) != kSurface) {
+        reflectedKDir = newNorm;
+        break;
+      }
+      // Step off the flat and adjust newNorm
+      stepPos += stepSize * kTan.unit();
+      newNorm = GetGlobalDirection(theSolid->SurfaceNormal(GetLocalPosition(stepPos)));
+    }
+
+    // Adjust stepPos back to surface of detector
+    AdjustToClosestSurfacePoint(stepPos, -newNorm);
+    // Check position status for edge reflections
+    isIn = theSolid->Inside(GetLocalPosition(stepPos));
+
+    // Large normal changes and not being on surface after initial adjustment
+    // indicates we are approaching an edge
+    if (isIn != kSurface || newNorm * oldNorm <= 0) {
+      // Reset stepPos and newNorm to last valid surface point
+      stepPos = oldStepPos;
+      newNorm = oldNorm;
+      // Modify stepPos in place to edge position
+      AdjustToEdgePosition(kTan, stepPos, stepSize, 1);
+      // Do a diffuse reflection if the adjustment failed
+      if (theSolid->Inside(GetLocalPosition(stepPos)) != kSurface) {
+        reflectedKDir = newNorm;
+        break;
+      }
+      // Reflect kTan against the edge - rotates & modifies kTan; modifies newNorm
+      ReflectAgainstEdge(kTan, stepPos, newNorm);
+    } else {
+      // Rotate kTan to new position
+      axis = newNorm.cross(kTan).unit();
+      phi = oldNorm.azimAngle(newNorm, axis);
+      kTan = kTan.rotate(axis, phi);
+    }
+
+    // Get perpendicular component of reflected k w/ new norm
+    // (negative implied in kPerpMag for inward pointing)
+    kPerpV = kPerpMag * newNorm;
+
+    // Calculate new reflectedKDir (kTan + kPerpV)
+    reflectedKDir = kTan + kPerpV;
+
+    if (verboseLevel>3) {
+      G4cout << " " << verboseLabel << "::SurfaceWalk:insideLoop -> "
+	     << " attempts = " << nAttempts
+	     << ", oldStepPos = " << oldStepPos/mm << " mm"
+	     << ", stepPos = " << stepPos/mm << " mm"
+	     << ", oldNorm = " << oldNorm
+	     << ", newNorm = " << newNorm
+	     << ", kPerpMag = " << kPerpMag
+	     << ", kPerpV (kPerpMag * newNorm) = " << kPerpV
+	     << ", kTan = " << kTan
+	     << ", reflectedKDir (kTan + kPerpV) = " << reflectedKDir << G4endl;
+    }
+  }
+
+  pos = stepPos;
+  surfNorm = newNorm;
+  k = reflectedKDir;
+  return nAttempts;
+}
+
+
+// Surface displacement on simple solids, where the path along the surface
+// is known: straight lines on box faces, reflected at the edges, and
+// helices on the side of a cylinder.  Each flat face is crossed in one
+// step, rather than many small ones.
+
+namespace {
+  // Normal vectors from solids are exactly unit vectors along axes
+  const G4double normTol = 1e-9;
+
+  // Distance along dir (in face, along axes ia and ib) to edge of rectangle
+  G4double DistToRectEdge(const G4ThreeVector& pos, const G4ThreeVector& dir,
+			  const G4ThreeVector& halfLen, G4int ia, G4int ib) {
+    G4double dist = kInfinity;
+    if (dir[ia] != 0.)
+      dist = std::min(dist, (std::copysign(halfLen[ia],dir[ia])-pos[ia])/dir[ia]);
+    if (dir[ib] != 0.)
+      dist = std::min(dist, (std::copysign(halfLen[ib],dir[ib])-pos[ib])/dir[ib]);
+    return std::max(dist, 0.);
+  }
+}
+
+G4bool G4CMPSolidUtils::
+AnalyticSurfaceWalk(G4ThreeVector& pos, G4ThreeVector& surfNorm,
+                    G4ThreeVector& k, G4double stepSize, G4int nStepLimit,
+                    const SurfaceTest& test, G4int& nSteps) const {
+  if (!theSolid) return false;
+
+  G4ThreeVector localPos = pos;
+  G4ThreeVector localNorm = surfNorm;
+  TransformGlobalToLocal(localPos, localNorm);
+  G4ThreeVector localK = GetLocalDirection(k);
+
+  G4bool done = false;
+  if (theSolid->GetEntityType() == "G4Box") {
+    done = BoxSurfaceWalk(localPos, localNorm, localK, stepSize, nStepLimit,
+			  test, nSteps);
+  } else if (theSolid->GetEntityType() == "G4Tubs") {
+    const G4Tubs* tubs = static_cast<const G4Tubs*>(theSolid);
+    if (tubs->GetInnerRadius() > 0. || tubs->GetDeltaPhiAngle() < twopi)
+      return false;
+
+    // End caps use generic walk, which treats the rim as a hard edge
+    if (std::fabs(localNorm.z()) > 0.5) return false;
+
+    done = TubsSideWalk(localPos, localNorm, localK, stepSize, nStepLimit,
+			test, nSteps);
+  }
+
+  if (!done) return false;
+
+  if (verboseLevel>3) {
+    G4cout << verboseLabel << "::AnalyticSurfaceWalk"
+	   << ": " << theSolid->GetEntityType() << " steps = " << nSteps
+	   << ", initialPos = " << pos/mm << " mm"
+	   << ", finalLocalPos = " << localPos/mm << " mm"
+	   << ", k = " << localK << ", surfNorm = " << localNorm << G4endl;
+  }
+
+  TransformLocalToGlobal(localPos, localNorm);
+  TransformToGlobalDirection(localK);
+  pos = localPos;
+  surfNorm = localNorm;
+  k = localK;
+  return true;
+}
+
+// Rectangular face: path is a straight line, reflected at each edge.
+// Only the signs of the two tangential components of k change, so there
+// are at most four distinct wavevectors to test.
+
+G4bool G4CMPSolidUtils::
+BoxSurfaceWalk(G4ThreeVector& pos, G4ThreeVector& surfNorm, G4ThreeVector& k,
+               G4double stepSize, G4int nStepLimit, const SurfaceTest& test,
+               G4int& nSteps) const {
+  const G4Box* box = static_cast<const G4Box*>(theSolid);
+  const G4ThreeVector halfLen(box->GetXHalfLength(), box->GetYHalfLength(),
+			      box->GetZHalfLength());
+  const G4double tolerance = theSolid->GetTolerance();
+
+  // Normal must be along one axis; edges and corners use generic walk
+  G4int iface = -1;
+  for (G4int i=0; i<3; i++) {
+    if (std::fabs(std::fabs(surfNorm[i]) - 1.) < normTol) iface = i;
+  }
+  if (iface < 0) return false;
+
+  G4ThreeVector norm(0,0,0);
+  norm[iface] = (surfNorm[iface] > 0. ? 1. : -1.);
+
+  const G4double kPerpMag = k.dot(norm);
+  G4ThreeVector dir = k - kPerpMag*norm;	// Tangential direction
+  const G4double kTanMag = dir.mag();
+  if (kTanMag <= 0.) return false;
+  dir /= kTanMag;
+
+  // Axes spanning the face; start point is put exactly on the face
+  const G4int ia = (iface+1)%3, ib = (iface+2)%3;
+  G4ThreeVector stepPos = pos;
+  stepPos[iface] = norm[iface]*halfLen[iface];
+  stepPos[ia] = std::max(-halfLen[ia], std::min(stepPos[ia], halfLen[ia]));
+  stepPos[ib] = std::max(-halfLen[ib], std::min(stepPos[ib], halfLen[ib]));
+
+  G4ThreeVector kDir = k;
+  G4int visited = 1 << ((dir[ia]<0.) + 2*(dir[ib]<0.));
+
+  nSteps = 0;
+  while (!test(kDir, norm, stepPos) && nSteps++ < nStepLimit) {
+    stepPos += DistToRectEdge(stepPos, dir, halfLen, ia, ib) * dir;
+
+    // Reflect against edge(s) reached, or both at a corner
+    for (G4int i: {ia, ib}) {
+      if (std::fabs(stepPos[i]) >= halfLen[i]-tolerance && stepPos[i]*dir[i] > 0.) {
+	stepPos[i] = std::copysign(halfLen[i], stepPos[i]);
+	dir[i] = -dir[i];
+      }
+    }
+
+    // Move back onto the face, so test sees the face and not the edge
+    stepPos += std::min(stepSize, 0.5*DistToRectEdge(stepPos, dir, halfLen,
+						      ia, ib)) * dir;
+    kDir = kTanMag*dir + kPerpMag*norm;
+
+    // Same wavevector as before will fail again
+    G4int state = 1 << ((dir[ia]<0.) + 2*(dir[ib]<0.));
+    if (visited & state) break;
+    visited |= state;
+  }
+
+  pos = stepPos;
+  surfNorm = norm;
+  k = kDir;
+  return true;
+}
+
+// Cylindrical side: path is a helix (geodesic), along which the components
+// of k along phi-hat and z are constant, until the helix reaches a cap and
+// the z component is reflected.  Steps are taken at stepSize, like the
+// generic walk, since the normal (and test) changes continuously.
+
+G4bool G4CMPSolidUtils::
+TubsSideWalk(G4ThreeVector& pos, G4ThreeVector& surfNorm, G4ThreeVector& k,
+             G4double stepSize, G4int nStepLimit, const SurfaceTest& test,
+             G4int& nSteps) const {
+  const G4Tubs* tubs = static_cast<const G4Tubs*>(theSolid);
+  const G4double rmax = tubs->GetOuterRadius();
+  const G4double halfZ = tubs->GetZHalfLength();
+  const G4double tolerance = theSolid->GetTolerance();
+
+  // Must start on side, away from edges, with normal along radius
+  if (pos.perp() <= 0. || std::fabs(pos.z()) > halfZ - tolerance) return false;
+
+  G4double cosPhi = pos.x()/pos.perp();
+  G4double sinPhi = pos.y()/pos.perp();
+  G4ThreeVector norm(cosPhi, sinPhi, 0.);
+  if (surfNorm.dot(norm) < 1. - normTol) return false;
+
+  // Components of k along (norm, phi-hat, z) are fixed along the path
+  const G4double kPerpMag = k.dot(norm);
+  const G4double kPhi = k.dot(G4ThreeVector(-sinPhi, cosPhi, 0.));
+  G4double kZ = k.z();
+  const G4double kTanMag = std::sqrt(kPhi*kPhi + kZ*kZ);
+  if (kTanMag <= 0.) return false;
+
+  // Rotation and z change for each full step
+  const G4double dPhi = stepSize*kPhi/kTanMag/rmax;
+  const G4double cosStep = std::cos(dPhi), sinStep = std::sin(dPhi);
+  G4double dz = stepSize*kZ/kTanMag;
+
+  G4double z = pos.z();
+  G4ThreeVector stepPos(rmax*cosPhi, rmax*sinPhi, z);
+  G4ThreeVector kDir = k;
+
+  nSteps = 0;
+  while (!test(kDir, norm, stepPos) && nSteps++ < nStepLimit) {
+    G4double cosRot = cosStep, sinRot = sinStep;
+
+    if (std::fabs(z+dz) >= halfZ) {		// Stop at edge and reflect
+      G4double zEdge = std::copysign(halfZ, dz);
+      G4double frac = (zEdge - z) / dz;
+      cosRot = std::cos(frac*dPhi);
+      sinRot = std::sin(frac*dPhi);
+      z = zEdge;
+      dz = -dz;
+      kZ = -kZ;
+    } else {
+      z += dz;
+    }
+
+    G4double c = cosPhi*cosRot - sinPhi*sinRot;
+    sinPhi = sinPhi*cosRot + cosPhi*sinRot;
+    cosPhi = c;
+
+    norm.set(cosPhi, sinPhi, 0.);
+    stepPos.set(rmax*cosPhi, rmax*sinPhi, z);
+    kDir.set(kPerpMag*cosPhi - kPhi*sinPhi, kPerpMag*sinPhi + kPhi*cosPhi, kZ);
+  }
+
+  pos = stepPos;
+  surfNorm = norm;
+  k = kDir;
+  return true;
+}
+
+
 // Coordinate transformations
 
 // Both position and direction transforms
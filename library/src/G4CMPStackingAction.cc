@@ -27,17 +27,26 @@
 // 20240122 G4CMP-446 -- SetPhononVelocity() should use global-to-local
 //		transform for k vector and Vg.
 // 20250508 N. Tenpas -- Add coordinate transforms in SetPhononVelocity.
+// 20261016 Add fast charge transport, replacing tracking of charges.
+// 20261016 Apply Russian roulette to new phonons below weight window.
+// 20261016 Fast charges which stall before the surface are tracked normally.
 
 #include "G4CMPStackingAction.hh"
 
+#include "G4CMPConfigManager.hh"
 #include "G4CMPDriftHole.hh"
 #include "G4CMPDriftElectron.hh"
 #include "G4CMPDriftTrackInfo.hh"
+#include "G4CMPElectrodeHit.hh"
+#include "G4CMPElectrodeSensitivity.hh"
+#include "G4CMPFastChargeTransport.hh"
 #include "G4CMPPhononTrackInfo.hh"
+#include "G4CMPPhononWeightWindow.hh"
 #include "G4CMPTrackUtils.hh"
 #include "G4CMPUtils.hh"
 #include "G4LatticeManager.hh"
 #include "G4LatticePhysical.hh"
+#include "G4LogicalVolume.hh"
 #include "G4PhononLong.hh"
 #include "G4PhononPolarization.hh"
 #include "G4PhononTrackMap.hh"
@@ -56,7 +65,7 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
 G4CMPStackingAction::G4CMPStackingAction()
-  : G4UserStackingAction(), G4CMPProcessUtils() {;}
+  : G4UserStackingAction(), G4CMPProcessUtils(), stallWarned(false) {;}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
@@ -82,6 +91,19 @@ G4CMPStackingAction::ClassifyNewTrack(const G4Track* aTrack) {
     return fKill;
   }
 
+  // Fast mode replaces tracking with tabulated drift to electrodes
+  if (IsChargeCarrier() && G4CMPConfigManager::UseFastCharges() &&
+      TransportFastCharge(aTrack)) {
+    ReleaseTrack();
+    return fKill;
+  }
+
+  // Low-importance phonons are removed before they are tracked
+  if (IsPhonon() && !RoulettePhonon(aTrack)) {
+    ReleaseTrack();
+    return fKill;
+  }
+
   // Attach appropriate container to store additional kinematics if needed
   if (!G4CMP::HasTrackInfo(aTrack)) {
     G4CMP::AttachTrackInfo(aTrack);
@@ -100,6 +122,14 @@ G4CMPStackingAction::ClassifyNewTrack(const G4Track* aTrack) {
   return classification; 
 }
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4CMPStackingAction::PrepareNewEvent() {
+  if (fastCharges) fastCharges->ClearSignals();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
 // Set velocity of phonon track appropriately for material
 
 void G4CMPStackingAction::SetPhononVelocity(const G4Track* aTrack) const {
@@ -167,3 +197,91 @@ void G4CMPStackingAction::SetChargeCarrierMass(const G4Track* aTrack) const {
 
   dynp->SetMass(mass*c_squared);	// Converts to Geant4 [M]=[E] units
 }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+// Roulette for phonons below weight window; splitting of tracks above the
+// window is done by the processes, which can add secondaries
+
+G4bool G4CMPStackingAction::RoulettePhonon(const G4Track* aTrack) const {
+  const G4CMPPhononWeightWindow* window =
+    G4CMPConfigManager::GetPhononWeightWindow();
+  if (!window) return true;
+
+  G4double imp = window->GetImportance(aTrack->GetKineticEnergy(),
+				       aTrack->GetGlobalTime(),
+				       GetLocalPosition(aTrack->GetPosition()));
+
+  G4double weight = aTrack->GetWeight();
+  if (!window->Roulette(weight, imp)) return false;
+
+  // Cast to non-const pointer so we can change the weight of survivor
+  const_cast<G4Track*>(aTrack)->SetWeight(weight);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+// Drift charge through field with lattice drift table; hit is recorded
+// in volume's sensitive detector, as for charges absorbed at boundary
+
+G4bool G4CMPStackingAction::TransportFastCharge(const G4Track* aTrack) {
+  if (!fastCharges) {
+    G4int verbose = G4CMPConfigManager::GetVerboseLevel();
+    fastCharges = std::make_shared<G4CMPFastChargeTransport>(verbose);
+    fastCharges->ClearSignals();
+  }
+
+  const G4LogicalVolume* vol = GetCurrentVolume()->GetLogicalVolume();
+  G4ThreeVector pos = GetLocalPosition(aTrack->GetPosition());
+  G4double time = aTrack->GetGlobalTime();
+
+  if (!fastCharges->Drift(vol, theLattice->GetDriftTable(),
+			  aTrack->GetDynamicParticle()->GetCharge(),
+			  pos, time)) {
+    if (G4CMPConfigManager::GetVerboseLevel()) {
+      G4cerr << "G4CMPStackingAction: No drift table or local field for "
+	     << vol->GetName() << ", tracking charge normally" << G4endl;
+    }
+    return false;
+  }
+
+  // Carrier stalled before reaching surface; track it normally from there,
+  // so that its energy is handled by the drift processes.  Induced signal
+  // up to that point has already been counted.
+  if (!fastCharges->WasCollected()) {
+    if (!stallWarned) {
+      G4ExceptionDescription msg;
+      msg << "Fast charge stalled in " << vol->GetName() << " after "
+	  << fastCharges->GetNumberOfSteps() << " steps; tracking normally."
+	  << "\nFurther stalled carriers will not be reported.";
+      G4Exception("G4CMPStackingAction::TransportFastCharge", "Stacking001",
+		  JustWarning, msg);
+      stallWarned = true;
+    }
+
+    G4Track* track = const_cast<G4Track*>(aTrack);
+    track->SetPosition(GetGlobalPosition(pos));
+    track->SetGlobalTime(time);
+    return false;
+  }
+
+  G4CMPElectrodeSensitivity* sd =
+    dynamic_cast<G4CMPElectrodeSensitivity*>(vol->GetSensitiveDetector());
+  if (!sd) return true;
+
+  // Carrier keeps its kinetic energy; it is deposited at the electrode
+  G4CMPElectrodeHit* hit = new G4CMPElectrodeHit;
+  hit->SetStartTime(aTrack->GetGlobalTime());
+  hit->SetFinalTime(time);
+  hit->SetStartEnergy(aTrack->GetKineticEnergy());
+  hit->SetEnergyDeposit(aTrack->GetKineticEnergy());
+  hit->SetWeight(aTrack->GetWeight());
+  hit->SetStartPosition(aTrack->GetPosition());
+  hit->SetFinalPosition(GetGlobalPosition(pos));
+  hit->SetTrackID(aTrack->GetTrackID());
+  hit->SetParticleName(aTrack->GetDefinition()->GetParticleName());
+
+  sd->InsertHit(hit);
+  return true;
+}
@@ -13,6 +13,8 @@
 // 20200601  G4CMP-206: Need thread-local copies of electrode pointers
 // 20220824  R. Cormier -- Default to scalar probs if no polynomials
 // 20230429  G4CMP-357: Move mutex in GetXyzElectrode() to avoid data race.
+// 20261016  Copy table entries into flat records for boundary processes;
+//		add ReflectionProbs() to evaluate all polynomials at once.
 
 #include "G4CMPSurfaceProperty.hh"
 #include "G4CMPVElectrodePattern.hh"
@@ -33,7 +35,8 @@ namespace {
 
 G4CMPSurfaceProperty::G4CMPSurfaceProperty(const G4String& name,
                                            G4SurfaceType stype)
-  : G4SurfaceProperty(name, stype), theChargeElectrode(0),
+  : G4SurfaceProperty(name, stype), chargeParams(), phononParams(),
+    theChargeElectrode(0),
     thePhononElectrode(0), anharmonicMaxFreq(0.), diffuseMaxFreq(0.) {;}
 
 G4CMPSurfaceProperty::G4CMPSurfaceProperty(const G4String& name,
@@ -94,6 +97,7 @@ void G4CMPSurfaceProperty::SetChargeMaterialPropertiesTable(
                             G4MaterialPropertiesTable* mpt) {
   if (IsValidChargePropTable(*mpt)) {
     theChargeMatPropTable = *mpt;
+    UpdateParameters();
   } else {
     G4Exception("G4CMPSurfaceProperty::SetChargeMaterialPropertiesTable",
                 "detector001", RunMustBeAborted,
@@ -105,6 +109,7 @@ void G4CMPSurfaceProperty::SetPhononMaterialPropertiesTable(
                             G4MaterialPropertiesTable* mpt) {
   if (IsValidChargePropTable(*mpt)) {
     thePhononMatPropTable = *mpt;
+    UpdateParameters();
   } else {
     G4Exception("G4CMPSurfaceProperty::SetPhononMaterialPropertiesTable",
                 "detector002", RunMustBeAborted,
@@ -116,6 +121,7 @@ void G4CMPSurfaceProperty::SetChargeMaterialPropertiesTable(
   G4MaterialPropertiesTable& mpt) {
   if (IsValidChargePropTable(mpt)) {
     theChargeMatPropTable = mpt;
+    UpdateParameters();
   } else {
     G4Exception("G4CMPSurfaceProperty::SetChargeMaterialPropertiesTable",
                 "detector003", RunMustBeAborted,
@@ -127,6 +133,7 @@ void G4CMPSurfaceProperty::SetPhononMaterialPropertiesTable(
   G4MaterialPropertiesTable& mpt) {
   if (IsValidChargePropTable(mpt)) {
     thePhononMatPropTable = mpt;
+    UpdateParameters();
   } else {
     G4Exception("G4CMPSurfaceProperty::SetPhononMaterialPropertiesTable",
                 "detector004", RunMustBeAborted,
@@ -142,6 +149,7 @@ void G4CMPSurfaceProperty::FillChargeMaterialPropertiesTable(G4double qAbsProb,
   theChargeMatPropTable.AddConstProperty("reflProb", qReflProb);
   theChargeMatPropTable.AddConstProperty("minKElec", eMinK);
   theChargeMatPropTable.AddConstProperty("minKHole", hMinK);
+  UpdateParameters();
 }
 
 void G4CMPSurfaceProperty::FillPhononMaterialPropertiesTable(G4double pAbsProb,
@@ -152,6 +160,45 @@ void G4CMPSurfaceProperty::FillPhononMaterialPropertiesTable(G4double pAbsProb,
   thePhononMatPropTable.AddConstProperty("reflProb", pReflProb);
   thePhononMatPropTable.AddConstProperty("specProb", pSpecProb);
   thePhononMatPropTable.AddConstProperty("absMinK", pMinK);
+  UpdateParameters();
+}
+
+
+// Copy table entries used at every boundary step into flat records
+
+void G4CMPSurfaceProperty::UpdateParameters() {
+  chargeParams = BoundaryParams();
+  chargeParams.valid =
+    (CopyProperty(theChargeMatPropTable, "absProb", chargeParams.absProb) &
+     CopyProperty(theChargeMatPropTable, "reflProb", chargeParams.reflProb) &
+     CopyProperty(theChargeMatPropTable, "minKElec", chargeParams.minKElec) &
+     CopyProperty(theChargeMatPropTable, "minKHole", chargeParams.minKHole));
+
+  phononParams = BoundaryParams();
+  phononParams.valid =
+    (CopyProperty(thePhononMatPropTable, "absProb", phononParams.absProb) &
+     CopyProperty(thePhononMatPropTable, "reflProb", phononParams.reflProb) &
+     CopyProperty(thePhononMatPropTable, "specProb", phononParams.specProb) &
+     CopyProperty(thePhononMatPropTable, "absMinK", phononParams.absMinK));
+}
+
+// Tables may be filled by user code after construction, so boundary
+// processes call this at start of run, from the master thread
+
+void G4CMPSurfaceProperty::UpdateAllParameters() {
+  for (G4SurfaceProperty* sp: theSurfacePropertyTable) {
+    G4CMPSurfaceProperty* cmpSP = dynamic_cast<G4CMPSurfaceProperty*>(sp);
+    if (cmpSP) cmpSP->UpdateParameters();
+  }
+}
+
+G4bool G4CMPSurfaceProperty::
+CopyProperty(G4MaterialPropertiesTable& propTab, const char* key,
+	     G4double& value) const {
+  if (!propTab.ConstPropertyExists(key)) return false;
+
+  value = propTab.GetConstProperty(key);
+  return true;
 }
 
 
@@ -203,7 +250,7 @@ G4double G4CMPSurfaceProperty::AnharmonicReflProb(G4double freq) const {
 
 G4double G4CMPSurfaceProperty::DiffuseReflProb(G4double freq) const {
   if (diffuseCoeffs.empty() || freq > anharmonicMaxFreq)
-    return 1. - thePhononMatPropTable.GetConstProperty("specProb");
+    return 1. - phononParams.specProb;
 
   if (freq > diffuseMaxFreq) freq = diffuseMaxFreq;	// Flat plateau
   return ExpandCoeffsPoly(freq, diffuseCoeffs);
@@ -216,6 +263,17 @@ G4double G4CMPSurfaceProperty::SpecularReflProb(G4double freq) const {
   return ExpandCoeffsPoly(freq, specularCoeffs);
 }
 
+void G4CMPSurfaceProperty::
+ReflectionProbs(G4double freq, G4double& specProb, G4double& diffuseProb,
+		G4double& anharmonicProb) const {
+  anharmonicProb = AnharmonicReflProb(freq);
+  diffuseProb = DiffuseReflProb(freq);
+
+  specProb = ((specularCoeffs.empty() || freq > diffuseMaxFreq)
+	      ? 1. - diffuseProb - anharmonicProb
+	      : ExpandCoeffsPoly(freq, specularCoeffs));
+}
+
 
 // Master thread can get original electrode; worker threads need local copies
 
@@ -47,6 +47,9 @@
 //              flips
 // 20240712 M. Kelsey -- Protect minimum MFP calculation for zero field.
 // 20250616 M. Kelsey -- Rename MFP variables to be more descriptive.
+// 20261016  Get field once in GetMeanFreePath(); repeats are cached per step.
+// 20261016  With Luke macro-steps, scale Luke rate and slow-carrier step
+//		limits by number of emissions per step.
 
 #include "G4CMPTimeStepper.hh"
 #include "G4CMPConfigManager.hh"
@@ -129,7 +132,8 @@ G4double G4CMPTimeStepper::GetMeanFreePath(const G4Track& aTrack, G4double,
   if (aTrack.GetCurrentStepNumber() == 1) return 1e-12*m;
 
   // SPECIAL:  If no electric field, no need to limit steps
-  if (G4CMP::GetFieldAtPosition(aTrack).mag() <= 0.) return DBL_MAX;
+  G4ThreeVector fieldVector = G4CMP::GetFieldAtPosition(aTrack);
+  if (fieldVector.mag() <= 0.) return DBL_MAX;
 
   // Evaluate different step lengths to avoid overrunning process thresholds
   G4double vtrk = GetVelocity(aTrack);
@@ -158,19 +162,18 @@ G4double G4CMPTimeStepper::GetMeanFreePath(const G4Track& aTrack, G4double,
     G4cout << "TS IV threshold mfpIV " << mfpIV/m << " m" << G4endl;
 
   // Take smaller steps when charge velocity is low to avoid direction
-  // flip errors in electric field
-  G4double mfpEstop = DBL_MAX;
+  // flip errors in electric field (non-zero, checked above)
+  G4double mass = (IsElectron() ? theLattice->GetElectronMass()
+		   : theLattice->GetHoleMass());
+  G4double stopX = mass*vtrk/(2.*eplus*fieldVector.mag());
+  G4double mfpEstop = std::max(stopX/100., 1e-10*m);
 
-  G4ThreeVector fieldVector = G4CMP::GetFieldAtPosition(aTrack);
-  if (fieldVector.mag() > 0.) {
-    G4double mass = (IsElectron() ? theLattice->GetElectronMass()
-		     : theLattice->GetHoleMass());
-    G4double stopX = mass*vtrk/(2.*eplus*fieldVector.mag());
-    mfpEstop = std::max(stopX/100., 1e-10*m);
-
-    if (verboseLevel>1)
-      G4cout << "TS field stopping mfpEstop " << mfpEstop/m << " m" << G4endl;
-  }
+  // Luke macro-steps apply recoils along the step, so may be longer
+  G4int nLuke = G4CMPConfigManager::GetLukeMacroSteps();
+  if (nLuke > 1) mfpEstop *= nLuke;
+
+  if (verboseLevel>1)
+    G4cout << "TS field stopping mfpEstop " << mfpEstop/m << " m" << G4endl;
 
   // Take shortest distance from above options
   G4double mfp = std::min({mfpEstop, mfpLong, mfpFast, mfpLuke, mfpIV});
@@ -246,6 +249,10 @@ G4double G4CMPTimeStepper::MaxRate(const G4Track& aTrack) const {
   G4double lrate = lukeRate ? lukeRate->Rate(aTrack) : 0.;
   G4double irate = ivRate ? ivRate->Rate(aTrack) : 0.;
 
+  // Luke macro-steps collect several emissions in each step
+  G4int nLuke = G4CMPConfigManager::GetLukeMacroSteps();
+  if (nLuke > 1) lrate /= nLuke;
+
   if (verboseLevel>2) {
     G4cout << "G4CMPTimeStepper::MaxRate luke " << lrate/hertz << " iv "
 	   << irate/hertz << " Hz" << G4endl;
@@ -25,6 +25,26 @@
 //		gradient (field) precalc in UseMesh functions.
 // 20201002  Report tetrahedra errors during FillTInverse() initialization.
 // 20240920  G4CMP-244: Replace TetraIdx with function to access G4Cache.
+// 20261016  Build mesh tables into a new shared block, which is then used
+//		read-only; copy constructor shares tables instead of copying.
+// 20261016  Add uniform grid of seed tetrahedra, to jump directly to the
+//		neighborhood of a new point, or to reject it as outside hull.
+// 20261016  Replace TInverse, TInvGood, Neighbors with aligned TetraRecord
+//		table; drop TExtend (only needed for gradients).  Renumber
+//		tetrahedra along Z-order curve so neighbors share cache lines.
+// 20261016  Add SaveMeshCache(), LoadMeshCache() for binary copy of tables.
+// 20261016  Check mesh cache counts against file size, and indices against
+//		counts; zero record padding in cache files.
+// 20261016  Check TetraRecord flag byte when loading mesh cache.
+// 20261016  Add GetValues(), GetGradValues() to interpolate all value
+//		sets with a single search.
+// 20261016  Add EvaluateBatch() to search array of points in Z-order;
+//		SortTetrahedra() uses Morton key from base class.
+// 20261016  Split FillNeighbors(), FillRecords(), FillGradients() loops
+//		across threads with ParallelFor().
+// 20261016  FillNeighbors() matches facets in per-vertex lists, replacing
+//		sorted Tetra012..Tetra123 tables, FindNeighbor(), FindTetraID().
+// 20261016  Add GetMeshBounds(), IsInside() for regular-grid field cache.
 
 #include "G4CMPTriLinearInterp.hh"
 #include "G4CMPConfigManager.hh"
@@ -33,9 +53,14 @@
 #include "libqhullcpp/QhullFacetSet.h"
 #include "libqhullcpp/QhullVertexSet.h"
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <ctime>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <random>
 
 using namespace orgQhull;
 using std::array;
@@ -55,23 +80,15 @@ G4CMPTriLinearInterp(const vector<point3d>& xyz, const vector<G4double>& v,
 		     const vector<tetra3d>& tetra)
   : G4CMPTriLinearInterp() { UseMesh(xyz, v, tetra); }
 
-// Copy constructor used by Clone() function
+// Copy constructor used by Clone() function; tables are shared, not copied
 
 G4CMPTriLinearInterp::G4CMPTriLinearInterp(const G4CMPTriLinearInterp& rhs)
   : G4CMPTriLinearInterp() {
-  X = rhs.X;
+  Mesh = rhs.Mesh;
   V = rhs.V;
   Grad = rhs.Grad;
-  Tetrahedra = rhs.Tetrahedra;
-  Neighbors = rhs.Neighbors;
-  TInverse = rhs.TInverse;
-  TInvGood = rhs.TInvGood;
-  TExtend  = rhs.TExtend;
-
-  Tetra012 = rhs.Tetra012;	// Not really needed, but for completeness
-  Tetra013 = rhs.Tetra013;
-  Tetra023 = rhs.Tetra023;
-  Tetra123 = rhs.Tetra123;
+  VExtra = rhs.VExtra;
+  NExtra = rhs.NExtra;
 
   TetraIdx() = -1;
   TetraStart = rhs.TetraStart;
@@ -82,11 +99,22 @@ G4CMPTriLinearInterp::G4CMPTriLinearInterp(const G4CMPTriLinearInterp& rhs)
 
 void G4CMPTriLinearInterp::UseMesh(const vector<point3d> &xyz,
 				   const vector<G4double>& v) {
-  X = xyz;
-  V = v;
-  BuildTetraMesh();
-  FillTInverse();
+  // Existing tables may be shared with clones; always build new ones
+  auto mesh = std::make_shared<MeshTables>();
+  mesh->X = xyz;
+
+  vector<tetra3d> neighbors;		// Only needed to fill Records
+  BuildTetraMesh(*mesh, neighbors);
+  SortTetrahedra(*mesh, neighbors);
+  FillRecords(*mesh, neighbors);
+  FillSeedGrid(*mesh);
+  Mesh = mesh;
+
+  V = std::make_shared<ValueTable>(v);
+  ClearExtraValues();
   FillGradients();
+
+  TetraStart = -1;
   Initialize();
 
 #ifdef G4CMPTLI_DEBUG
@@ -98,12 +126,23 @@ void G4CMPTriLinearInterp::UseMesh(const vector<point3d> &xyz,
 void G4CMPTriLinearInterp::UseMesh(const vector<point3d>& xyz,
 				   const vector<G4double>& v,
 				   const vector<tetra3d>& tetra) {
-  X = xyz;
-  V = v;
-  Tetrahedra = tetra;
-  FillNeighbors();
-  FillTInverse();
+  // Existing tables may be shared with clones; always build new ones
+  auto mesh = std::make_shared<MeshTables>();
+  mesh->X = xyz;
+  mesh->Tetrahedra = tetra;
+
+  vector<tetra3d> neighbors;		// Only needed to fill Records
+  FillNeighbors(*mesh, neighbors);
+  SortTetrahedra(*mesh, neighbors);
+  FillRecords(*mesh, neighbors);
+  FillSeedGrid(*mesh);
+  Mesh = mesh;
+
+  V = std::make_shared<ValueTable>(v);
+  ClearExtraValues();
   FillGradients();
+
+  TetraStart = -1;
   Initialize();
 
 #ifdef G4CMPTLI_DEBUG
@@ -116,20 +155,26 @@ void G4CMPTriLinearInterp::UseMesh(const vector<point3d>& xyz,
 // Return index of tetrahedron with all edges shared, to start FindTetra()
 
 G4int G4CMPTriLinearInterp::FirstInteriorTetra() const {
-  G4int minIndex = Neighbors.size()/4;
+  const RecordTable& Records = Mesh->Records;	// For convenience
+
+  G4int minIndex = Records.size()/4;
 
-  for (G4int i=0; i<(G4int)Neighbors.size(); i++) {
-    if (*std::min_element(Neighbors[i].begin(), Neighbors[i].end())>minIndex)
+  for (G4int i=0; i<(G4int)Records.size(); i++) {
+    const tetra3d& neighbors = Records[i].neighbors;
+    if (*std::min_element(neighbors.begin(), neighbors.end())>minIndex)
       return i;
   }
 
-  return Neighbors.size()/2;
+  return Records.size()/2;
 }
 
 
 // Generate new Delaunay triagulation for current mesh of points
 
-void G4CMPTriLinearInterp::BuildTetraMesh() {
+void G4CMPTriLinearInterp::BuildTetraMesh(MeshTables& mesh,
+					  vector<tetra3d>& neighbors) const {
+  const vector<point3d>& X = mesh.X;		// For convenience below
+
   time_t start, fin;
   G4cout << "G4CMPTriLinearInterp::Constructor: Creating Tetrahedral Mesh..."
          << G4endl;
@@ -174,7 +219,7 @@ void G4CMPTriLinearInterp::BuildTetraMesh() {
       j = 0;
       for (vItr = facet.vertices().begin(); vItr != facet.vertices().end(); vItr++) {
         vertex = *vItr;
-        tmpTetrahedra[numTet][j++] = FindPointID(vertex.point().toStdVector(), vertex.id());
+        tmpTetrahedra[numTet][j++] = FindPointID(X, vertex.point().toStdVector(), vertex.id());
       }
       j = 0;
       for (nItr = facet.neighborFacets().begin(); nItr != facet.neighborFacets().end(); nItr++) {
@@ -196,8 +241,9 @@ void G4CMPTriLinearInterp::BuildTetraMesh() {
   tmpTetrahedra.resize(numTet);
   tmpNeighbors.resize(numTet);
 
-  Tetrahedra.swap(tmpTetrahedra);
-  Neighbors.swap(tmpNeighbors);
+  mesh.Tetrahedra.swap(tmpTetrahedra);
+  neighbors.swap(tmpNeighbors);
+  qhull2x.clear();			// Point lookup no longer needed
 
   delete[] boxPoints;
 
@@ -208,7 +254,8 @@ void G4CMPTriLinearInterp::BuildTetraMesh() {
 
 // Get index of specified mesh point (no interpolation!)
 
-G4int G4CMPTriLinearInterp::FindPointID(const vector<G4double>& pt,
+G4int G4CMPTriLinearInterp::FindPointID(const vector<point3d>& X,
+					const vector<G4double>& pt,
                                         const G4int id) const {
   if (qhull2x.count(id)) {
     return qhull2x[id];
@@ -247,67 +294,82 @@ G4int G4CMPTriLinearInterp::FindPointID(const vector<G4double>& pt,
 }
 
 
-// Tetrahedra sort functions, labelled for each facet option
+// Process list of defined tetrahedra and build table of neighbors.  Each
+// facet is filed under its lowest vertex, so the (at most two) tetrahedra
+// sharing it are found together in one short list, without a global sort.
 
-namespace {
-  G4bool tLess012(const tetra3d& a, const tetra3d& b) {
-    return ( a[0]<b[0] ||
-	     (a[0]==b[0] && (a[1]<b[1] ||
-			     (a[1]==b[1] && a[2]<b[2]))) );
-  }
-  
-  G4bool tLess013(const tetra3d& a, const tetra3d& b) {
-    return ( a[0]<b[0] ||
-	     (a[0]==b[0] && (a[1]<b[1] ||
-			     (a[1]==b[1] && a[3]<b[3]))) );
-  }
-  
-  G4bool tLess023(const tetra3d& a, const tetra3d& b) {
-    return ( a[0]<b[0] ||
-	     (a[0]==b[0] && (a[2]<b[2] ||
-			     (a[2]==b[2] && a[3]<b[3]))) );
-  }
-  
-  G4bool tLess123(const tetra3d& a, const tetra3d& b) {
-    return ( a[1]<b[1] ||
-	     (a[1]==b[1] && (a[2]<b[2] ||
-			     (a[2]==b[2] && a[3]<b[3]))) );
-  }
-}
-
-// Process list of defined tetrahedra and build table of neighbors
+void G4CMPTriLinearInterp::FillNeighbors(MeshTables& mesh,
+					 vector<tetra3d>& Neighbors) const {
+  vector<tetra3d>& Tetrahedra = mesh.Tetrahedra;	// For convenience below
 
-void G4CMPTriLinearInterp::FillNeighbors() {
   G4cout << "G4CMPTriLinearInterp::FillNeighbors (" << Tetrahedra.size()
 	 << " tetrahedra)" << G4endl;
 
   time_t start, fin;
   std::time(&start);
 
-  // Put the tetrahedra vertices, then the whole list, in indexed order
-  for (auto& iTetra: Tetrahedra) sort(iTetra.begin(), iTetra.end());
-  sort(Tetrahedra.begin(), Tetrahedra.end());
-
-  // Duplicate list sorted on facets (triplets of vertices)
-  Tetra012 = Tetrahedra; sort(Tetra012.begin(), Tetra012.end(), tLess012);
-  Tetra013 = Tetrahedra; sort(Tetra013.begin(), Tetra013.end(), tLess013);
-  Tetra023 = Tetrahedra; sort(Tetra023.begin(), Tetra023.end(), tLess023);
-  Tetra123 = Tetrahedra; sort(Tetra123.begin(), Tetra123.end(), tLess123);
+  // Put the tetrahedra vertices in indexed order, so facets compare directly
+  ParallelFor(Tetrahedra.size(), [&Tetrahedra](size_t begin, size_t end) {
+      for (size_t i=begin; i<end; i++) {
+	sort(Tetrahedra[i].begin(), Tetrahedra[i].end());
+      }
+    });
 
   G4int Ntet = Tetrahedra.size();		// For convenience below
 
   Neighbors.clear();
   Neighbors.resize(Ntet, {{-1,-1,-1,-1}});	// Pre-allocate space
 
-  // For each tetrahedron, find another which shares three corners
-  for (G4int i=0; i<Ntet; i++) {
-    const auto& iTet = Tetrahedra[i];
-    Neighbors[i][0] = FindNeighbor({{iTet[1],iTet[2],iTet[3]}}, i);
-    Neighbors[i][1] = FindNeighbor({{iTet[0],iTet[2],iTet[3]}}, i);
-    Neighbors[i][2] = FindNeighbor({{iTet[0],iTet[1],iTet[3]}}, i);
-    Neighbors[i][3] = FindNeighbor({{iTet[0],iTet[1],iTet[2]}}, i);
+  G4int Nvtx = 0;
+  for (const tetra3d& tetra: Tetrahedra) Nvtx = std::max(Nvtx, tetra[3]+1);
+
+  // Facet opposite vertex k of tetrahedron i is labelled 4*i+k.  Its lowest
+  // vertex is tetra[0], except for the facet opposite tetra[0] itself.
+  vector<G4int> first(Nvtx+1, 0);		// Start of each vertex's list
+  for (const tetra3d& tetra: Tetrahedra) {
+    first[tetra[0]+1] += 3;
+    first[tetra[1]+1]++;
+  }
+  for (G4int v=0; v<Nvtx; v++) first[v+1] += first[v];
+
+  vector<G4int> facets(4*size_t(Ntet));
+  {
+    vector<G4int> next(first.begin(), first.end()-1);
+    for (G4int i=0; i<Ntet; i++) {
+      facets[next[Tetrahedra[i][1]]++] = 4*i;
+      for (G4int k=1; k<4; k++) facets[next[Tetrahedra[i][0]]++] = 4*i+k;
+    }
   }
 
+  // Remaining two vertices of facet, packed for comparison within list
+  auto facetKey = [&Tetrahedra](G4int facet) -> std::uint64_t {
+    const tetra3d& tetra = Tetrahedra[facet/4];
+    const G4int k = facet%4;
+    return ((std::uint64_t(tetra[k<2 ? 2 : 1]) << 32) |
+	    std::uint32_t(tetra[k<3 ? 3 : 2]));
+  };
+
+  // Matching facets are adjacent once each (short) list is sorted
+  ParallelFor(Nvtx, [&](size_t begin, size_t end) {
+      vector<std::pair<std::uint64_t,G4int> > list;
+      for (size_t v=begin; v<end; v++) {
+	list.clear();
+	for (G4int j=first[v]; j<first[v+1]; j++) {
+	  list.emplace_back(facetKey(facets[j]), facets[j]);
+	}
+	sort(list.begin(), list.end());
+
+	for (size_t j=1; j<list.size(); j++) {
+	  const G4int fa = list[j-1].second, fb = list[j].second;
+	  if (list[j].first != list[j-1].first || fa/4 == fb/4) continue;
+
+	  Neighbors[fa/4][fa%4] = fb/4;
+	  Neighbors[fb/4][fb%4] = fa/4;
+	  j++;				// Facet can only be shared once
+	}
+      }
+    });
+
   std::time(&fin);
   G4cout << "G4CMPTriLinearInterp::FillNeighbors: Took "
          << difftime(fin, start) << " seconds for " << Neighbors.size()
@@ -315,56 +377,71 @@ void G4CMPTriLinearInterp::FillNeighbors() {
 
 }
 
-// Locate other tetrahedron with specified face (excluding "skip" tetrahedron)
 
-G4int G4CMPTriLinearInterp::FindNeighbor(const array<G4int,3>& facet,
-					G4int skip) const {
-  G4int result = -1;
-  result = FindTetraID(Tetra123, {{-1,facet[0],facet[1],facet[2]}}, skip, tLess123);
-  if (result >= 0) return result;	// Successful match
+// Renumber tetrahedra along Z-order (Morton) curve of their centroids, so
+// that tetrahedra close in space are close in memory during searches
 
-  result = FindTetraID(Tetra023, {{facet[0],-1,facet[1],facet[2]}}, skip, tLess023);
-  if (result >= 0) return result;	// Successful match
+void G4CMPTriLinearInterp::SortTetrahedra(MeshTables& mesh,
+					  vector<tetra3d>& neighbors) const {
+  const vector<point3d>& X = mesh.X;		// For convenience below
+  vector<tetra3d>& Tetrahedra = mesh.Tetrahedra;
+  const size_t ntet = Tetrahedra.size();
+  if (ntet < 2 || X.empty()) return;
 
-  result = FindTetraID(Tetra013, {{facet[0],facet[1],-1,facet[2]}}, skip, tLess013);
-  if (result >= 0) return result;	// Successful match
-
-  result = FindTetraID(Tetra012, {{facet[0],facet[1],facet[2],-1}}, skip, tLess012);
-  return result;			// If this one failed, they all failed
-}
+  // Bounding box of mesh points, to scale centroids to unit cube
+  point3d xmin = X[0], xmax = X[0];
+  for (const point3d& xi: X) {
+    for (G4int dim=0; dim<3; dim++) {
+      xmin[dim] = std::min(xmin[dim], xi[dim]);
+      xmax[dim] = std::max(xmax[dim], xi[dim]);
+    }
+  }
 
-// Locate other tetrahedron with given vertices (excluding "skip" tetrahedron)
-// "Wild" means that at least one vertex may be "-1", which matches anything
+  G4double scale[3];
+  for (G4int dim=0; dim<3; dim++) {
+    scale[dim] = (xmax[dim]>xmin[dim] ? 1./(xmax[dim]-xmin[dim]) : 0.);
+  }
 
-G4int G4CMPTriLinearInterp::
-FindTetraID(const vector<tetra3d>& tetras, const tetra3d& wildTetra, G4int skip,
-	    G4CMPTriLinearInterp::TetraComp tLess) const {
-  const auto start  = tetras.begin();
-  const auto finish = tetras.end();
+  vector<std::pair<uint64_t,G4int> > order(ntet);
+  G4double u[3];
+  for (size_t itet=0; itet<ntet; itet++) {
+    const tetra3d& tetra = Tetrahedra[itet];
+    for (G4int dim=0; dim<3; dim++) {
+      G4double c = 0.25*(X[tetra[0]][dim] + X[tetra[1]][dim] +
+			 X[tetra[2]][dim] + X[tetra[3]][dim]);
+      u[dim] = (c-xmin[dim])*scale[dim];
+    }
+    order[itet] = std::make_pair(MortonKey(u, 3), G4int(itet));
+  }
 
-  // Shared facet (if any) will always be adjacent in sorted table
-  auto match = lower_bound(start, finish, wildTetra, tLess);
-  if (match == finish) return -1;		// No match at all? PROBLEM!
+  sort(order.begin(), order.end());
 
-  G4int index = (lower_bound(Tetrahedra.begin(),Tetrahedra.end(),*match)
-		 - Tetrahedra.begin());
-  if (index == skip) {				// Move to adjacent entry
-    if (match == finish-1) return -1;		// Nothing left to search
+  // Move tetrahedra to new positions, and relabel neighbor indices
+  vector<G4int> newIndex(ntet);
+  for (size_t i=0; i<ntet; i++) newIndex[order[i].second] = i;
 
-    index = (lower_bound(Tetrahedra.begin(),Tetrahedra.end(),*(++match))
-	     - Tetrahedra.begin());
+  vector<tetra3d> newTetra(ntet), newNeighbors(ntet);
+  for (size_t i=0; i<ntet; i++) {
+    newTetra[i] = Tetrahedra[order[i].second];
+    newNeighbors[i] = neighbors[order[i].second];
+    for (G4int& n: newNeighbors[i]) if (n >= 0) n = newIndex[n];
   }
 
-  // Test for equality (not < nor >), return index or failure
-  return (!tLess(*match,wildTetra) && !tLess(wildTetra,*match)) ? index : -1;
+  Tetrahedra.swap(newTetra);
+  neighbors.swap(newNeighbors);
 }
 
+// Compute matrices used in tetrahedral barycentric coordinate calculation,
+// and pack with everything else FindTetrahedron() needs for each step
 
-// Compute matrices used in tetrahedral barycentric coordinate calculation
+void G4CMPTriLinearInterp::FillRecords(MeshTables& mesh,
+				       const vector<tetra3d>& neighbors) const {
+  const vector<point3d>& X = mesh.X;		// For convenience below
+  const vector<tetra3d>& Tetrahedra = mesh.Tetrahedra;
+  RecordTable& Records = mesh.Records;
 
-void G4CMPTriLinearInterp::FillTInverse() {
 #ifdef G4CMPTLI_DEBUG
-  G4cout << "G4CMPTriLinearInterp::FillTInverse (" << Tetrahedra.size()
+  G4cout << "G4CMPTriLinearInterp::FillRecords (" << Tetrahedra.size()
 	 << " tetrahedra)" << G4endl;
 
   time_t start, fin;
@@ -372,48 +449,195 @@ void G4CMPTriLinearInterp::FillTInverse() {
 #endif
 
   size_t ntet = Tetrahedra.size();
-  TInverse.resize(ntet);		    // Avoid reallocation inside loop
-  TExtend.resize(ntet);
-  TInvGood.resize(ntet, false);
+  Records.resize(ntet);			    // Avoid reallocation inside loop
+
+  ParallelFor(ntet, [&](size_t begin, size_t end) {
+      mat3x3 T;
+      for (size_t itet=begin; itet<end; itet++) {
+	const tetra3d& tetra = Tetrahedra[itet];  // For convenience below
+	TetraRecord& rec = Records[itet];
+#ifdef G4CMPTLI_DEBUG
+	if (G4CMPConfigManager::GetVerboseLevel() > 1) {
+	  G4cout << " Processing Tetrahedra[" << itet << "]: " << tetra
+		 << G4endl;
+	}
+#endif
+
+	for (G4int dim=0; dim<3; ++dim) {
+	  for (G4int vert=0; vert<3; ++vert) {
+	    T[dim][vert] = (X[tetra[vert]][dim] - X[tetra[3]][dim]);
+	  }
+	}
 
-  mat3x3 T;
+	rec.good = MatInv(T, rec.invT, true);
+	rec.X3 = X[tetra[3]];
+	rec.neighbors = neighbors[itet];
+      }	// for (itet...
+    });
+
+  // Report bad tetrahedra after filling, so messages are not interleaved
   for (size_t itet=0; itet<ntet; itet++) {
+    if (Records[itet].good) continue;
+
     const tetra3d& tetra = Tetrahedra[itet];	// For convenience below
-#ifdef G4CMPTLI_DEBUG
-    if (G4CMPConfigManager::GetVerboseLevel() > 1) {
-      G4cout << " Processing Tetrahedra[" << itet << "]: " << tetra << G4endl;
+    G4cerr << "ERROR: Non-invertible matrix " << itet << " with " << G4endl;
+    for (G4int i=0; i<4; i++) {
+      G4cerr << " " << tetra[i] << " @ " << X[tetra[i]] << G4endl;
     }
+  }
+
+#ifdef G4CMPTLI_DEBUG
+  std::time(&fin);
+  G4cout << "G4CMPTriLinearInterp::FillRecords: Took "
+         << difftime(fin, start) << " seconds for " << Records.size()
+	 << " entries." << G4endl;
 #endif
+}
 
-    for (G4int dim=0; dim<3; ++dim) {
-      for (G4int vert=0; vert<3; ++vert) {
-	T[dim][vert] = (X[tetra[vert]][dim] - X[tetra[3]][dim]);
-      }
+
+// Build uniform grid over mesh, with a nearby tetrahedron for each cell
+
+namespace {
+  // Convert coordinate to cell index along one axis, clamped to grid
+  inline G4int GridCell(G4double x, G4double xmin, G4double step, G4int n) {
+    return std::min(std::max(G4int((x-xmin)/step), 0), n-1);
+  }
+}
+
+void G4CMPTriLinearInterp::FillSeedGrid(MeshTables& mesh) const {
+  mesh.GridSeed.clear();
+  if (mesh.Tetrahedra.empty()) return;
+
+  const vector<point3d>& X = mesh.X;		// For convenience below
+  const vector<tetra3d>& Tetrahedra = mesh.Tetrahedra;
+
+  // Bounding box of mesh points
+  point3d xmax = X[0];
+  mesh.GridMin = X[0];
+  for (const point3d& xi: X) {
+    for (G4int dim=0; dim<3; dim++) {
+      mesh.GridMin[dim] = std::min(mesh.GridMin[dim], xi[dim]);
+      xmax[dim] = std::max(xmax[dim], xi[dim]);
     }
+  }
+
+  // Choose roughly cubical cells, about one per mesh point
+  G4double maxExtent = 0.;
+  for (G4int dim=0; dim<3; dim++)
+    maxExtent = std::max(maxExtent, xmax[dim]-mesh.GridMin[dim]);
+
+  G4double volume = 1.;
+  G4int ndim = 0;
+  for (G4int dim=0; dim<3; dim++) {
+    G4double extent = xmax[dim]-mesh.GridMin[dim];
+    if (extent > 1e-6*maxExtent) { volume *= extent; ndim++; }
+  }
+
+  G4double cell = (ndim>0 ? std::pow(volume/X.size(), 1./ndim) : 1.);
+
+  for (G4int dim=0; dim<3; dim++) {
+    G4double extent = xmax[dim]-mesh.GridMin[dim];
+    if (extent > 1e-6*maxExtent) {
+      mesh.GridN[dim] = std::max(1, G4int(std::ceil(extent/cell)));
+      mesh.GridStep[dim] = extent/mesh.GridN[dim];
+    } else {
+      mesh.GridN[dim] = 1;
+      mesh.GridStep[dim] = (extent>0. ? extent : 1.);
+    }
+  }
 
-    TInvGood[itet] = MatInv(T, TInverse[itet], true);
-    BuildT4x3(itet, TExtend[itet]);
+  const G4int nx = mesh.GridN[0], ny = mesh.GridN[1], nz = mesh.GridN[2];
+  mesh.GridSeed.assign(nx*ny*nz, -1);
+  vector<G4bool> centered(mesh.GridSeed.size(), false);
+
+  // Each cell gets a tetrahedron containing its center, if one exists,
+  // otherwise any tetrahedron whose bounding box overlaps the cell
+  const G4double barySafety = -1e-10;	// Same tolerance as FindTetrahedron
+  G4int lo[3], hi[3];
+  for (size_t itet=0; itet<Tetrahedra.size(); itet++) {
+    const TetraRecord& rec = mesh.Records[itet];
+    if (!rec.good) continue;			// Unusable for searches
+
+    const tetra3d& tetra = Tetrahedra[itet];	// For convenience below
+    const mat3x3& invT = rec.invT;
+    const point3d& X3 = rec.X3;
+
+    for (G4int dim=0; dim<3; dim++) {
+      G4double tmin = X[tetra[0]][dim], tmax = tmin;
+      for (G4int vert=1; vert<4; vert++) {
+	tmin = std::min(tmin, X[tetra[vert]][dim]);
+	tmax = std::max(tmax, X[tetra[vert]][dim]);
+      }
+      lo[dim] = GridCell(tmin, mesh.GridMin[dim], mesh.GridStep[dim],
+			 mesh.GridN[dim]);
+      hi[dim] = GridCell(tmax, mesh.GridMin[dim], mesh.GridStep[dim],
+			 mesh.GridN[dim]);
+    }
 
-    if (!TInvGood[itet]) {
-      G4cerr << "ERROR: Non-invertible matrix " << itet << " with " << G4endl;
-      for (G4int i=0; i<4; i++) {
-	G4cerr << " " << tetra[i] << " @ " << X[tetra[i]] << G4endl;
+    G4double center[3], bary[4];
+    for (G4int iz=lo[2]; iz<=hi[2]; iz++) {
+      center[2] = mesh.GridMin[2] + (iz+0.5)*mesh.GridStep[2] - X3[2];
+      for (G4int iy=lo[1]; iy<=hi[1]; iy++) {
+	center[1] = mesh.GridMin[1] + (iy+0.5)*mesh.GridStep[1] - X3[1];
+	for (G4int ix=lo[0]; ix<=hi[0]; ix++) {
+	  G4int icell = ix + nx*(iy + ny*iz);
+	  if (centered[icell]) continue;
+
+	  if (mesh.GridSeed[icell] < 0) mesh.GridSeed[icell] = itet;
+
+	  center[0] = mesh.GridMin[0] + (ix+0.5)*mesh.GridStep[0] - X3[0];
+	  bary[3] = 1.;
+	  for (G4int k=0; k<3; k++) {
+	    bary[k] = (invT[k][0]*center[0] + invT[k][1]*center[1] +
+		       invT[k][2]*center[2]);
+	    bary[3] -= bary[k];
+	  }
+
+	  if (std::all_of(bary, bary+4,
+			  [barySafety](G4double b){return b>=barySafety;})) {
+	    mesh.GridSeed[icell] = itet;
+	    centered[icell] = true;
+	  }
+	}	// for (ix...
       }
     }
   }	// for (itet...
 
 #ifdef G4CMPTLI_DEBUG
-  std::time(&fin);
-  G4cout << "G4CMPTriLinearInterp::FillTInverse: Took "
-         << difftime(fin, start) << " seconds for " << TInverse.size()
-	 << " entries." << G4endl;
+  G4cout << "G4CMPTriLinearInterp::FillSeedGrid: " << nx << " x " << ny
+	 << " x " << nz << " cells, "
+	 << std::count(centered.begin(), centered.end(), true)
+	 << " with centers inside mesh" << G4endl;
 #endif
 }
 
+// Look up seed tetrahedron from grid; -1 means point is outside the hull
+
+G4int G4CMPTriLinearInterp::FindSeedTetra(const G4double pt[3]) const {
+  const MeshTables& mesh = *Mesh;		// For convenience below
+  if (mesh.GridSeed.empty()) return -1;
+
+  const G4double gridTol = 1e-6;	// Fraction of cell, for rounding errors
+
+  G4int icell[3];
+  for (G4int dim=0; dim<3; dim++) {
+    G4double u = (pt[dim]-mesh.GridMin[dim]) / mesh.GridStep[dim];
+    if (u < -gridTol || u > mesh.GridN[dim]+gridTol) return -1;
+    icell[dim] = std::min(std::max(G4int(u), 0), mesh.GridN[dim]-1);
+  }
+
+  return mesh.GridSeed[icell[0] + mesh.GridN[0]*(icell[1] +
+						 mesh.GridN[1]*icell[2])];
+}
+
 
 // Compute field (gradient) across each tetrahedron
 
 void G4CMPTriLinearInterp::FillGradients() {
+  const vector<tetra3d>& Tetrahedra = Mesh->Tetrahedra;	// For convenience
+  const RecordTable& Records = Mesh->Records;
+  const ValueTable& V = *(this->V);
+
 #ifdef G4CMPTLI_DEBUG
   G4cout << "G4CMPTriLinearInterp::FillGradients (" << Tetrahedra.size()
 	 << " tetrahedra)" << G4endl;
@@ -422,26 +646,31 @@ void G4CMPTriLinearInterp::FillGradients() {
   std::time(&start);
 #endif
 
+  // Existing gradients may be shared with clones; fill new table
   size_t ntet = Tetrahedra.size();
-  Grad.resize(ntet);		    // Avoid reallocation inside loop
-
-  for (size_t itet=0; itet<ntet; itet++) {
-    const tetra3d& tetra = Tetrahedra[itet];  // For convenience below
-    const mat4x3& ET = TExtend[itet];
-
-    Grad[itet].set((V[tetra[0]]*ET[0][0] + V[tetra[1]]*ET[1][0] +
-		    V[tetra[2]]*ET[2][0] + V[tetra[3]]*ET[3][0]),
-		   (V[tetra[0]]*ET[0][1] + V[tetra[1]]*ET[1][1] +
-		    V[tetra[2]]*ET[2][1] + V[tetra[3]]*ET[3][1]),
-		   (V[tetra[0]]*ET[0][2] + V[tetra[1]]*ET[1][2] +
-		    V[tetra[2]]*ET[2][2] + V[tetra[3]]*ET[3][2])
-		   );
+  auto grad = std::make_shared<GradTable>(ntet);
+  GradTable& Grad = *grad;
+
+  ParallelFor(ntet, [&](size_t begin, size_t end) {
+      mat4x3 ET;
+      for (size_t itet=begin; itet<end; itet++) {
+	const tetra3d& tetra = Tetrahedra[itet];  // For convenience below
+	BuildT4x3(Records[itet].invT, ET);
+
+	Grad[itet].set((V[tetra[0]]*ET[0][0] + V[tetra[1]]*ET[1][0] +
+			V[tetra[2]]*ET[2][0] + V[tetra[3]]*ET[3][0]),
+		       (V[tetra[0]]*ET[0][1] + V[tetra[1]]*ET[1][1] +
+			V[tetra[2]]*ET[2][1] + V[tetra[3]]*ET[3][1]),
+		       (V[tetra[0]]*ET[0][2] + V[tetra[1]]*ET[1][2] +
+			V[tetra[2]]*ET[2][2] + V[tetra[3]]*ET[3][2])
+		       );
 #ifdef G4CMPTLI_DEBUG
-    if (G4CMPConfigManager::GetVerboseLevel() > 1) {
-      G4cout << " Computed Grad[" << itet << "]: " << Grad[itet] << G4endl;
-    }
+	if (G4CMPConfigManager::GetVerboseLevel() > 1) {
+	  G4cout << " Computed Grad[" << itet << "]: " << Grad[itet] << G4endl;
+	}
 #endif
-  }	// for (itet...
+      }	// for (itet...
+    });
 
 #ifdef G4CMPTLI_DEBUG
   std::time(&fin);
@@ -449,6 +678,8 @@ void G4CMPTriLinearInterp::FillGradients() {
          << difftime(fin, start) << " seconds for " << Grad.size()
 	 << " entries." << G4endl;
 #endif
+
+  this->Grad = grad;
 }
 
 
@@ -461,10 +692,11 @@ G4CMPTriLinearInterp::GetValue(const G4double pos[3], G4bool quiet) const {
     
   if (TetraIdx() == -1) return 0;
 
-  return(V[Tetrahedra[TetraIdx()][0]] * bary[0] +
-	 V[Tetrahedra[TetraIdx()][1]] * bary[1] +
-	 V[Tetrahedra[TetraIdx()][2]] * bary[2] +
-	 V[Tetrahedra[TetraIdx()][3]] * bary[3]);    
+  const tetra3d& tetra = Mesh->Tetrahedra[TetraIdx()];
+  const ValueTable& V = *(this->V);
+
+  return(V[tetra[0]] * bary[0] + V[tetra[1]] * bary[1] +
+	 V[tetra[2]] * bary[2] + V[tetra[3]] * bary[3]);
 }
 
 G4ThreeVector 
@@ -473,7 +705,79 @@ G4CMPTriLinearInterp::GetGrad(const G4double pos[3], G4bool quiet) const {
 
   G4double bary[4] = { 0. };
   FindTetrahedron(pos, bary, quiet);
-  return (TetraIdx()<0. ? zero : Grad[TetraIdx()]);
+  return (TetraIdx()<0. ? zero : (*Grad)[TetraIdx()]);
+}
+
+void G4CMPTriLinearInterp::GetValues(const G4double pos[3], G4double values[],
+				     G4bool quiet) const {
+  G4double bary[4] = { 0. };
+  FindTetrahedron(pos, bary, quiet);
+  FillValues(bary, values);
+}
+
+G4ThreeVector
+G4CMPTriLinearInterp::GetGradValues(const G4double pos[3], G4double values[],
+				    G4bool quiet) const {
+  static const G4ThreeVector zero(0.,0.,0.);	// For failure returns
+
+  G4double bary[4] = { 0. };
+  FindTetrahedron(pos, bary, quiet);
+  FillValues(bary, values);
+  return (TetraIdx()<0. ? zero : (*Grad)[TetraIdx()]);
+}
+
+// Evaluate many points without per-point virtual calls; large batches
+// spread over the mesh are visited along a Z-order curve
+
+void G4CMPTriLinearInterp::EvaluateBatch(size_t npts, const G4double pos[],
+					 G4double values[],
+					 G4ThreeVector grads[],
+					 G4bool quiet) const {
+  static const G4ThreeVector zero(0.,0.,0.);	// For failure returns
+
+  const G4int nsets = GetNumberOfValueSets();
+
+  // Seed grid covers bounding box of mesh
+  const MeshTables& mesh = *Mesh;
+  G4double meshMax[3];
+  for (G4int dim=0; dim<3; dim++) {
+    meshMax[dim] = mesh.GridMin[dim] + mesh.GridN[dim]*mesh.GridStep[dim];
+  }
+
+  vector<size_t> order;
+  SortPoints(npts, pos, 3, mesh.GridMin.data(), meshMax,
+	     mesh.Tetrahedra.size(), order);
+
+  G4double bary[4] = { 0. };
+  for (size_t i: order) {
+    FindTetrahedron(pos+3*i, bary, quiet);
+    if (values) FillValues(bary, values+i*nsets);
+    if (grads) grads[i] = (TetraIdx()<0. ? zero : (*Grad)[TetraIdx()]);
+  }
+}
+
+void G4CMPTriLinearInterp::FillValues(const G4double bary[4],
+				      G4double values[]) const {
+  if (TetraIdx() < 0.) {
+    std::fill(values, values+GetNumberOfValueSets(), 0.);
+    return;
+  }
+
+  const tetra3d& tetra = Mesh->Tetrahedra[TetraIdx()];
+  const ValueTable& V = *(this->V);
+
+  values[0] = 0.;
+  for (G4int j=0; j<4; j++) values[0] += V[tetra[j]] * bary[j];
+
+  if (NExtra == 0) return;
+
+  const ValueTable& VX = *VExtra;		// Interleaved by mesh point
+  for (G4int k=0; k<NExtra; k++) {
+    values[1+k] = (VX[tetra[0]*NExtra+k] * bary[0] +
+		   VX[tetra[1]*NExtra+k] * bary[1] +
+		   VX[tetra[2]*NExtra+k] * bary[2] +
+		   VX[tetra[3]*NExtra+k] * bary[3]);
+  }
 }
 
 
@@ -484,15 +788,32 @@ G4CMPTriLinearInterp::FindTetrahedron(const G4double pt[3], G4double bary[4],
 				      G4bool quiet) const {
   const G4double barySafety = -1e-10;	// Deal with points close to facets
 
+  const vector<tetra3d>& Tetrahedra = Mesh->Tetrahedra;	// For convenience
+  const RecordTable& Records = Mesh->Records;
+
   G4double bestBary = 0.;	// Norm of barycentric coordinates (below)
   G4int bestTet = -1;
 
-  if (TetraIdx() == -1) TetraIdx() = TetraStart;
+  // Grid index rejects points outside mesh, or gives nearby starting point
+  G4int seedTet = FindSeedTetra(pt);
+  if (seedTet < 0) {
+    if (!quiet) {
+      G4cerr << "G4CMPTriLinearInterp::FindTetrahedron:"
+	     << " Point outside of hull!\n pt = "
+	     << pt[0] << " " << pt[1] << " " << pt[2] << G4endl;
+    }
+
+    TetraIdx() = -1;
+    return;
+  }
+
+  if (TetraIdx() == -1) TetraIdx() = seedTet;
 
 #ifdef G4CMPTLI_DEBUG
   if (G4CMPConfigManager::GetVerboseLevel() > 1) {
     G4cout << "FindTetrahedron pt " << pt[0] << " " << pt[1] << " " << pt[2]
-	   << "\n starting from TetraIdx " << TetraIdx() << G4endl;
+	   << "\n starting from TetraIdx " << TetraIdx() << " (seed "
+	   << seedTet << ")" << G4endl;
   }
 #endif
 
@@ -526,9 +847,15 @@ G4CMPTriLinearInterp::FindTetrahedron(const G4double pt[3], G4double bary[4],
     if (std::all_of(bary, bary+4,
 		    [barySafety](G4double b){return b>=barySafety;})) return;
 
+    // Previous tetrahedron missed; jump to neighborhood of new point
+    if (count == 0 && TetraIdx() != seedTet) {
+      TetraIdx() = seedTet;
+      continue;
+    }
+
     // Evaluate barycentric distance from current tetrahedron
     G4double newNorm = BaryNorm(bary);
-    if (newNorm < bestBary || count == 0) {	// Getting closer
+    if (newNorm < bestBary || bestTet < 0) {	// Getting closer
       bestBary = newNorm;
       bestTet  = TetraIdx();
 
@@ -543,7 +870,7 @@ G4CMPTriLinearInterp::FindTetrahedron(const G4double pt[3], G4double bary[4],
     // Point is outside current tetrahedron; shift to nearest neighbor
     G4int minBaryIdx = std::min_element(bary, bary+4) - bary;
 
-    G4int newTetraIdx = Neighbors[TetraIdx()][minBaryIdx];
+    G4int newTetraIdx = Records[TetraIdx()].neighbors[minBaryIdx];
     if (newTetraIdx == -1) {	// Fell off edge of world
       if (!quiet) {
 	G4cerr << "G4CMPTriLinearInterp::FindTetrahedron:"
@@ -584,37 +911,35 @@ G4CMPTriLinearInterp::FindTetrahedron(const G4double pt[3], G4double bary[4],
 
 G4bool
 G4CMPTriLinearInterp::Cart2Bary(const G4double pt[3], G4double bary[4]) const {
-  const tetra3d& tetra = Tetrahedra[TetraIdx()];	// For convenience below
-  const mat3x3& invT = TInverse[TetraIdx()];
+  const TetraRecord& rec = Mesh->Records[TetraIdx()];	// For convenience
+  const mat3x3& invT = rec.invT;
+  const point3d& X3 = rec.X3;
 
-  if (TInvGood[TetraIdx()]) {
+  if (rec.good) {
     bary[3] = 1.0;
     for(G4int k=0; k<3; ++k) {
-      bary[k] = (invT[k][0]*(pt[0] - X[tetra[3]][0]) +
-		 invT[k][1]*(pt[1] - X[tetra[3]][1]) +
-		 invT[k][2]*(pt[2] - X[tetra[3]][2]) );
+      bary[k] = (invT[k][0]*(pt[0] - X3[0]) +
+		 invT[k][1]*(pt[1] - X3[1]) +
+		 invT[k][2]*(pt[2] - X3[2]) );
       bary[3] -= bary[k];
     }
   }
 
-  return TInvGood[TetraIdx()];
+  return rec.good;
 }
 
 G4double G4CMPTriLinearInterp::BaryNorm(G4double bary[4]) const {
   return (bary[0]*bary[0]+bary[1]*bary[1]+bary[2]*bary[2]+bary[3]*bary[3]);
 }
 
-G4bool G4CMPTriLinearInterp::BuildT4x3(size_t iTet, mat4x3& ET) const {
+void G4CMPTriLinearInterp::BuildT4x3(const mat3x3& invT, mat4x3& ET) const {
   // NOTE:  If matrix inversion failed, invT is set to all zeros
-  const mat3x3& invT = TInverse[iTet];	// For convenience below
   for (G4int i=0; i<3; ++i) {
     for (G4int j=0; j<3; ++j) {
       ET[i][j] = invT[i][j];
     }
     ET[3][i] = -invT[0][i] - invT[1][i] - invT[2][i];
   }
-
-  return TInvGood[iTet];
 }
 
 G4double G4CMPTriLinearInterp::Det3(const mat3x3& matrix) const {
@@ -664,8 +989,8 @@ G4bool G4CMPTriLinearInterp::MatInv(const mat3x3& matrix, mat3x3& result,
 void G4CMPTriLinearInterp::SavePoints(const G4String& fname) const {
   G4cout << "Writing points and values to " << fname << G4endl;
   std::ofstream save(fname);
-  for (size_t i=0; i<X.size(); i++) {
-    save << X[i] << " " << V[i]
+  for (size_t i=0; i<Mesh->X.size(); i++) {
+    save << Mesh->X[i] << " " << (*V)[i]
 	 << std::endl;
   }
 }
@@ -673,16 +998,295 @@ void G4CMPTriLinearInterp::SavePoints(const G4String& fname) const {
 void G4CMPTriLinearInterp::SaveTetra(const G4String& fname) const {
   G4cout << "Writing tetrahedra and neighbors to " << fname << G4endl;
   std::ofstream save(fname);
-    for (size_t i=0; i<Tetrahedra.size(); i++) {
-      save << Tetrahedra[i] << "        " << Neighbors[i] << std::endl;
+    for (size_t i=0; i<Mesh->Tetrahedra.size(); i++) {
+      save << Mesh->Tetrahedra[i] << "        " << Mesh->Records[i].neighbors
+	   << std::endl;
+  }
+}
+
+
+// Compare mesh coordinates, to see if other values may be used here
+
+G4bool G4CMPTriLinearInterp::SameMeshPoints(const vector<point3d>& xyz) const {
+  return (Mesh && Mesh->X == xyz);
+}
+
+// Bounding box of mesh points (not of seed grid, which may be larger)
+
+void G4CMPTriLinearInterp::GetMeshBounds(G4double xmin[3],
+					 G4double xmax[3]) const {
+  std::fill(xmin, xmin+3, 0.);
+  std::fill(xmax, xmax+3, 0.);
+  if (!Mesh || Mesh->X.empty()) return;
+
+  std::copy(Mesh->X[0].begin(), Mesh->X[0].end(), xmin);
+  std::copy(Mesh->X[0].begin(), Mesh->X[0].end(), xmax);
+  for (const point3d& xi: Mesh->X) {
+    for (G4int dim=0; dim<3; dim++) {
+      xmin[dim] = std::min(xmin[dim], xi[dim]);
+      xmax[dim] = std::max(xmax[dim], xi[dim]);
+    }
+  }
+}
+
+// Search for point without error messages; TetraIdx() is left pointing
+// to containing tetrahedron, so GetGrad() at same point is immediate
+
+G4bool G4CMPTriLinearInterp::IsInside(const G4double pos[3]) const {
+  G4double bary[4] = { 0. };
+  FindTetrahedron(pos, bary, true);
+  return (TetraIdx() >= 0.);
+}
+
+
+// Binary mesh cache: fixed header, then tables in the order written below,
+// each padded to a 64-byte boundary so that the file could be mmap()ed
+
+namespace {
+  const char meshCacheMagic[8] = { 'G','4','C','M','P','T','L','I' };
+  const std::uint32_t meshCacheVersion = 1;
+  const std::uint32_t meshCacheByteOrder = 0x01020304;
+
+  struct MeshCacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;	// Reject files written on other endianness
+    std::uint64_t key;		// Identifies source of mesh (e.g., file hash)
+    std::uint64_t recordSize;	// Reject files with different record layout
+    std::uint64_t nPoints;
+    std::uint64_t nTetra;
+    std::uint64_t nGrid;
+    std::int32_t gridN[4];	// Fourth entry is padding
+    G4double gridMin[3];
+    G4double gridStep[3];
+  };
+
+  size_t PaddedSize(size_t nbytes) { return nbytes + (64 - nbytes%64) % 64; }
+
+  void WritePadding(std::ostream& os, size_t nbytes) {
+    static const char zeros[64] = { 0 };
+    os.write(zeros, PaddedSize(nbytes) - nbytes);
+  }
+
+  void WriteBlock(std::ostream& os, const void* data, size_t nbytes) {
+    os.write(static_cast<const char*>(data), nbytes);
+    WritePadding(os, nbytes);
+  }
+
+  G4bool ReadBlock(std::istream& is, void* data, size_t nbytes) {
+    is.read(static_cast<char*>(data), nbytes);
+    is.ignore((64 - nbytes%64) % 64);
+    return !is.fail();
+  }
+}
+
+G4bool G4CMPTriLinearInterp::SaveMeshCache(const G4String& fname,
+					   std::uint64_t key) const {
+  if (!Mesh || !V || !Grad) return false;
+  const MeshTables& mesh = *Mesh;		// For convenience below
+
+  MeshCacheHeader head;
+  std::memset(&head, 0, sizeof(head));
+  std::copy(meshCacheMagic, meshCacheMagic+8, head.magic);
+  head.version    = meshCacheVersion;
+  head.byteOrder  = meshCacheByteOrder;
+  head.key        = key;
+  head.recordSize = sizeof(TetraRecord);
+  head.nPoints    = mesh.X.size();
+  head.nTetra     = mesh.Tetrahedra.size();
+  head.nGrid      = mesh.GridSeed.size();
+  for (G4int dim=0; dim<3; dim++) {
+    head.gridN[dim]    = mesh.GridN[dim];
+    head.gridMin[dim]  = mesh.GridMin[dim];
+    head.gridStep[dim] = mesh.GridStep[dim];
   }
+
+  // Gradients are stored as plain triplets, not G4ThreeVector objects
+  vector<G4double> grad;
+  grad.reserve(3*Grad->size());
+  for (const G4ThreeVector& g: *Grad) {
+    grad.push_back(g.x()); grad.push_back(g.y()); grad.push_back(g.z());
+  }
+
+  // Write to temporary file, then rename, so other jobs never see partial
+  std::random_device rndm;
+  G4String tmpName = fname + ".tmp" + std::to_string(rndm());
+
+  std::ofstream save(tmpName, std::ios::binary|std::ios::trunc);
+  if (!save.good()) {
+    G4cerr << "G4CMPTriLinearInterp::SaveMeshCache: Unable to write "
+	   << fname << G4endl;
+    return false;
+  }
+
+  WriteBlock(save, &head, sizeof(head));
+  WriteBlock(save, mesh.X.data(), mesh.X.size()*sizeof(point3d));
+  WriteBlock(save, V->data(), V->size()*sizeof(G4double));
+  WriteBlock(save, mesh.Tetrahedra.data(),
+	     mesh.Tetrahedra.size()*sizeof(tetra3d));
+
+  // Records are copied member by member into zeroed buffer, so that
+  // padding bytes in file are reproducible (not whatever was in memory)
+  const size_t recChunk = 4096;
+  vector<char> recBuf(recChunk*sizeof(TetraRecord));
+  for (size_t i0=0; i0<mesh.Records.size(); i0+=recChunk) {
+    size_t nrec = std::min(recChunk, mesh.Records.size()-i0);
+    std::fill(recBuf.begin(), recBuf.end(), 0);
+    for (size_t i=0; i<nrec; i++) {
+      const TetraRecord& rec = mesh.Records[i0+i];
+      char* buf = recBuf.data() + i*sizeof(TetraRecord);
+      std::memcpy(buf+offsetof(TetraRecord,invT), &rec.invT, sizeof(rec.invT));
+      std::memcpy(buf+offsetof(TetraRecord,X3), &rec.X3, sizeof(rec.X3));
+      std::memcpy(buf+offsetof(TetraRecord,neighbors), &rec.neighbors,
+		  sizeof(rec.neighbors));
+      std::memcpy(buf+offsetof(TetraRecord,good), &rec.good, sizeof(rec.good));
+    }
+    save.write(recBuf.data(), nrec*sizeof(TetraRecord));
+  }
+  WritePadding(save, mesh.Records.size()*sizeof(TetraRecord));
+
+  WriteBlock(save, grad.data(), grad.size()*sizeof(G4double));
+  WriteBlock(save, mesh.GridSeed.data(), mesh.GridSeed.size()*sizeof(G4int));
+  save.close();
+
+  if (save.fail() || std::rename(tmpName.c_str(), fname.c_str()) != 0) {
+    G4cerr << "G4CMPTriLinearInterp::SaveMeshCache: Failed writing "
+	   << fname << G4endl;
+    std::remove(tmpName.c_str());
+    return false;
+  }
+
+  if (G4CMPConfigManager::GetVerboseLevel() > 0) {
+    G4cout << "G4CMPTriLinearInterp: Wrote mesh cache " << fname << G4endl;
+  }
+
+  return true;
+}
+
+G4bool G4CMPTriLinearInterp::LoadMeshCache(const G4String& fname,
+					   std::uint64_t key) {
+  std::ifstream load(fname, std::ios::binary);
+  if (!load.good()) return false;		// No cache yet, not an error
+
+  MeshCacheHeader head;
+  if (!ReadBlock(load, &head, sizeof(head)) ||
+      !std::equal(meshCacheMagic, meshCacheMagic+8, head.magic) ||
+      head.version != meshCacheVersion ||
+      head.byteOrder != meshCacheByteOrder ||
+      head.recordSize != sizeof(TetraRecord) || head.key != key) {
+    if (G4CMPConfigManager::GetVerboseLevel() > 0) {
+      G4cout << "G4CMPTriLinearInterp: Mesh cache " << fname
+	     << " is stale or incompatible" << G4endl;
+    }
+    return false;
+  }
+
+  // Counts must match file size before anything is allocated
+  load.seekg(0, std::ios::end);
+  const std::uint64_t fileSize = load.tellg();
+  load.seekg(PaddedSize(sizeof(head)), std::ios::beg);
+
+  std::uint64_t nGridN = 1;
+  for (G4int dim=0; dim<3; dim++) {
+    nGridN *= (head.gridN[dim] > 0) ? std::uint64_t(head.gridN[dim]) : 0;
+  }
+
+  G4bool sized =
+    (head.nPoints <= fileSize/sizeof(point3d) &&
+     head.nTetra <= fileSize/sizeof(TetraRecord) &&
+     head.nGrid <= fileSize/sizeof(G4int) &&
+     (head.nGrid == 0 || head.nGrid == nGridN) &&
+     fileSize == (PaddedSize(sizeof(head)) +
+		  PaddedSize(head.nPoints*sizeof(point3d)) +
+		  PaddedSize(head.nPoints*sizeof(G4double)) +
+		  PaddedSize(head.nTetra*sizeof(tetra3d)) +
+		  PaddedSize(head.nTetra*sizeof(TetraRecord)) +
+		  PaddedSize(head.nTetra*3*sizeof(G4double)) +
+		  PaddedSize(head.nGrid*sizeof(G4int))));
+
+  if (!sized) {
+    G4cerr << "G4CMPTriLinearInterp::LoadMeshCache: " << fname
+	   << " is truncated or corrupt" << G4endl;
+    return false;
+  }
+
+  auto mesh = std::make_shared<MeshTables>();
+  auto vals = std::make_shared<ValueTable>(head.nPoints);
+  vector<G4double> grad(3*head.nTetra);
+
+  mesh->X.resize(head.nPoints);
+  mesh->Tetrahedra.resize(head.nTetra);
+  mesh->Records.resize(head.nTetra);
+  mesh->GridSeed.resize(head.nGrid);
+  for (G4int dim=0; dim<3; dim++) {
+    mesh->GridN[dim]    = head.gridN[dim];
+    mesh->GridMin[dim]  = head.gridMin[dim];
+    mesh->GridStep[dim] = head.gridStep[dim];
+  }
+
+  G4bool good =
+    (ReadBlock(load, mesh->X.data(), mesh->X.size()*sizeof(point3d)) &&
+     ReadBlock(load, vals->data(), vals->size()*sizeof(G4double)) &&
+     ReadBlock(load, mesh->Tetrahedra.data(),
+	       mesh->Tetrahedra.size()*sizeof(tetra3d)) &&
+     ReadBlock(load, mesh->Records.data(),
+	       mesh->Records.size()*sizeof(TetraRecord)) &&
+     ReadBlock(load, grad.data(), grad.size()*sizeof(G4double)) &&
+     ReadBlock(load, mesh->GridSeed.data(),
+	       mesh->GridSeed.size()*sizeof(G4int)));
+
+  // Indices must be in range, or searches would read outside tables;
+  // matrix flag is a byte, which must be 0 or 1
+  const G4int nPts = G4int(head.nPoints), nTet = G4int(head.nTetra);
+  for (size_t i=0; good && i<head.nTetra; i++) {
+    for (G4int j=0; j<4; j++) {
+      G4int ipt = mesh->Tetrahedra[i][j];
+      G4int inb = mesh->Records[i].neighbors[j];
+      good &= (ipt >= 0 && ipt < nPts && inb >= -1 && inb < nTet);
+    }
+    good &= (mesh->Records[i].good <= 1);
+  }
+
+  for (size_t i=0; good && i<head.nGrid; i++) {
+    good &= (mesh->GridSeed[i] >= -1 && mesh->GridSeed[i] < nTet);
+  }
+
+  if (!good) {
+    G4cerr << "G4CMPTriLinearInterp::LoadMeshCache: " << fname
+	   << " is truncated or corrupt" << G4endl;
+    return false;
+  }
+
+  auto grads = std::make_shared<GradTable>(head.nTetra);
+  for (size_t i=0; i<grads->size(); i++) {
+    (*grads)[i].set(grad[3*i], grad[3*i+1], grad[3*i+2]);
+  }
+
+  Mesh = mesh;
+  V = vals;
+  Grad = grads;
+  ClearExtraValues();
+
+  TetraStart = -1;
+  Initialize();
+
+  if (G4CMPConfigManager::GetVerboseLevel() > 0) {
+    G4cout << "G4CMPTriLinearInterp: Loaded " << head.nTetra
+	   << " tetrahedra from mesh cache " << fname << G4endl;
+  }
+
+  return true;
 }
 
 
 // Print out tetrahedral information with coordinates
 
 void G4CMPTriLinearInterp::PrintTetra(std::ostream& os, G4int iTetra) const {
-  os << " from tetra " << iTetra << " neighbors " << Neighbors[iTetra] << ":"
+  const vector<point3d>& X = Mesh->X;		// For convenience below
+  const vector<tetra3d>& Tetrahedra = Mesh->Tetrahedra;
+  const tetra3d& neighbors = Mesh->Records[iTetra].neighbors;
+
+  os << " from tetra " << iTetra << " neighbors " << neighbors << ":"
      << "\n " << Tetrahedra[iTetra][0] << ": " << X[Tetrahedra[iTetra][0]]
      << "\n " << Tetrahedra[iTetra][1] << ": " << X[Tetrahedra[iTetra][1]]
      << "\n " << Tetrahedra[iTetra][2] << ": " << X[Tetrahedra[iTetra][2]]
@@ -0,0 +1,179 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// $Id$
+//
+// Analytic stepper for charge carriers in a uniform electric field.
+//
+// 20261016  New class, selected by G4CMPFieldManager for uniform fields
+
+#include "G4CMPUniformFieldStepper.hh"
+#include "G4CMPEqEMField.hh"
+#include "G4LineSection.hh"
+#include "G4PhysicalConstants.hh"
+#include <algorithm>
+#include <math.h>
+
+
+// Four-point Gauss-Legendre abscissas and weights on [-1,1]
+
+namespace {
+  const G4double glNode[4] = { -0.8611363115940526, -0.3399810435848563,
+			        0.3399810435848563,  0.8611363115940526 };
+  const G4double glWeight[4] = { 0.3478548451374538, 0.6521451548625461,
+				 0.6521451548625461, 0.3478548451374538 };
+
+  // Newton steps to find time for h; after a correction below tolerance,
+  // the remaining error in time and position is second order (~1e-12)
+  const G4int maxIterations = 20;
+  const G4double timeTolerance = 1e-6;
+}
+
+
+// Constructor
+
+G4CMPUniformFieldStepper::G4CMPUniformFieldStepper(G4CMPEqEMField* eqMotion,
+						   G4int nvar)
+  : G4MagIntegratorStepper(eqMotion, nvar), theEquation(eqMotion),
+    tstep(0.) {;}
+
+
+// Momentum changes linearly in time, so only step duration must be found
+
+void G4CMPUniformFieldStepper::Stepper(const G4double y[],
+				       const G4double dydx[], G4double h,
+				       G4double yout[], G4double yerr[]) {
+  x0.set(y[0], y[1], y[2]);
+  p0.set(y[3], y[4], y[5]);
+
+  // Input derivatives are per unit length; dt/ds = dydx[7]
+  force.set(dydx[3], dydx[4], dydx[5]);
+  force /= dydx[7];
+
+  // Solve length(t) = h, starting from initial speed
+  G4double t = h*dydx[7];
+  G4ThreeVector dx, vel;
+  G4double length = 0.;
+  for (G4int iter=0; iter<maxIterations; iter++) {
+    Advance(t, dx, length);
+    vel = Velocity(t);
+    if (vel.mag() <= 0.) break;		// Stopped exactly at end of step
+
+    G4double dt = (h-length) / vel.mag();
+    if (t+dt <= 0.) dt = -0.5*t;	// Keep time positive
+
+    t += dt;
+    dx += dt*vel;			// Linear correction to new time
+    if (fabs(dt) <= timeTolerance*t) break;
+  }
+
+  tstep = t;
+  xend = x0 + dx;
+
+  for (G4int i=0; i<GetNumberOfVariables(); i++) {
+    yout[i] = y[i];
+    yerr[i] = 0.;
+  }
+
+  G4ThreeVector pend = p0 + t*force;
+  yout[0] = xend.x();
+  yout[1] = xend.y();
+  yout[2] = xend.z();
+  yout[3] = pend.x();
+  yout[4] = pend.y();
+  yout[5] = pend.z();
+  yout[7] = y[7] + t;		// Lab time of flight
+}
+
+
+// Trajectory is very close to a parabola, farthest from chord at midpoint
+
+G4double G4CMPUniformFieldStepper::DistChord() const {
+  G4ThreeVector dx;
+  G4double length;
+  Advance(0.5*tstep, dx, length);
+
+  G4ThreeVector xmid = x0 + dx;
+  return ( (xend != x0) ? G4LineSection::Distline(xmid, x0, xend)
+	   : (xmid-x0).mag() );
+}
+
+
+// Integrate velocity over [0,t].  Velocity c*p/E is smooth, but speed
+// |p|c/E has a sharp minimum where the charge turns around, at distance
+// delta in time from the closest approach of p to zero.  Each side of that
+// point is split into segments doubling in width, so that |p| is smooth
+// on every segment.
+
+void G4CMPUniformFieldStepper::Advance(G4double t, G4ThreeVector& dx,
+				       G4double& length) const {
+  dx.set(0.,0.,0.);
+  length = 0.;
+
+  G4double f2 = force.mag2();
+  if (f2 <= 0.) {			// No field, constant velocity
+    Integrate(0., t, dx, length);
+    return;
+  }
+
+  G4double tturn = -p0.dot(force)/f2;	// Time of smallest |p|
+  G4double delta = p0.cross(force).mag()/f2;
+
+  if (tturn < t) {			// Part of step after turning point
+    IntegrateGraded(tturn, std::max(0.,-tturn), t-tturn, delta, 1.,
+		    dx, length);
+  }
+
+  if (tturn > 0.) {			// Part of step before turning point
+    IntegrateGraded(tturn, std::max(0.,tturn-t), tturn, delta, -1.,
+		    dx, length);
+  }
+}
+
+// Times tturn + side*x, for x from xlo to xhi
+
+void G4CMPUniformFieldStepper::
+IntegrateGraded(G4double tturn, G4double xlo, G4double xhi, G4double delta,
+		G4double side, G4ThreeVector& dx, G4double& length) const {
+  if (xlo < delta) {			// Near turning point, |p| is smooth
+    G4double x1 = std::min(delta, xhi);
+    Integrate(tturn+side*xlo, tturn+side*x1, dx, length);
+    xlo = x1;
+  }
+
+  if (xlo <= 0.) {			// Passes through zero, |p| is linear
+    Integrate(tturn, tturn+side*xhi, dx, length);
+    return;
+  }
+
+  while (xlo < xhi) {
+    G4double x1 = std::min(2.*xlo, xhi);
+    Integrate(tturn+side*xlo, tturn+side*x1, dx, length);
+    xlo = x1;
+  }
+}
+
+// Four-point Gauss-Legendre integration between times t0 and t1
+
+void G4CMPUniformFieldStepper::Integrate(G4double t0, G4double t1,
+					 G4ThreeVector& dx,
+					 G4double& length) const {
+  G4double mid = 0.5*(t0+t1);
+  G4double half = 0.5*fabs(t1-t0);
+
+  for (G4int i=0; i<4; i++) {
+    G4ThreeVector vel = Velocity(mid + half*glNode[i]);
+    dx += (glWeight[i]*half) * vel;
+    length += glWeight[i]*half * vel.mag();
+  }
+}
+
+
+// Velocity from band structure, v = p*c/E
+
+G4ThreeVector G4CMPUniformFieldStepper::Velocity(G4double t) const {
+  G4ThreeVector p = p0 + t*force;
+  return p * (c_light/theEquation->TotalEnergy(p));
+}
@@ -21,6 +21,8 @@
 // 20250422  G4CMP-468 -- Add displaced point test to PhononVelocityIsInward.
 // 20250423  G4CMP-468 -- Add function to get diffuse reflection vector.
 // 20250510  G4CMP-483 -- Ensure backwards compatibility for vector utilities.
+// 20261016  Direct construction of diffuse reflection vector; move constant
+//		coordinate transforms out of GetLambertianVector() loop.
 
 #include "G4CMPUtils.hh"
 #include "G4CMPConfigManager.hh"
@@ -219,30 +221,60 @@ G4CMP::GetLambertianVector(const G4LatticePhysical* theLattice,
   return GetLambertianVector(theLattice, surfNorm, mode, surfPoint);
 }
 
+// NOTE:  Each trial applies the same test as PhononVelocityIsInward(), but
+//	  the touchable, local surface point and normal are found only once
+
 G4ThreeVector
 G4CMP::GetLambertianVector(const G4LatticePhysical* theLattice,
 			   const G4ThreeVector& surfNorm, G4int mode,
 			   const G4ThreeVector& surfPoint) {
-  G4ThreeVector reflectedKDir;
+  const G4VTouchable* touchable = GetCurrentTouchable();
+
+  if (!touchable) {
+    G4Exception("G4CMP::GetLambertianVector", "G4CMPUtils002",
+		EventMustBeAborted, "Current track does not have valid touchable!");
+    return LambertReflection(surfNorm);
+  }
+
+  const G4ThreeVector localNorm = GetLocalDirection(touchable, surfNorm);
+  const G4ThreeVector localPos = GetLocalPosition(touchable, surfPoint);
+  G4VSolid* solid = touchable->GetSolid();
+
+  G4ThreeVector reflectedKDir, vDir;
   const G4int maxTries = 1000;
   G4int nTries = 0;
   do {
     reflectedKDir = LambertReflection(surfNorm);
+    vDir = theLattice->MapKtoVDir(mode, GetLocalDirection(touchable,
+							  reflectedKDir));
   } while (nTries++ < maxTries &&
-           !PhononVelocityIsInward(theLattice, mode, reflectedKDir, surfNorm,
-                                   surfPoint));
+	   !(vDir.dot(localNorm) < 0.0 &&
+	     solid->Inside(localPos + 1*nm * vDir) == kInside));
 
   return reflectedKDir;
 }
 
 G4ThreeVector G4CMP::LambertReflection(const G4ThreeVector& surfNorm) {
-  G4double phi = 2.0*pi*G4UniformRand();
-  G4double theta = acos(2.0*G4UniformRand() - 1.0) / 2.0;
+  G4double u1 = G4UniformRand();	// phi is drawn first, then theta
+  G4double u2 = G4UniformRand();
+  return LambertReflection(surfNorm, u1, u2);
+}
+
+// Equivalent to rotating -surfNorm by theta = acos(2*u2-1)/2 about
+// surfNorm.orthogonal(), then by phi = 2pi*u1 about surfNorm, so that
+// cos(theta) = sqrt(u2), without inverse trig or general rotations
+
+G4ThreeVector G4CMP::LambertReflection(const G4ThreeVector& surfNorm,
+				       G4double u1, G4double u2) {
+  const G4ThreeVector perp1 = surfNorm.orthogonal().unit();
+  const G4ThreeVector perp2 = surfNorm.cross(perp1);
+
+  G4double cosTheta = std::sqrt(u2);
+  G4double sinTheta = std::sqrt(1.0 - u2);
+  G4double phi = 2.0*pi*u1;
 
-  G4ThreeVector refl = -surfNorm;
-  refl = refl.rotate(surfNorm.orthogonal(), theta);
-  refl = refl.rotate(surfNorm, phi);
-  return refl;
+  return (-cosTheta*surfNorm +
+	  sinTheta*(std::cos(phi)*perp2 - std::sin(phi)*perp1));
 }
 
 
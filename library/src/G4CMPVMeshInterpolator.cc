@@ -14,20 +14,29 @@
 // 20200914  Add function call to precompute potential gradients (field)
 // 20240921  Add new Initialize() function to set tetra index cache
 // 20250223  G4CMP-462: Avoid data race with worker thread Initialize()
+// 20261016  Replace shared value table, rather than overwriting in place.
+// 20261016  Add AddValues() to interleave additional value sets.
+// 20261016  Add Z-order utilities for sorting tetrahedra and batches.
+// 20261016  Add ParallelFor() for multithreaded table construction.
 
 #include "G4CMPVMeshInterpolator.hh"
+#include "G4CMPConfigManager.hh"
+#include <algorithm>
+#include <system_error>
+#include <thread>
 
 
 // Replace values at mesh points without rebuilding tables
 
 void G4CMPVMeshInterpolator::UseValues(const std::vector<G4double>& v) {
-  if (!V.empty() && v.size() != V.size()) {
+  if (V && !V->empty() && v.size() != V->size()) {
     G4cerr << "G4CMPVMeshInterpolator::UseValues ERROR Input vector v does"
 	   << " not match existing mesh V." << G4endl;
     return;
   }
 
-  V = v;
+  // Other clones may be using the existing table; don't overwrite it
+  V = std::make_shared<ValueTable>(v);
   FillGradients();	// Will call subclass implementation
 
 #ifdef G4CMPTLI_DEBUG
@@ -36,6 +45,34 @@ void G4CMPVMeshInterpolator::UseValues(const std::vector<G4double>& v) {
 }
 
 
+// Append new value set to interleaved table of additional values
+
+G4int G4CMPVMeshInterpolator::AddValues(const std::vector<G4double>& v) {
+  if (!V || v.size() != V->size()) {
+    G4cerr << "G4CMPVMeshInterpolator::AddValues ERROR Input vector v does"
+	   << " not match existing mesh V." << G4endl;
+    return -1;
+  }
+
+  // Other clones may be using the existing table; don't overwrite it
+  const size_t npts = v.size();
+  const G4int nsets = NExtra+1;
+  auto extra = std::make_shared<ValueTable>(npts*nsets);
+
+  for (size_t i=0; i<npts; i++) {
+    for (G4int k=0; k<NExtra; k++) {
+      (*extra)[i*nsets+k] = (*VExtra)[i*NExtra+k];
+    }
+    (*extra)[i*nsets+NExtra] = v[i];
+  }
+
+  VExtra = extra;
+  NExtra = nsets;
+
+  return NExtra;			// Index 0 is primary value set
+}
+
+
 // Ensure that cached index is properly set
 
 void G4CMPVMeshInterpolator::Initialize() {
@@ -44,3 +81,144 @@ void G4CMPVMeshInterpolator::Initialize() {
   // FIXME: This may still cause a data race if a shared mesh instance
   //        is not instantiated by the master thread.
 }
+
+
+// Z-order (Morton) curve: interleave bits of integer coordinates, so that
+// points close in space are (mostly) close in sequence
+
+namespace {
+  // Spread lowest 21 bits of value so there are two zero bits between each
+  inline std::uint64_t MortonSpread3(std::uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8)  & 0x100f00f00f00f00fULL;
+    v = (v | v << 4)  & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2)  & 0x1249249249249249ULL;
+    return v;
+  }
+
+  // Spread lowest 32 bits of value so there is a zero bit between each
+  inline std::uint64_t MortonSpread2(std::uint64_t v) {
+    v &= 0xffffffffULL;
+    v = (v | v << 16) & 0x0000ffff0000ffffULL;
+    v = (v | v << 8)  & 0x00ff00ff00ff00ffULL;
+    v = (v | v << 4)  & 0x0f0f0f0f0f0f0f0fULL;
+    v = (v | v << 2)  & 0x3333333333333333ULL;
+    v = (v | v << 1)  & 0x5555555555555555ULL;
+    return v;
+  }
+}
+
+std::uint64_t G4CMPVMeshInterpolator::MortonKey(const G4double u[],
+						G4int ndim) {
+  const G4double nbins = (ndim==3 ? G4double(0x1fffff)	// 21 bits per axis
+			  : G4double(0xffffffffULL));	// 32 bits per axis
+
+  std::uint64_t key = 0;
+  for (G4int dim=0; dim<ndim; dim++) {
+    G4double ui = std::min(std::max(u[dim], 0.), 1.);
+    std::uint64_t bin = std::uint64_t(ui*nbins);
+    key |= (ndim==3 ? MortonSpread3(bin) : MortonSpread2(bin)) << dim;
+  }
+
+  return key;
+}
+
+// Sorting costs about as much as a seeded search, and scatters writes to
+// output arrays.  It only pays off when the batch is large, and touches
+// more of the mesh than will stay in cache (fewer points than elements).
+// Points only need to be grouped by neighborhood, not fully ordered, so
+// use a counting sort on a coarse Z-order cell (about one point per cell)
+
+void G4CMPVMeshInterpolator::SortPoints(size_t npts, const G4double pos[],
+					G4int ndim, const G4double meshMin[],
+					const G4double meshMax[], size_t nelem,
+					std::vector<size_t>& order) {
+  const size_t minSortBatch = 4096;	// Below this, sorting doesn't help
+
+  order.resize(npts);
+  for (size_t i=0; i<npts; i++) order[i] = i;
+  if (npts < minSortBatch) return;
+
+  // Bounding box of batch, and estimated number of mesh elements inside
+  G4double xmin[3], scale[3];
+  G4double nearby = nelem;
+  for (G4int dim=0; dim<ndim; dim++) {
+    G4double xmax = xmin[dim] = pos[dim];
+    for (size_t i=1; i<npts; i++) {
+      xmin[dim] = std::min(xmin[dim], pos[i*ndim+dim]);
+      xmax      = std::max(xmax,      pos[i*ndim+dim]);
+    }
+    scale[dim] = (xmax>xmin[dim] ? 1./(xmax-xmin[dim]) : 0.);
+
+    G4double span = meshMax[dim] - meshMin[dim];
+    if (span > 0.) nearby *= std::min((xmax-xmin[dim])/span, 1.);
+  }
+
+  if (G4double(npts) > nearby) return;	// Dense batch, mesh stays in cache
+
+  // Number of bits per axis for cells; MortonKey() fills 21 (3D) or 32 (2D)
+  const G4int keyBits = (ndim==3 ? 21 : 32);
+  G4int cellBits = 1;
+  while (cellBits < 16/ndim && (size_t(1) << (ndim*(cellBits+1))) <= npts) {
+    cellBits++;
+  }
+
+  const G4int shift = ndim*(keyBits-cellBits);
+  const size_t ncells = size_t(1) << (ndim*cellBits);
+
+  std::vector<std::uint32_t> cell(npts);
+  std::vector<size_t> first(ncells+1, 0);
+  G4double u[3];
+  for (size_t i=0; i<npts; i++) {
+    for (G4int dim=0; dim<ndim; dim++) {
+      u[dim] = (pos[i*ndim+dim] - xmin[dim]) * scale[dim];
+    }
+    cell[i] = std::uint32_t(MortonKey(u, ndim) >> shift);
+    first[cell[i]+1]++;
+  }
+
+  for (size_t c=0; c<ncells; c++) first[c+1] += first[c];
+  for (size_t i=0; i<npts; i++) order[first[cell[i]]++] = i;
+}
+
+
+// Split loop over mesh elements into chunks, one per thread
+
+void G4CMPVMeshInterpolator::
+ParallelFor(size_t n, const std::function<void(size_t,size_t)>& body,
+	    size_t grain) {
+  if (n == 0) return;
+
+  G4int nconfig = G4CMPConfigManager::GetMeshThreads();
+  size_t nthreads = (nconfig > 0 ? size_t(nconfig)
+		     : size_t(std::thread::hardware_concurrency()));
+
+#ifdef G4CMPTLI_DEBUG
+  // Per-element diagnostics would be interleaved between threads
+  if (G4CMPConfigManager::GetVerboseLevel() > 1) nthreads = 1;
+#endif
+
+  nthreads = std::min(nthreads, n/std::max(grain,size_t(1)));
+  if (nthreads <= 1) {			// Not worth starting threads
+    body(0, n);
+    return;
+  }
+
+  const size_t chunk = (n + nthreads-1) / nthreads;
+
+  std::vector<std::thread> workers;
+  workers.reserve(nthreads-1);
+  for (size_t begin=chunk; begin<n; begin+=chunk) {
+    size_t end = std::min(begin+chunk, n);
+    try {
+      workers.emplace_back(body, begin, end);
+    } catch (const std::system_error&) {	// Out of threads, do it here
+      body(begin, end);
+    }
+  }
+
+  body(0, std::min(chunk, n));		// Current thread does first chunk
+  for (auto& t: workers) t.join();
+}
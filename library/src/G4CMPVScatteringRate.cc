@@ -0,0 +1,53 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPVScatteringRate.cc
+/// \brief Implementation of the G4CMPVScatteringRate base class.
+//
+// $Id$
+//
+// 20261016  Add per-lattice rate tables for subclasses to use; key tables
+//		on tolerance as well, and report table at caller's verbosity.
+
+#include "G4CMPVScatteringRate.hh"
+#include "G4CMPConfigManager.hh"
+#include "G4LatticePhysical.hh"
+
+
+// Fill table for current lattice and tolerance on first use
+
+const G4CMPRateTable* G4CMPVScatteringRate::
+TabulateRate(const std::function<G4double(G4double)>& rate, G4double xmax,
+	     const std::vector<G4double>& edges) {
+  G4double tol = G4CMPConfigManager::GetRateTableTolerance();
+  if (!theLattice || tol <= 0.) return nullptr;
+
+  const G4LatticeLogical* lattice = theLattice->GetLattice();
+  const TableKey key(lattice, tol);
+  auto found = rateTables.find(key);
+  if (found == rateTables.end()) {
+    G4CMPRateTable& table = rateTables[key];
+
+    // Suppress per-call printout from rate function while filling
+    G4int vb = verboseLevel;
+    verboseLevel = 0;
+    G4bool filled = table.Fill(rate, xmax, tol, edges);
+    verboseLevel = vb;
+
+    if (!filled) {
+      G4cerr << "G4CMPVScatteringRate::TabulateRate WARNING " << name
+	     << " rate table could not reach tolerance " << tol
+	     << "; rate will be calculated directly." << G4endl;
+    } else if (verboseLevel) {
+      G4cout << name << " rate table for " << lattice->GetName() << ": "
+	     << table.GetNumberOfPoints() << " points, relative error "
+	     << table.GetMaxError() << G4endl;
+    }
+
+    return filled ? &table : nullptr;
+  }
+
+  return found->second.IsFilled() ? &found->second : nullptr;
+}
@@ -58,25 +58,37 @@
 // 20231017  E. Michaud -- Add 'AddValley(const G4ThreeVector&)'
 // 20240426  S. Zatschler -- Add explicit fallthrough statements to switch cases
 // 20240510  E. Michhaud -- Add function to compute L0 from other parameters
+// 20261016  Fill K-Vg lookup table by theta rows on first use, not eagerly
+// 20261016  Use thread-safe kinematics calculation for ComputeKtoVg()
+// 20261016  Restrict K-Vg lookup table to wedge allowed by crystal symmetry
+// 20261016  Add equal-area (Lambert) grid option for K-Vg lookup table
+// 20261016  Add optional charge drift table for fast charge transport
 
 #include "G4LatticeLogical.hh"
 #include "G4CMPPhononKinematics.hh"	// **** THIS BREAKS G4 PORTING ****
 #include "G4CMPPhononKinTable.hh"	// **** THIS BREAKS G4 PORTING ****
 #include "G4CMPConfigManager.hh"	// **** THIS BREAKS G4 PORTING ****
+#include "G4CMPDriftTable.hh"	// **** THIS BREAKS G4 PORTING ****
 #include "G4CMPUnitsTable.hh"		// **** THIS BREAKS G4 PORTING ****
+#include "G4AutoLock.hh"
 #include "G4RotationMatrix.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4PhysicalConstants.hh"
 #include <cmath>
 #include <fstream>
 
+namespace {
+  G4Mutex kvMutex = G4MUTEX_INITIALIZER;	// For thread protection
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
 G4LatticeLogical::G4LatticeLogical(const G4String& name)
   : verboseLevel(0), fName(name), fDensity(0.), fNImpurity(0.),
     fPermittivity(1.), fElasticity{}, fElReduced{}, fHasElasticity(false),
-    fpPhononKin(0), fpPhononTable(0),
+    fpPhononKin(0), fpPhononTable(0), fKVSymmetry(KVInversion),
+    fKVGrid(KVThetaPhi), fKVMin{0.,0.},
+    fKVStep{halfpi/(KVBINS-1), twopi/(KVBINS-1)},
     fA(0), fB(0), fLDOS(0), fSTDOS(0), fFTDOS(0), fTTFrac(0),
     fBeta(0), fGamma(0), fLambda(0), fMu(0),
     fVSound(0.), fVTrans(0.), fL0_e(0.), fL0_h(0.), 
@@ -89,16 +101,11 @@ G4LatticeLogical::G4LatticeLogical(const G4String& name)
     fIVQuadField(0.), fIVQuadRate(0.), fIVQuadExponent(0.),
     fIVLinExponent(0.), fIVLinRate0(0.), fIVLinRate1(0.),
     fIVModel(G4CMPConfigManager::GetIVRateModel()) {
-  for (G4int i=0; i<G4PhononPolarization::NUM_MODES; i++) {
-    for (G4int j=0; j<KVBINS; j++) {
-      for (G4int k=0; k<KVBINS; k++) {
-	fKVMap[i][j][k].set(0.,0.,0.);
-      }
-    }
-  }
+  for (G4int j=0; j<KVBINS; j++) fKVRows[j].store(0);
 }
 
 G4LatticeLogical::~G4LatticeLogical() {
+  ClearMaps();
   delete fpPhononKin; fpPhononKin = 0;
   delete fpPhononTable; fpPhononTable = 0;
 }
@@ -162,19 +169,29 @@ G4LatticeLogical& G4LatticeLogical::operator=(const G4LatticeLogical& rhs) {
   fIVLinRate0 = rhs.fIVLinRate0;
   fIVLinRate1 = rhs.fIVLinRate1;
   fIVModel = rhs.fIVModel;
+  fDriftFile = rhs.fDriftFile;
+  fDriftTable = rhs.fDriftTable;
 
-  if (!rhs.fpPhononKin)   fpPhononKin = new G4CMPPhononKinematics(this);
-  if (!rhs.fpPhononTable) fpPhononTable = new G4CMPPhononKinTable(fpPhononKin);
+  // Copy needs its own calculator to fill lookup table rows not yet filled
+  if (rhs.fpPhononKin && !fpPhononKin)
+    fpPhononKin = new G4CMPPhononKinematics(this);
+  if (rhs.fpPhononTable && !fpPhononTable)
+    fpPhononTable = new G4CMPPhononKinTable(fpPhononKin);
 
   SetElReduced(rhs.fElReduced);
   FillElasticity();
 
-  for (G4int i=0; i<G4PhononPolarization::NUM_MODES; i++) {
-    for (G4int j=0; j<KVBINS; j++) {
-      for (G4int k=0; k<KVBINS; k++) {
-	fKVMap[i][j][k] = rhs.fKVMap[i][j][k];
-      }
-    }
+  fKVSymmetry = rhs.fKVSymmetry;
+  fKVGrid = rhs.fKVGrid;
+  for (G4int i=0; i<2; i++) {
+    fKVMin[i] = rhs.fKVMin[i];
+    fKVStep[i] = rhs.fKVStep[i];
+  }
+
+  ClearMaps();				// Copy only rows already filled
+  for (G4int j=0; j<KVBINS; j++) {
+    const KVRow* row = rhs.fKVRows[j].load(std::memory_order_acquire);
+    if (row) fKVRows[j].store(new KVRow(*row));
   }
 
   return *this;
@@ -243,8 +260,17 @@ void G4LatticeLogical::Initialize(const G4String& newName) {
   if (fpPhononKin) fpPhononTable = new G4CMPPhononKinTable(fpPhononKin);
   *****/
 
-  // Populate phonon lookup tables if not read from files
-  FillMaps();
+  // Phonon lookup tables are populated on first use
+  FillKVSymmetry();
+  ClearMaps();
+
+  if (verboseLevel && fpPhononKin) {
+    static const char* wedge[] = { "hemisphere", "orthorhombic",
+				   "tetragonal", "cubic" };
+    G4cout << "G4LatticeLogical::Initialize " << KVBINS << "x" << KVBINS
+	   << " " << GetKVGrid() << " bins over " << wedge[fKVSymmetry]
+	   << " wedge will be populated on first use." << G4endl;
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -315,34 +341,215 @@ void G4LatticeLogical::FillElasticity() {
       }
     }
   }
+
+  // Kinematics calculator keeps its own copy of tensor, scaled by density
+  if (fpPhononKin) fpPhononKin->updateElasticity();
 }
 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
-// Populate lookup tables using kinematics calculator
-
-void G4LatticeLogical::FillMaps() {
-  if (!fpPhononKin) return;			// Can't fill without solver
+// Discard lookup tables; NOT thread-safe, only for (re)initialization
 
-  G4ThreeVector k;
-  for (G4int itheta = 0; itheta<KVBINS; itheta++) {
-    G4double theta = itheta*pi/(KVBINS-1);	// Last entry is at pi
+void G4LatticeLogical::ClearMaps() {
+  for (G4int j=0; j<KVBINS; j++) delete fKVRows[j].exchange(0);
+}
 
-    for (G4int iphi = 0; iphi<KVBINS; iphi++) {
-      G4double phi = iphi*twopi/(KVBINS-1);	// Last entry is at 2pi
+// Find largest set of symmetry operations (reflections and permutations of
+// axes) which leave elasticity tensor unchanged.  The tensor has already
+// been filled according to the crystal group; testing it directly also
+// guards against a tensor which is not aligned with the lattice axes.
+// Elasticity is always symmetric under inversion (k -> -k).
+
+void G4LatticeLogical::FillKVSymmetry() {
+  G4double cmax = 0.;
+  for (G4int i=0; i<3; i++) {
+    for (G4int j=0; j<3; j++) {
+      for (G4int k=0; k<3; k++) {
+	for (G4int l=0; l<3; l++) {
+	  cmax = std::max(cmax, std::fabs(fElasticity[i][j][k][l]));
+	}
+      }
+    }
+  }
 
-      k.setRThetaPhi(1.,theta,phi);
-      for (G4int mode=0; mode<G4PhononPolarization::NUM_MODES; mode++) {
-	fKVMap[mode][itheta][iphi] = fpPhononKin->getGroupVelocity(mode,k);
+  const G4double tol = 1e-9*cmax;
+  static const G4int swapXY[3] = { 1, 0, 2 };	// x <-> y
+  static const G4int cycle[3]  = { 1, 2, 0 };	// x -> y -> z -> x
+
+  G4bool hasMirrors = true, hasSwapXY = true, hasCycle = true;
+  for (G4int i=0; i<3; i++) {
+    for (G4int j=0; j<3; j++) {
+      for (G4int k=0; k<3; k++) {
+	for (G4int l=0; l<3; l++) {
+	  const G4double cijkl = fElasticity[i][j][k][l];
+
+	  // Reflection of one axis flips sign if index appears an odd number
+	  // of times; invariance requires such elements to vanish
+	  for (G4int axis=0; axis<3; axis++) {
+	    G4int n = (i==axis) + (j==axis) + (k==axis) + (l==axis);
+	    if (n%2 == 1 && std::fabs(cijkl) > tol) hasMirrors = false;
+	  }
+
+	  if (std::fabs(fElasticity[swapXY[i]][swapXY[j]][swapXY[k]][swapXY[l]]
+			- cijkl) > tol) hasSwapXY = false;
+	  if (std::fabs(fElasticity[cycle[i]][cycle[j]][cycle[k]][cycle[l]]
+			- cijkl) > tol) hasCycle = false;
+	}
       }
     }
   }
 
+  // Wedges:  cubic z >= x >= y >= 0; tetragonal x >= y >= 0, z >= 0;
+  //	      orthorhombic x,y,z >= 0; otherwise upper hemisphere z >= 0
+  fKVSymmetry = (!hasMirrors ? KVInversion : !hasSwapXY ? KVOrthorhombic
+		 : !hasCycle ? KVTetragonal : KVCubic);
+
+  // Lambert disk radius is 2*sin(theta/2); cubic wedge has |X|,|Y| within
+  // theta = pi/4 (z = x plane)
+  if (fKVGrid == KVEqualArea) {
+    G4double rmax = (fKVSymmetry == KVCubic) ? 2.*std::sin(pi/8.)
+						   : std::sqrt(2.);
+    fKVMin[0] = fKVMin[1] = (fKVSymmetry == KVInversion) ? -rmax : 0.;
+    fKVStep[0] = fKVStep[1] = (rmax-fKVMin[0])/(KVBINS-1);
+  } else {
+    G4double thetaMax = (fKVSymmetry == KVCubic) ? std::atan(std::sqrt(2.))
+						       : halfpi;
+    G4double phiMax = (fKVSymmetry == KVInversion ? twopi :
+		       fKVSymmetry == KVOrthorhombic ? halfpi : halfpi/2.);
+    fKVMin[0] = fKVMin[1] = 0.;
+    fKVStep[0] = thetaMax/(KVBINS-1);	// Last element is upper edge
+    fKVStep[1] = phiMax/(KVBINS-1);
+  }
+}
+
+// Select coordinates for K-Vg lookup table rows and columns
+
+G4bool G4LatticeLogical::SetKVGrid(const G4String& name) {
+  G4String grid = name;
+  grid.toLower();
+
+  if (grid == "thetaphi") fKVGrid = KVThetaPhi;
+  else if (grid == "equalarea") fKVGrid = KVEqualArea;
+  else {
+    G4cerr << "G4LatticeLogical: Unknown K-Vg lookup grid " << name << G4endl;
+    return false;
+  }
+
+  return true;
+}
+
+G4String G4LatticeLogical::GetKVGrid() const {
+  return (fKVGrid == KVEqualArea ? "equalArea" : "thetaPhi");
+}
+
+// Read drift table for fast charge transport
+
+G4bool G4LatticeLogical::SetDriftTable(const G4String& filename) {
+  auto table = std::make_shared<G4CMPDriftTable>();
+  if (!table->Load(filename)) return false;
+
   if (verboseLevel) {
-    G4cout << "G4LatticeLogical::FillMaps populated " << KVBINS
-	   << " bins in theta and phi for all polarizations." << G4endl;
+    G4cout << "G4LatticeLogical: " << fName << " drift table " << filename
+	   << " with " << table->GetNumberOfPoints() << " points" << G4endl;
   }
+
+  fDriftFile = filename;
+  fDriftTable = table;
+  return true;
+}
+
+// Map direction into lookup table wedge, with operations to map back
+
+G4ThreeVector G4LatticeLogical::MapToKVWedge(const G4ThreeVector& k,
+					     G4int axis[3],
+					     G4double sign[3]) const {
+  G4ThreeVector kw;
+  for (G4int n=0; n<3; n++) axis[n] = n;
+
+  if (fKVSymmetry == KVInversion) {	// Flip to upper hemisphere
+    sign[0] = sign[1] = sign[2] = (k.z() < 0. ? -1. : 1.);
+    return sign[2]*k;
+  }
+
+  for (G4int n=0; n<3; n++) sign[n] = (k[n] < 0. ? -1. : 1.);
+
+  if (fKVSymmetry == KVTetragonal) {	// Sort |kx| >= |ky|
+    if (std::fabs(k.y()) > std::fabs(k.x())) std::swap(axis[0], axis[1]);
+  }
+
+  if (fKVSymmetry == KVCubic) {		// Sort |kz| >= |kx| >= |ky|
+    G4double ka[3] = { std::fabs(k.x()), std::fabs(k.y()), std::fabs(k.z()) };
+    if (ka[axis[0]] > ka[axis[2]]) std::swap(axis[0], axis[2]);
+    if (ka[axis[1]] > ka[axis[2]]) std::swap(axis[1], axis[2]);
+    if (ka[axis[1]] > ka[axis[0]]) std::swap(axis[0], axis[1]);
+  }
+
+  for (G4int n=0; n<3; n++) kw[n] = std::fabs(k[axis[n]]);
+  return kw;
+}
+
+// Get row of lookup table, computing it under lock if not yet filled
+
+const G4LatticeLogical::KVRow& G4LatticeLogical::GetKVRow(G4int iRow) const {
+  const KVRow* row = fKVRows[iRow].load(std::memory_order_acquire);
+  if (row) return *row;
+
+  G4AutoLock kvLock(&kvMutex);		// Kinematics calculator is not MT-safe
+  KVRow* newRow = fKVRows[iRow].load(std::memory_order_acquire);
+  if (!newRow) {
+    newRow = new KVRow;
+    FillKVRow(iRow, *newRow);
+    fKVRows[iRow].store(newRow, std::memory_order_release);
+  }
+
+  return *newRow;
+}
+
+// Populate one row of lookup table using kinematics calculator
+
+void G4LatticeLogical::FillKVRow(G4int iRow, KVRow& row) const {
+  if (!fpPhononKin) return;			// Can't fill without solver
+
+  G4ThreeVector k;
+  for (G4int iCol = 0; iCol<KVBINS; iCol++) {
+    k = KVGridDirection(iRow, iCol);
+    for (G4int mode=0; mode<G4PhononPolarization::NUM_MODES; mode++) {
+      row.vg[mode][iCol] = fpPhononKin->getGroupVelocity(mode,k);
+    }
+  }
+
+#ifdef G4CMP_DEBUG
+  if (verboseLevel>1) {
+    G4cout << "G4LatticeLogical::FillKVRow populated row " << iRow
+	   << " for all polarizations." << G4endl;
+  }
+#endif
+}
+
+// Get unit wavevector at lookup table grid point
+
+G4ThreeVector G4LatticeLogical::KVGridDirection(G4int iRow, G4int iCol) const {
+  G4double u = fKVMin[0] + iRow*fKVStep[0];
+  G4double v = fKVMin[1] + iCol*fKVStep[1];
+
+  G4ThreeVector k;
+  if (fKVGrid == KVEqualArea) {		// Inverse Lambert projection
+    G4double r2 = u*u + v*v;
+    if (r2 > 2.) {			// Corners outside disk copy its rim
+      G4double s = std::sqrt(2./r2);
+      u *= s;
+      v *= s;
+      r2 = 2.;
+    }
+
+    G4double s = std::sqrt(1.-0.25*r2);
+    k.set(u*s, v*s, 1.-0.5*r2);
+  } else {
+    k.setRThetaPhi(1.,u,v);
+  }
+
+  return k;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -364,7 +571,7 @@ G4ThreeVector G4LatticeLogical::ComputeKtoVg(G4int mode,
 		RunMustBeAborted, "Phonon kinematics not available.");
   }
 
-  return fpPhononKin->getGroupVelocity(mode,k);
+  return fpPhononKin->computeGroupVelocity(mode,k);	// Thread-safe version
 }
 
 G4ThreeVector G4LatticeLogical::LookupKtoVg(G4int mode,
@@ -374,30 +581,42 @@ G4ThreeVector G4LatticeLogical::LookupKtoVg(G4int mode,
 	    fpPhononTable->interpGroupVelocity_N(mode, k.unit()).unit()
 	    );
 
-  G4int iTheta, iPhi;		// Bin indices
-  G4double dTheta, dPhi;	// Offsets in bin for interpolation
-  if (!FindLookupBins(k, iTheta, iPhi, dTheta, dPhi)) {
+  // Table covers only directions not related by crystal symmetry
+  G4int axis[3];
+  G4double sign[3];
+  const G4ThreeVector kw = MapToKVWedge(k, axis, sign);
+
+  G4int iRow, iCol;		// Bin indices
+  G4double dRow, dCol;		// Offsets in bin for interpolation
+  if (!FindLookupBins(kw, iRow, iCol, dRow, dCol)) {
     G4Exception("G4LatticeLogical::LookupKtoVDir", "Lattice006",
 		EventMustBeAborted, "Interpolation failed.");
     return G4ThreeVector();
   }
 
+  const G4ThreeVector* vg0 = GetKVRow(iRow).vg[mode];
+  const G4ThreeVector* vg1 = GetKVRow(iRow+1).vg[mode];
+
   /**** Returns direct bin value
-  const G4ThreeVector& vdir = fKVMap[mode][iTheta][iPhi];
+  const G4ThreeVector& vdir = vg0[iCol];
   ****/
 
   // Bilinear interpolation using the four corner bins (i,j) to (i+1,j+1)
-  G4ThreeVector vdir =
-    ( (1.-dTheta)*(1.-dPhi)*fKVMap[mode][iTheta][iPhi] +
-      dTheta*(1.-dPhi)*fKVMap[mode][iTheta+1][iPhi] +
-      (1.-dTheta)*dPhi*fKVMap[mode][iTheta][iPhi+1] +
-      dTheta*dPhi*fKVMap[mode][iTheta+1][iPhi+1] );
+  G4ThreeVector vwedge =
+    ( (1.-dRow)*(1.-dCol)*vg0[iCol] +
+      dRow*(1.-dCol)*vg1[iCol] +
+      (1.-dRow)*dCol*vg0[iCol+1] +
+      dRow*dCol*vg1[iCol+1] );
+
+  // Group velocity transforms like wavevector; undo symmetry operations
+  G4ThreeVector vdir;
+  for (G4int n=0; n<3; n++) vdir[axis[n]] = sign[axis[n]]*vwedge[n];
 
 #ifdef G4CMP_DEBUG
   if (verboseLevel>1) {
     G4cout << "G4LatticeLogical::MapKtoVDir theta,phi="
 	   << k.theta() << " " << k.phi()
-	   << " : ith,iph " << iTheta << " " << iPhi
+	   << " : irow,icol " << iRow << " " << iCol
 	   << " : dir " << vdir << G4endl;
   }
 #endif
@@ -407,30 +626,42 @@ G4ThreeVector G4LatticeLogical::LookupKtoVg(G4int mode,
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
-// Get theta, phi bins and offsets for interpolation
+// Get row (theta or X), column (phi or Y) bins and offsets for interpolation
+// NOTE:  Input vector must be in wedge, with z >= 0
 
 G4bool 
 G4LatticeLogical::FindLookupBins(const G4ThreeVector& k,
-				 G4int& iTheta, G4int& iPhi,
-				 G4double& dTheta, G4double& dPhi) const {
-  G4double tStep = pi/(KVBINS-1);	// Last element is upper edge
-  G4double pStep = twopi/(KVBINS-1);
-
-  G4double theta = k.getTheta();	// Normalize theta to [0,pi)
-  if (theta<0) theta+=pi;
+				 G4int& iRow, G4int& iCol,
+				 G4double& dRow, G4double& dCol) const {
+  G4double u, v;
+  if (fKVGrid == KVEqualArea) {		// Lambert projection, no trig calls
+    G4double kmag = k.mag();
+    G4double scale = std::sqrt(2./(kmag*(kmag+k.z())));
+    u = k.x()*scale;
+    v = k.y()*scale;
+  } else {
+    u = k.getTheta();			// Normalize theta to [0,pi)
+    if (u<0) u+=pi;
+
+    v = k.getPhi();			// Normalize phi to [0,twopi)
+    if (v<0) v += twopi;
+  }
 
-  G4double phi = k.getPhi();		// Normalize phi to [0,twopi)
-  if (phi<0) phi += twopi;
+  dRow = (u-fKVMin[0])/fKVStep[0];
+  iRow = int(dRow);
+  dRow -= iRow;				// Fraction of bin width
 
-  dTheta = theta/tStep;
-  iTheta = int(dTheta);
-  dTheta -= iTheta;			// Fraction of bin width
+  dCol = (v-fKVMin[1])/fKVStep[1];
+  iCol = int(dCol);
+  dCol -= iCol;				// Fraction of bin width
 
-  dPhi = phi/pStep;
-  iPhi = int(dPhi);
-  dPhi -= iPhi;				// Fraction of bin width
+  // Edges of wedge (or roundoff past them) use the first or last bin
+  if (iRow < 0) { iRow = 0; dRow = 0.; }
+  if (iCol < 0) { iCol = 0; dCol = 0.; }
+  if (iRow >= KVBINS-1) { iRow = KVBINS-2; dRow = 1.; }
+  if (iCol >= KVBINS-1) { iCol = KVBINS-2; dCol = 1.; }
 
-  return (iTheta<KVBINS && iPhi<KVBINS);	// Sanity check on bin indexing
+  return (iRow<KVBINS-1 && iCol<KVBINS-1);	// Sanity check on bin indexing
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -954,6 +1185,8 @@ void G4LatticeLogical::Dump(std::ostream& os) const {
      << "\nDebye " << fDebye/eV << " eV"
      << std::endl;
 
+  if (fKVGrid != KVThetaPhi) os << "kvGrid " << GetKVGrid() << std::endl;
+
   os << "# Charge carrier propagation parameters"
      << "\nbandgap " << fBandGap/eV << " eV"
      << "\npairEnergy " << fPairEnergy/eV << " eV"
@@ -1007,6 +1240,7 @@ void G4LatticeLogical::Dump(std::ostream& os) const {
      << "\nivLinPower " << fIVLinExponent << std::endl;
 
   if (!fIVModel.empty()) os << "ivModel " << fIVModel << std::endl;
+  if (!fDriftFile.empty()) os << "driftTable " << fDriftFile << std::endl;
 }
 
 // Print out Euler angles of requested valley
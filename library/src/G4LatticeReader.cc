@@ -35,6 +35,8 @@
 // 20231017  E. Michaud -- Add 'valleyDir' to set rotation matrix with valley's
 //		 direction instead of euler angles
 // 20240131  J. Inman -- Multiple path selection on G4LATTICEDATA variable
+// 20261016  Add 'kvGrid' to select K-Vg lookup table grid by material
+// 20261016  Add 'driftTable' to load drift speeds for fast charge transport
 
 #include "G4LatticeReader.hh"
 #include "G4CMPConfigManager.hh"
@@ -111,6 +113,7 @@ G4bool G4LatticeReader::OpenFile(const G4String& filename) {
     G4cout << "G4LatticeReader::OpenFile " << filename << G4endl;
 
   G4String filepath = filename;
+  fFilePath = filepath;
   psLatfile = new std::ifstream(filepath);
   if (!psLatfile->good()) { 		// Local file not found
     G4Tokenizer nextpath(fDataDir);
@@ -120,6 +123,7 @@ G4bool G4LatticeReader::OpenFile(const G4String& filename) {
       psLatfile->open(filepath);      // Try data directory
       if (psLatfile->good()) {
         if (verboseLevel>1) G4cout << " Found file " << filepath << G4endl;
+        fFilePath = filepath;
         return true;
       }
       psLatfile->close();
@@ -161,6 +165,8 @@ G4bool G4LatticeReader::ProcessToken() {
   if (fToken == "ivdeform") return ProcessDeformation(); // D0, D1 potentials
   if (fToken == "ivenergy") return ProcessThresholds();  // D0, D1 Emin
   if (fToken == "ivmodel")  return ProcessString(fToken);  // IV rate function
+  if (fToken == "kvgrid")   return ProcessString(fToken);  // K-Vg table grid
+  if (fToken == "drifttable") return ProcessString(fToken); // Fast charges
 
   if (G4CMPCrystalGroup::Group(fToken) >= 0)		// Crystal dimensions
                             return ProcessCrystalGroup(fToken);
@@ -168,6 +174,17 @@ G4bool G4LatticeReader::ProcessToken() {
   return ProcessValue(fToken);				// Single numeric value
 }
 
+// Relative paths are taken from directory of configuration file
+
+G4String G4LatticeReader::DataFilePath(const G4String& filename) const {
+  if (filename.empty() || filename[0] == '/') return filename;
+
+  size_t slash = fFilePath.rfind('/');
+  if (slash == std::string::npos) return filename;
+
+  return fFilePath.substr(0, slash+1) + filename;
+}
+
 // Eat remainder of line, assuming a '#' token was found
 
 G4bool G4LatticeReader::SkipComments() {
@@ -237,6 +254,8 @@ G4bool G4LatticeReader::ProcessString(const G4String& name) {
 
   G4bool good = true;
   if (name == "ivmodel") pLattice->SetIVModel(arg);
+  else if (name == "kvgrid") good = pLattice->SetKVGrid(arg);
+  else if (name == "drifttable") good = pLattice->SetDriftTable(DataFilePath(arg));
   else {
     G4cerr << "G4LatticeReader: Unrecognized token " << name << G4endl;
     good = false;
@@ -0,0 +1,161 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// testFastCharge.cc	Check Shockley-Ramo induced charge from fast charge
+//			transport, in a germanium box with uniform field and
+//			one weighting potential for each face along the field.
+//
+// Usage: testFastCharge [nPairs] [verboseLevel]
+//
+// Electron-hole pairs are started at random points and drifted with
+// G4CMPFastChargeTransport.  A pair collected on opposite faces induces
+// exactly +1 and -1 on the two channels, independent of starting point,
+// and the sum over channels is zero because the weighting potentials add
+// to one everywhere.  A carrier stopped by the step limit must be left
+// uncollected, with its partial induced charge still summing to zero.
+// Returns non-zero if any check fails.
+//
+// 20261016  Create test for fast charge transport and Ramo signals.
+
+#include "G4CMPConfigManager.hh"
+#include "G4CMPDriftTable.hh"
+#include "G4CMPFastChargeTransport.hh"
+#include "G4CMPMeshElectricField.hh"
+#include "G4Box.hh"
+#include "G4FieldManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "Randomize.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+
+// Grid coordinate along one axis; interior nodes are shifted by a fixed
+// pattern, since Qhull makes degenerate tetrahedra from a regular grid
+
+G4double GridPoint(G4int i, G4int n, G4int shift, G4double h) {
+  G4double u = 2.*i/(n-1) - 1.;
+  if (i > 0 && i < n-1) u += 0.1*((shift%5)-2)/(n-1);
+  return h*u;
+}
+
+// Write potential on grid over box of half-length h, in the EPot file
+// format (x, y, z in m, V in volts) with V = a + b*z/h
+
+void WritePotential(const G4String& name, G4double h, G4double a,
+		    G4double b) {
+  const G4int nGrid = 7;
+  std::ofstream epot(name);
+  for (G4int i=0; i<nGrid; i++) {
+    for (G4int j=0; j<nGrid; j++) {
+      for (G4int k=0; k<nGrid; k++) {
+	G4double x = GridPoint(i, nGrid, 3*j+k, h);
+	G4double y = GridPoint(j, nGrid, i+2*k+1, h);
+	G4double z = GridPoint(k, nGrid, 2*i+j+2, h);
+	if (i+j+k > 0) epot << "\n";
+	epot << x/m << " " << y/m << " " << z/m << " " << a+b*z/h;
+      }
+    }
+  }
+}
+
+
+int main(int argc, char* argv[]) {
+  G4int nPairs  = (argc > 1) ? atoi(argv[1]) : 100;
+  G4int verbose = (argc > 2) ? atoi(argv[2]) : 0;
+
+  const G4double h = 1.*cm;
+  const G4double tolerance = 1e-6;
+
+  // Bias of 1 V across crystal, channels on top (+z) and bottom (-z)
+  WritePotential("testFastCharge_bias.txt", h, 0., 0.5);
+  WritePotential("testFastCharge_top.txt", h, 0.5, 0.5);
+  WritePotential("testFastCharge_bottom.txt", h, 0.5, -0.5);
+
+  G4CMPMeshElectricField* field =
+    new G4CMPMeshElectricField("testFastCharge_bias.txt");
+  G4int iTop = field->AddPotential("testFastCharge_top.txt");
+  G4int iBottom = field->AddPotential("testFastCharge_bottom.txt");
+  if (iTop != 1 || iBottom != 2) {
+    G4cerr << "Weighting potentials not added to mesh field" << G4endl;
+    return 1;
+  }
+
+  G4Material* ge = new G4Material("Ge", 32., 72.630*g/mole, 5.323*g/cm3,
+				  kStateSolid);
+  G4Box* box = new G4Box("Crystal", h, h, h);
+  G4LogicalVolume* lv = new G4LogicalVolume(box, ge, "Crystal");
+  lv->SetFieldManager(new G4FieldManager(field), true);
+
+  // Constant speed and no diffusion, so carriers follow field lines
+  G4CMPDriftTable table;
+  table.AddPoint(0.1*volt/cm, 10.*km/s, 0., 10.*km/s, 0.);
+  table.AddPoint(10.*volt/cm, 10.*km/s, 0., 10.*km/s, 0.);
+
+  G4CMPFastChargeTransport fast(verbose);
+
+  // Channel charges for pair collected at opposite faces
+  G4int nFail = 0;
+  G4double maxDev = 0.;
+  for (G4int i=0; i<nPairs; i++) {
+    G4ThreeVector start(0.9*h*(2.*G4UniformRand()-1.),
+			0.9*h*(2.*G4UniformRand()-1.),
+			0.9*h*(2.*G4UniformRand()-1.));
+
+    fast.ClearSignals();
+
+    G4ThreeVector posH = start, posE = start;
+    G4double timeH = 0., timeE = 0.;
+    G4bool okH = fast.Drift(lv, &table, +eplus, posH, timeH);
+    G4bool collH = fast.WasCollected();
+    G4bool okE = fast.Drift(lv, &table, -eplus, posE, timeE);
+    G4bool collE = fast.WasCollected();
+
+    G4double qTop = fast.GetInducedCharge(iTop-1);
+    G4double qBottom = fast.GetInducedCharge(iBottom-1);
+    G4double dev = std::max({ std::fabs(qTop+1.), std::fabs(qBottom-1.),
+			      std::fabs(qTop+qBottom) });
+    maxDev = std::max(maxDev, dev);
+
+    // Holes follow field to bottom, electrons go to top
+    if (!okH || !okE || !collH || !collE || dev > tolerance ||
+	std::fabs(posH.z()+h) > tolerance*h ||
+	std::fabs(posE.z()-h) > tolerance*h) {
+      G4cerr << "Pair " << i << " from " << start/mm << " mm: hole at "
+	     << posH/mm << " electron at " << posE/mm << " mm, Q(top) "
+	     << qTop << " Q(bottom) " << qBottom << G4endl;
+      nFail++;
+    }
+  }
+
+  G4cout << nPairs << " e/h pairs, " << nFail << " failed; largest deviation"
+	 << " of channel charge from +-1 or of sum from 0: " << maxDev
+	 << G4endl;
+
+  // Carrier stopped by step limit is not collected, and sum is still zero
+  G4CMPConfigManager::SetMaxChargeSteps(10);
+  fast.ClearSignals();
+
+  G4ThreeVector pos(0., 0., 0.);
+  G4double time = 0.;
+  G4bool ok = fast.Drift(lv, &table, +eplus, pos, time);
+  G4double qTop = fast.GetInducedCharge(iTop-1);
+  G4double qSum = qTop + fast.GetInducedCharge(iBottom-1);
+  G4bool stopOK = (ok && !fast.WasCollected() && fast.GetNumberOfSteps() == 10
+		   && std::fabs(pos.z()) < h && std::fabs(qSum) < tolerance);
+
+  G4cout << "Hole stopped after " << fast.GetNumberOfSteps() << " steps at "
+	 << pos/mm << " mm, " << (fast.WasCollected() ? "" : "not ")
+	 << "collected, Q(top) " << qTop << " sum " << qSum << G4endl;
+
+  if (!stopOK) nFail++;
+
+  return (nFail > 0) ? 1 : 0;
+}
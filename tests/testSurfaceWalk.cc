@@ -0,0 +1,211 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// testSurfaceWalk.cc	Compare analytic and step-by-step phonon surface
+//			displacement walks in G4CMPSolidUtils, on the faces
+//			of a germanium box and the side of a cylinder.
+//
+// Usage: testSurfaceWalk [nTrials] [stepLimit] [verboseLevel]
+//
+// For each face type, random surface points and phonon wavevectors are
+// generated, keeping only those where specular reflection doesn't give an
+// inward group velocity.  Both walks are run from the same start; success
+// rates, agreement of final wavevectors, and time per walk are reported.
+// Cylinder end caps are skipped, since AnalyticSurfaceWalk leaves them to
+// the stepwise walk.  Starts which AnalyticSurfaceWalk doesn't handle are
+// counted separately, and are not included in the comparison.
+//
+// 20261016  Create benchmark for analytic surface walk.
+// 20261016  Skip G4Tubs end caps; don't count unhandled starts as walks.
+
+#include "G4CMPSolidUtils.hh"
+#include "G4Box.hh"
+#include "G4LatticeManager.hh"
+#include "G4LatticePhysical.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4PVPlacement.hh"
+#include "G4PhononPolarization.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4RandomDirection.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "G4Tubs.hh"
+#include "G4VSolid.hh"
+#include "Randomize.hh"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+
+// Random point and normal on top (face=0) or side (face=1) of solid
+
+void SurfacePoint(const G4VSolid* solid, G4int face,
+		  G4ThreeVector& pos, G4ThreeVector& norm) {
+  if (solid->GetEntityType() == "G4Box") {
+    const G4Box* box = static_cast<const G4Box*>(solid);
+    G4double dx = box->GetXHalfLength();
+    G4double dy = box->GetYHalfLength();
+    G4double dz = box->GetZHalfLength();
+    if (face == 0) {
+      pos.set(dx*(2.*G4UniformRand()-1.), dy*(2.*G4UniformRand()-1.), dz);
+      norm.set(0., 0., 1.);
+    } else {
+      pos.set(dx, dy*(2.*G4UniformRand()-1.), dz*(2.*G4UniformRand()-1.));
+      norm.set(1., 0., 0.);
+    }
+  } else {
+    const G4Tubs* tubs = static_cast<const G4Tubs*>(solid);
+    G4double rmax = tubs->GetOuterRadius();
+    G4double dz = tubs->GetZHalfLength();
+    G4double phi = twopi*G4UniformRand();
+    if (face == 0) {
+      pos.setRhoPhiZ(rmax*std::sqrt(G4UniformRand()), phi, dz);
+      norm.set(0., 0., 1.);
+    } else {
+      pos.setRhoPhiZ(rmax, phi, dz*(2.*G4UniformRand()-1.));
+      norm.setRhoPhiZ(1., phi, 0.);
+    }
+  }
+}
+
+
+// Run both walks from nTrials starting points on each face of solid
+
+void CompareWalks(const G4VSolid* solid, const G4LatticePhysical* lat,
+		  G4int nTrials, G4int stepLimit, G4int verbose) {
+  G4CMPSolidUtils solidUtils(solid, verbose, "testSurfaceWalk");
+
+  G4ThreeVector pmin, pmax;
+  solid->BoundingLimits(pmin, pmax);
+  G4double stepSize = (pmax - pmin).mag() / 1000;	// Same as process
+
+  G4int mode = 0;
+  auto velocityIsInward = [&mode, lat, solid](const G4ThreeVector& k,
+					       const G4ThreeVector& norm,
+					       const G4ThreeVector& pos) {
+    G4ThreeVector vDir = lat->MapKtoVDir(mode, k);
+    return (vDir.dot(norm) < 0.0 &&
+	    solid->Inside(pos + 1*nm*vDir) == kInside);
+  };
+
+  // G4Tubs end caps (face 0) only have the stepwise walk
+  G4int firstFace = (solid->GetEntityType() == "G4Tubs") ? 1 : 0;
+
+  for (G4int face=firstFace; face<2; face++) {
+    G4int nWalks=0, nUnhandled=0, okFast=0, okSlow=0, okBoth=0, sameK=0;
+    G4int stepsFast=0, stepsSlow=0;
+    G4double timeFast=0., timeSlow=0., maxDist=0.;
+
+    G4ThreeVector pos, norm;
+    for (G4int itry=0; nWalks<nTrials && itry<100*nTrials; itry++) {
+      SurfacePoint(solid, face, pos, norm);
+      mode = G4PhononPolarization::Long + itry%3;
+
+      // Specular reflection of outgoing wavevector
+      G4ThreeVector k = G4RandomDirection();
+      if (k.dot(norm) < 0.) k = -k;
+      k -= 2.*k.dot(norm)*norm;
+
+      if (velocityIsInward(k, norm, pos)) continue;	// No walk needed
+
+      G4ThreeVector posFast=pos, normFast=norm, kFast=k;
+      G4ThreeVector posSlow=pos, normSlow=norm, kSlow=k;
+      G4int nFast = 0;
+
+      auto t0 = std::chrono::steady_clock::now();
+      if (!solidUtils.AnalyticSurfaceWalk(posFast, normFast, kFast, stepSize,
+					  stepLimit, velocityIsInward, nFast)) {
+	if (verbose) {
+	  G4cerr << solid->GetName() << " face " << face << " at " << pos
+		 << " not handled by AnalyticSurfaceWalk" << G4endl;
+	}
+	nUnhandled++;
+	continue;
+      }
+      auto t1 = std::chrono::steady_clock::now();
+      nWalks++;
+      G4int nSlow = solidUtils.SurfaceWalk(posSlow, normSlow, kSlow, stepSize,
+					   stepLimit, velocityIsInward);
+      auto t2 = std::chrono::steady_clock::now();
+
+      timeFast += std::chrono::duration<G4double, std::micro>(t1-t0).count();
+      timeSlow += std::chrono::duration<G4double, std::micro>(t2-t1).count();
+      stepsFast += nFast;
+      stepsSlow += nSlow;
+
+      G4bool passFast = velocityIsInward(kFast, normFast, posFast);
+      G4bool passSlow = velocityIsInward(kSlow, normSlow, posSlow);
+      if (passFast) okFast++;
+      if (passSlow) okSlow++;
+      if (passFast && passSlow) {
+	okBoth++;
+	if ((kFast-kSlow).mag() < 0.02) sameK++;
+	maxDist = std::max(maxDist, (posFast-posSlow).mag());
+      }
+    }
+
+    if (nWalks == 0) {
+      if (nUnhandled > 0) {
+	G4cout << solid->GetName() << (face==0 ? " top " : " side")
+	       << " : " << nUnhandled << " starts, none handled by analytic walk"
+	       << G4endl;
+      }
+      continue;
+    }
+
+    G4cout << solid->GetName() << (face==0 ? " top " : " side")
+	   << " : " << nWalks << " walks, step " << stepSize/um << " um"
+	   << "\n  analytic: " << okFast << " inward, "
+	   << G4double(stepsFast)/nWalks << " steps, "
+	   << timeFast/nWalks << " us/walk"
+	   << "\n  stepwise: " << okSlow << " inward, "
+	   << G4double(stepsSlow)/nWalks << " steps, "
+	   << timeSlow/nWalks << " us/walk"
+	   << "\n  both inward: " << okBoth << ", same k: " << sameK
+	   << ", max position difference " << maxDist/mm << " mm";
+    if (nUnhandled > 0) {
+      G4cout << "\n  not handled by analytic walk: " << nUnhandled;
+    }
+    G4cout << G4endl;
+  }
+}
+
+
+int main(int argc, char* argv[]) {
+  G4int nTrials   = (argc > 1) ? std::atoi(argv[1]) : 1000;
+  G4int stepLimit = (argc > 2) ? std::atoi(argv[2]) : 1000;
+  G4int verbose   = (argc > 3) ? std::atoi(argv[3]) : 0;
+
+  // Need physical volumes in order to make physical lattice
+  G4Material* ge = new G4Material("Ge", 32., 72.630*g/mole, 5.323*g/cm3,
+                                  kStateSolid);
+  G4Material* vac = new G4Material("Vacuum",1.,1*g/mole,1e-20*g/cm3,kStateGas);
+  G4VSolid* worldS = new G4Box("World", 10*cm, 10*cm, 10*cm);
+  G4LogicalVolume* world = new G4LogicalVolume(worldS, vac, "World");
+
+  // Small rectangular chip, and 3" x 1" cylinder
+  G4VSolid* boxS = new G4Box("GeBox", 1*cm, 1*cm, 2*mm);
+  G4VSolid* tubsS = new G4Tubs("GeTubs", 0., 38.1*mm, 12.7*mm, 0., 360*deg);
+
+  G4LogicalVolume* boxLV = new G4LogicalVolume(boxS, ge, "GeBox");
+  G4LogicalVolume* tubsLV = new G4LogicalVolume(tubsS, ge, "GeTubs");
+
+  G4VPhysicalVolume* boxPV =
+    new G4PVPlacement(0, G4ThreeVector(-5*cm,0.,0.), boxLV,
+		      boxLV->GetName(), world, 0, 0, false);
+  G4VPhysicalVolume* tubsPV =
+    new G4PVPlacement(0, G4ThreeVector(5*cm,0.,0.), tubsLV,
+		      tubsLV->GetName(), world, 0, 0, false);
+
+  G4LatticeManager* latMgr = G4LatticeManager::GetLatticeManager();
+  G4LatticePhysical* boxLat = latMgr->LoadLattice(boxPV, "Ge");
+  G4LatticePhysical* tubsLat = latMgr->LoadLattice(tubsPV, "Ge");
+
+  CompareWalks(boxS, boxLat, nTrials, stepLimit, verbose);
+  CompareWalks(tubsS, tubsLat, nTrials, stepLimit, verbose);
+
+  return 0;
+}